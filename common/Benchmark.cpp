@@ -0,0 +1,393 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Benchmark.h"
+#include "FidtrackFinder.h"
+#include "BlobObject.h"
+#include "CameraTool.h"
+#include "SceneCamera.h"
+#include "TuioServer.h"
+#include "UdpSender.h"
+#include "treeidmap.h"
+#include "pixelwarp.h"
+#include "tiled_bernsen_threshold.h"
+#include <algorithm>
+#include <string.h>
+
+// the colour conversions of the camera engine are only accessible to the camera drivers
+class ConversionCamera: public SceneCamera
+{
+public:
+	ConversionCamera(CameraConfig *cam_cfg): SceneCamera(cam_cfg) {};
+
+	using CameraEngine::rgb2gray;
+	using CameraEngine::uyvy2gray;
+	using CameraEngine::yuyv2gray;
+	using CameraEngine::gray2rgb;
+	using CameraEngine::uyvy2rgb;
+	using CameraEngine::yuyv2rgb;
+};
+
+// discards the TUIO packets, so that only their serialization is measured
+class DiscardSender: public TUIO::OscSender
+{
+public:
+	DiscardSender() {
+		local = true;
+		buffer_size = MAX_UDP_SIZE;
+	};
+
+	bool sendOscData(const char* /*data*/, unsigned int /*size*/) { return true; };
+	bool isConnected() { return true; };
+	const char* tuio_type() { return "TUIO/NONE"; };
+};
+
+static void analyseBlobs(Segmenter *segmenter, PixelWarp *pixelwarp, std::vector<BlobObject*> &blobList) {
+
+	TUIO::TuioTime frameTime = TUIO::TuioTime::getSessionTime();
+	for (int i=0;i<segmenter->region_count;i++) {
+		Region *r = (Region*)(segmenter->regions + (segmenter->sizeof_region * i));
+		r->width = r->right-r->left+1;
+		r->height = r->bottom-r->top+1;
+		r->size = (r->width>r->height) ? r->width : r->height;
+		if ((r->size<8) || (r->size>BENCHMARK_CELL/2)) continue;
+
+		try { blobList.push_back(new BlobObject(frameTime,r,pixelwarp,true)); }
+		catch (std::exception e) {}
+	}
+}
+
+static void clearBlobs(std::vector<BlobObject*> &blobList) {
+	for (unsigned int i=0;i<blobList.size();i++) delete blobList[i];
+	blobList.clear();
+}
+
+Benchmark::Benchmark() {
+	width = height = 0;
+	total_time = 0.0;
+	result = stdout;
+}
+
+Benchmark::~Benchmark() {
+	for (unsigned int i=0;i<frameList.size();i++) delete[] frameList[i];
+}
+
+bool Benchmark::run(const char *result_file) {
+
+#ifndef NDEBUG
+	// the blob analysis draws into the user interface of debug builds, which are not worth measuring anyway
+	std::cout << "the benchmark requires a release build" << std::endl;
+	return false;
+#endif
+
+	if (result_file!=NULL) {
+		result = fopen(result_file,"w");
+		if (result==NULL) {
+			printf("could not open benchmark result file %s\n",result_file);
+			return false;
+		}
+	}
+
+	static const int resolutions[3][2] = { {640,480}, {1280,720}, {1920,1080} };
+	static const float densities[3] = { 0.25f, 0.5f, 1.0f };
+
+	fprintf(result,"# kernel\twidth\theight\titems\truns\tmedian_us\tmin_us\n");
+	if (result!=stdout) printf("# kernel\twidth\theight\titems\truns\tmedian_us\tmin_us\n");
+
+	runTreeIdMap();
+
+	bool success = true;
+	for (int r=0;r<3;r++) {
+
+		// the default scene places each item within its own cell of twice the fiducial size
+		int cells = (resolutions[r][0]/BENCHMARK_CELL)*(resolutions[r][1]/BENCHMARK_CELL);
+
+		for (int d=0;d<3;d++) {
+			int items = (int)(cells*densities[d]);
+			if (!renderScene(resolutions[r][0],resolutions[r][1],items)) {
+				success = false;
+				break;
+			}
+
+			// the colour conversions do not depend on the frame content
+			if (d==0) runConversions();
+			runSegmentation(items);
+			runTuioServer(items);
+		}
+	}
+
+	if (result!=stdout) fclose(result);
+	result = stdout;
+	return success;
+}
+
+bool Benchmark::renderScene(int w, int h, int items) {
+
+	for (unsigned int i=0;i<frameList.size();i++) delete[] frameList[i];
+	frameList.clear();
+
+	CameraConfig cfg;
+	CameraTool::initCameraConfig(&cfg);
+	cfg.driver = DRIVER_SCENE;
+	cfg.cam_width = w;
+	cfg.cam_height = h;
+	cfg.cam_fps = 60;
+
+	// half of the items are fiducials, the others are fingers and blobs
+	SceneCamera camera(&cfg);
+	camera.setItemCount(items/2,items/4,items-items/2-items/4);
+	if (!camera.initCamera() || !camera.startCamera()) {
+		printf("could not render the benchmark scene\n");
+		return false;
+	}
+
+	width = cfg.frame_width;
+	height = cfg.frame_height;
+	for (int i=0;i<BENCHMARK_FRAMES;i++) {
+		unsigned char *frame = new unsigned char[width*height];
+		memcpy(frame,camera.getFrame(),width*height);
+		frameList.push_back(frame);
+	}
+
+	camera.stopCamera();
+	camera.closeCamera();
+	return true;
+}
+
+void Benchmark::runConversions() {
+
+	CameraConfig cfg;
+	CameraTool::initCameraConfig(&cfg);
+	ConversionCamera camera(&cfg);
+
+	int size = width*height;
+	unsigned char *gray = new unsigned char[size];
+	unsigned char *rgb = new unsigned char[size*3];
+	unsigned char *yuv = new unsigned char[size*2];
+
+	// the packed yuv frame carries the luma of the scene frame with neutral chroma
+	for (int i=0;i<size/2;i++) {
+		yuv[i*4] = 128;
+		yuv[i*4+1] = frameList[0][i*2];
+		yuv[i*4+2] = 128;
+		yuv[i*4+3] = frameList[0][i*2+1];
+	}
+	camera.gray2rgb(width,height,frameList[0],rgb);
+
+	while (!timerDone()) {
+		startTimer();
+		camera.rgb2gray(width,height,rgb,gray);
+		stopTimer();
+	}
+	writeResult("rgb2gray",0);
+
+	while (!timerDone()) {
+		startTimer();
+		camera.uyvy2gray(width,height,yuv,gray);
+		stopTimer();
+	}
+	writeResult("uyvy2gray",0);
+
+	while (!timerDone()) {
+		startTimer();
+		camera.yuyv2gray(width,height,yuv,gray);
+		stopTimer();
+	}
+	writeResult("yuyv2gray",0);
+
+	for (int i=0;!timerDone();i++) {
+		startTimer();
+		camera.gray2rgb(width,height,frameList[i%BENCHMARK_FRAMES],rgb);
+		stopTimer();
+	}
+	writeResult("gray2rgb",0);
+
+	while (!timerDone()) {
+		startTimer();
+		camera.uyvy2rgb(width,height,yuv,rgb);
+		stopTimer();
+	}
+	writeResult("uyvy2rgb",0);
+
+	while (!timerDone()) {
+		startTimer();
+		camera.yuyv2rgb(width,height,yuv,rgb);
+		stopTimer();
+	}
+	writeResult("yuyv2rgb",0);
+
+	delete[] gray;
+	delete[] rgb;
+	delete[] yuv;
+}
+
+void Benchmark::runTreeIdMap() {
+
+	TreeIdMap treeidmap;
+	initialize_treeidmap(&treeidmap,"default");
+
+	std::vector<const char*> treeList;
+	const char *tree = NULL;
+	while ((tree = default_treestring("default",(int)treeList.size()))!=NULL) treeList.push_back(tree);
+
+	width = height = 0;
+	while (!timerDone()) {
+		startTimer();
+		for (unsigned int i=0;i<treeList.size();i++) treestring_to_id(&treeidmap,treeList[i]);
+		stopTimer();
+	}
+	writeResult("treestring_to_id",(int)treeList.size());
+
+	terminate_treeidmap(&treeidmap);
+}
+
+void Benchmark::runSegmentation(int items) {
+
+	int size = width*height;
+	unsigned char *dest = new unsigned char[size*BENCHMARK_FRAMES];
+
+	TiledBernsenThresholder thresholder;
+	initialize_tiled_bernsen_thresholder(&thresholder,width,height,2);
+	for (int i=0;!timerDone();i++) {
+		int f = i%BENCHMARK_FRAMES;
+		startTimer();
+		tiled_bernsen_threshold(&thresholder,dest+f*size,frameList[f],1,width,height,10,32);
+		stopTimer();
+	}
+	writeResult("tiled_bernsen_threshold",items);
+	terminate_tiled_bernsen_thresholder(&thresholder);
+
+	TreeIdMap treeidmap;
+	FidtrackerX fidtrackerx;
+	Segmenter segmenter;
+	PixelWarp pixelwarp;
+	initialize_treeidmap(&treeidmap,"default");
+	// the same grid size as the FiducialFinder without a configured calibration grid, which keeps the identity warp
+	initialize_pixelwarp(&pixelwarp,width,height,FiducialFinder::gridSizeX(width,height),FiducialFinder::gridSizeY(width,height));
+	initialize_fidtrackerX(&fidtrackerx,&treeidmap,&pixelwarp);
+	initialize_segmenter(&segmenter,width,height,treeidmap.max_adjacencies);
+
+	for (int i=0;!timerDone();i++) {
+		int f = i%BENCHMARK_FRAMES;
+		startTimer();
+		step_segmenter(&segmenter,dest+f*size);
+		stopTimer();
+	}
+	writeResult("step_segmenter",items);
+
+	// the fiducial search marks the regions, so each frame needs to be segmented again
+	FiducialX fiducials[MAX_FIDUCIAL_COUNT];
+	for (int i=0;!timerDone();i++) {
+		int f = i%BENCHMARK_FRAMES;
+		step_segmenter(&segmenter,dest+f*size);
+		startTimer();
+		find_fiducialsX(fiducials,MAX_FIDUCIAL_COUNT,&fidtrackerx,&segmenter,width,height);
+		stopTimer();
+	}
+	writeResult("find_fiducialsX",items);
+
+	// the blob analysis covers all regions of the finger, blob and fiducial root size range
+	BlobObject::setDimensions(width,height);
+	std::vector<BlobObject*> blobList;
+	for (int i=0;!timerDone();i++) {
+		step_segmenter(&segmenter,dest+(i%BENCHMARK_FRAMES)*size);
+		clearBlobs(blobList);
+		startTimer();
+		analyseBlobs(&segmenter,&pixelwarp,blobList);
+		stopTimer();
+	}
+	writeResult("BlobObject",items);
+
+	// the finger check always uses the blobs of the first frame
+	step_segmenter(&segmenter,dest);
+	clearBlobs(blobList);
+	analyseBlobs(&segmenter,&pixelwarp,blobList);
+	while (!timerDone()) {
+		startTimer();
+		for (unsigned int j=0;j<blobList.size();j++) FidtrackFinder::checkFinger(blobList[j]);
+		stopTimer();
+	}
+	writeResult("checkFinger",(int)blobList.size());
+
+	clearBlobs(blobList);
+	terminate_segmenter(&segmenter);
+	terminate_fidtrackerX(&fidtrackerx);
+	terminate_pixelwarp(&pixelwarp);
+	terminate_treeidmap(&treeidmap);
+	delete[] dest;
+}
+
+void Benchmark::runTuioServer(int items) {
+
+	TUIO::TuioServer *server = new TUIO::TuioServer(new DiscardSender());
+
+	// the same components as in the rendered scene, at fixed positions
+	TUIO::TuioTime frameTime = TUIO::TuioTime::getSessionTime();
+	server->initFrame(frameTime);
+	for (int i=0;i<items;i++) {
+		float x = (i%16)/16.0f;
+		float y = (i/16)/16.0f;
+		if (i<items/2) server->addTuioObject(i,x,y,i*0.1f);
+		else if (i<items/2+items/4) server->addTuioCursor(x,y);
+		else server->addTuioBlob(x,y,i*0.1f,0.02f,0.01f,0.0002f);
+	}
+	server->commitFrame();
+
+	// a full update serializes all components of the frame
+	while (!timerDone()) {
+		startTimer();
+		server->sendFullMessages();
+		stopTimer();
+	}
+	writeResult("TuioServer",items);
+
+	delete server;
+}
+
+void Benchmark::startTimer() {
+	start_time = std::chrono::steady_clock::now();
+	if (samples.size()==0) first_time = start_time;
+}
+
+void Benchmark::stopTimer() {
+	double duration = std::chrono::duration<double>(std::chrono::steady_clock::now()-start_time).count();
+	samples.push_back(duration);
+	total_time += duration;
+}
+
+// the kernels run for a minimum measured time, unless their preparation takes much longer than the kernel itself
+bool Benchmark::timerDone() {
+	if (samples.size()>=BENCHMARK_MAX_RUNS) return true;
+	if (samples.size()<BENCHMARK_MIN_RUNS) return false;
+	double elapsed_time = std::chrono::duration<double>(std::chrono::steady_clock::now()-first_time).count();
+	return ((total_time>=BENCHMARK_MIN_TIME) || (elapsed_time>=BENCHMARK_MAX_TIME));
+}
+
+void Benchmark::writeResult(const char *kernel, int items) {
+
+	std::sort(samples.begin(),samples.end());
+	double median = samples[samples.size()/2]*1000000.0;
+	double minimum = samples[0]*1000000.0;
+
+	fprintf(result,"%s\t%d\t%d\t%d\t%d\t%.2f\t%.2f\n",kernel,width,height,items,(int)samples.size(),median,minimum);
+	if (result!=stdout) printf("%s\t%d\t%d\t%d\t%d\t%.2f\t%.2f\n",kernel,width,height,items,(int)samples.size(),median,minimum);
+	fflush(result);
+
+	samples.clear();
+	total_time = 0.0;
+}
@@ -0,0 +1,66 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+#include <vector>
+#include <chrono>
+
+#define BENCHMARK_FRAMES 8
+#define BENCHMARK_CELL 160
+#define BENCHMARK_MIN_RUNS 20
+#define BENCHMARK_MAX_RUNS 1000
+#define BENCHMARK_MIN_TIME 0.25
+#define BENCHMARK_MAX_TIME 1.0
+
+// runs repeatable microbenchmarks of the image processing and TUIO kernels on the frames of the default synthetic scene
+// at several resolutions and object densities, the results are written as tab separated lines which can be compared between builds
+class Benchmark
+{
+public:
+	Benchmark();
+	~Benchmark();
+
+	bool run(const char *result_file);
+
+private:
+	bool renderScene(int width, int height, int items);
+	void runConversions();
+	void runTreeIdMap();
+	void runSegmentation(int items);
+	void runTuioServer(int items);
+
+	void startTimer();
+	void stopTimer();
+	bool timerDone();
+	void writeResult(const char *kernel, int items);
+
+	int width, height;
+	std::vector<unsigned char*> frameList;
+
+	std::vector<double> samples;
+	double total_time;
+	std::chrono::steady_clock::time_point start_time;
+	std::chrono::steady_clock::time_point first_time;
+
+	FILE *result;
+};
+
+#endif
@@ -240,8 +240,21 @@ BlobPoint* BlobMatrix::solve(BlobPoint *a) {
 			a->x = 1.0f;
 			a->y = -(m00-m10)/d;
 		} else {
-			//std::cout << "no general solution" << std::endl;
-			return NULL;
+			// equal rows cancel out, their sum still has the same direction
+			d = m00+m10;
+			if (fabs(d) > BlobMatrix::EPS) {
+				a->y = 1.0f;
+				a->x = -(m01+m11)/d;
+			} else {
+				d = m01+m11;
+				if (fabs(d) > BlobMatrix::EPS) {
+					a->x = 1.0f;
+					a->y = -(m00+m10)/d;
+				} else {
+					//std::cout << "no general solution" << std::endl;
+					return NULL;
+				}
+			}
 		}
 	}
 	return a;
@@ -23,7 +23,7 @@ int BlobObject::screenWidth = WIDTH;
 int BlobObject::screenHeight = HEIGHT;
 UserInterface* BlobObject::ui = NULL;
 
-BlobObject::BlobObject(TuioTime ttime, Region *region, ShortPoint *dmap, bool do_full_analyis):TuioBlob(ttime, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f) {
+BlobObject::BlobObject(TuioTime ttime, Region *region, PixelWarp *warp, bool do_full_analyis):TuioBlob(ttime, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f) {
 	
 	if (region==NULL) throw std::exception();
 	blobRegion = region;
@@ -58,24 +58,28 @@ BlobObject::BlobObject(TuioTime ttime, Region *region, ShortPoint *dmap, bool do
 		if (fullContour.size()==0) throw std::exception();
 		
 #ifndef NDEBUG
-		ui->setColor(255,0,255);
-		for (unsigned int i=0; i<fullContour.size(); i++)
-			ui->drawPoint(fullContour[i].x, fullContour[i].y);
+		if (ui) {
+			ui->setColor(255,0,255);
+			for (unsigned int i=0; i<fullContour.size(); i++)
+				ui->drawPoint(fullContour[i].x, fullContour[i].y);
+		}
 #endif
 
 	} else {
 		
 #ifndef NDEBUG
-		ui->setColor(255,0,0);
-		BlobPoint ch_pt = convexHull[0];
-		for (unsigned int i = 1; i < convexHull.size(); i++) {
-		 BlobPoint pt1 = convexHull[i];
-		 ui->drawLine(ch_pt.x,ch_pt.y,pt1.x,pt1.y);
-		 ch_pt.x = pt1.x;
-		 ch_pt.y = pt1.y;
+		if (ui) {
+			ui->setColor(255,0,0);
+			BlobPoint ch_pt = convexHull[0];
+			for (unsigned int i = 1; i < convexHull.size(); i++) {
+			 BlobPoint pt1 = convexHull[i];
+			 ui->drawLine(ch_pt.x,ch_pt.y,pt1.x,pt1.y);
+			 ch_pt.x = pt1.x;
+			 ch_pt.y = pt1.y;
+			}
+			BlobPoint pt1 = convexHull[0];
+			ui->drawLine(ch_pt.x,ch_pt.y,pt1.x,pt1.y);
 		}
-		BlobPoint pt1 = convexHull[0];
-		ui->drawLine(ch_pt.x,ch_pt.y,pt1.x,pt1.y);
 #endif
 		
 	}
@@ -96,12 +100,11 @@ BlobObject::BlobObject(TuioTime ttime, Region *region, ShortPoint *dmap, bool do
 	rawXpos = obBox[4].x;
 	rawYpos = obBox[4].y;
 	
-	if(dmap) {
-		int pixel = screenWidth*(int)floor(rawYpos+.5f) + (int)floor(rawXpos+.5f);
-		if ((pixel>=0) || (pixel<screenWidth*screenHeight)) {
-			xpos = dmap[ pixel ].x/(float)screenWidth;
-			ypos = dmap[ pixel ].y/(float)screenHeight;
-		}
+	if(warp) {
+		float warpedX, warpedY;
+		warp_point(warp, rawXpos, rawYpos, &warpedX, &warpedY);
+		xpos = warpedX/screenWidth;
+		ypos = warpedY/screenHeight;
 	} else {
 		xpos = rawXpos/screenWidth;
 		ypos = rawYpos/screenHeight;
@@ -133,6 +136,10 @@ BlobObject::BlobObject(TuioTime ttime, Region *region, ShortPoint *dmap, bool do
 	height = rawHeight/screenHeight;
 	area = (float)region->area/(screenWidth*screenHeight);
 
+	// the path starts at the blob position, so that the first update does not move it from the origin
+	path.clear();
+	path.push_back(currentTime,xpos,ypos);
+
 /*
 #ifndef NDEBUG
 	ui->setColor(0,255,0);
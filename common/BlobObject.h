@@ -41,7 +41,7 @@ namespace TUIO {
 
 	public:
 		
-		BlobObject(TuioTime ttime, Region *region, ShortPoint *dmap, bool do_full_analysis=false);
+		BlobObject(TuioTime ttime, Region *region, PixelWarp *warp, bool do_full_analysis=false);
 		
 		//void setX(float xp) { xpos = xp; }
 		//void setY(float yp) { ypos = yp; }
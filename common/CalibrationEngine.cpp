@@ -79,10 +79,8 @@ bool CalibrationEngine::init(int w, int h, int sb, int db) {
 	
 	FrameProcessor::init(w,h,sb,db);
 	
-	grid_size_x = 7;
-	if (((float)width/height) > 1.3) grid_size_x +=2;
-	if (((float)width/height) > 1.7) grid_size_x +=2;
-	grid_size_y = 7;
+	grid_size_x = FiducialFinder::gridSizeX(width,height);
+	grid_size_y = FiducialFinder::gridSizeY(width,height);
 	
 	field_count_x = grid_size_x-1;
 	field_count_y = grid_size_y-1;
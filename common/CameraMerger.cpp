@@ -0,0 +1,66 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "CameraMerger.h"
+
+CameraMerger::CameraMerger(TUIO::TuioServer *server, TUIO::TuioManager *manager, application_settings *config) {
+
+	server_ = server;
+	manager_ = manager;
+
+	// the inversion of the main camera is applied to the merged components instead
+	publisher_ = new TUIO::TuioSnapshotPublisher(manager_);
+	publisher_->enableInversion(false);
+
+	merger_ = new TUIO::TuioMerger(server_, config->merge_distance);
+	merger_->setSourceTimeout(CAMERA_TIMEOUT);
+	addSource(publisher_, &config->cameras[0]);
+}
+
+CameraMerger::~CameraMerger() {
+	delete merger_;
+	delete publisher_;
+}
+
+int CameraMerger::addSource(TUIO::TuioSnapshotPublisher *publisher, camera_settings *camera) {
+
+	publisherList.push_back(publisher);
+	frameList.push_back(0);
+	return merger_->addSource(camera->x, camera->y, camera->width, camera->height, camera->angle*(float)M_PI/180.0f);
+}
+
+void CameraMerger::addPipeline(CameraPipeline *pipeline) {
+	addSource(pipeline->getPublisher(), pipeline->getCameraSettings());
+}
+
+void CameraMerger::process(unsigned char *src, unsigned char *dest) {
+
+	for (unsigned int i=0;i<publisherList.size();i++) {
+		if (publisherList[i]->getFrameID()==frameList[i]) continue;
+
+		const TUIO::TuioSnapshot *snapshot = publisherList[i]->acquireSnapshot();
+		if (snapshot==NULL) continue;
+		merger_->updateSource(i, snapshot);
+		frameList[i] = snapshot->getFrameID();
+		publisherList[i]->releaseSnapshot(snapshot);
+	}
+
+	// the inversion settings of the main camera apply to the whole surface
+	server_->setInversion(manager_->getInvertXpos(), manager_->getInvertYpos(), manager_->getInvertAngle());
+	merger_->commitFrame(TUIO::TuioTime::getSystemTime());
+}
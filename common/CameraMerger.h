@@ -0,0 +1,54 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CAMERAMERGER_H
+#define CAMERAMERGER_H
+
+#include <vector>
+#include "Main.h"
+#include "FrameProcessor.h"
+#include "CameraPipeline.h"
+#include "TuioServer.h"
+#include "TuioMerger.h"
+
+#define CAMERA_TIMEOUT 1.0f
+
+// merges the components of the main camera and all additional camera pipelines into the TuioServer
+// it is added after the main fiducial finder, so each frame of the main camera also commits a merged frame
+class CameraMerger: public FrameProcessor
+{
+public:
+	CameraMerger(TUIO::TuioServer *server, TUIO::TuioManager *manager, application_settings *config);
+	~CameraMerger();
+
+	void addPipeline(CameraPipeline *pipeline);
+	void process(unsigned char *src, unsigned char *dest);
+
+private:
+	int addSource(TUIO::TuioSnapshotPublisher *publisher, camera_settings *camera);
+
+	TUIO::TuioServer *server_;
+	TUIO::TuioManager *manager_;
+	TUIO::TuioSnapshotPublisher *publisher_;
+	TUIO::TuioMerger *merger_;
+
+	std::vector<TUIO::TuioSnapshotPublisher*> publisherList;
+	std::vector<long> frameList;
+};
+
+#endif
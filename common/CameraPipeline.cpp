@@ -0,0 +1,163 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "CameraPipeline.h"
+
+CameraPipeline::CameraPipeline(application_settings *config, camera_settings *camera)
+: running_( false )
+, camera_( NULL )
+, destBuffer_( NULL )
+{
+	settings_ = *config;
+	camera_settings_ = *camera;
+	sprintf(settings_.grid_config,"%s",camera->grid_config);
+	settings_.thread_count = camera->thread_count;
+
+	// the camera tool only keeps a single static configuration, which is therefore copied
+	camera_config_ = *CameraTool::readSettings(camera->camera_config);
+
+	// the main TuioManager applies the inversion to the merged components
+	manager_ = new TUIO::TuioManager();
+	manager_->enablePathHistory(false);
+	publisher_ = new TUIO::TuioSnapshotPublisher(manager_);
+	publisher_->enableInversion(false);
+
+	thresholder_ = new FrameThresholder(settings_.gradient_gate, settings_.tile_size, settings_.thread_count, settings_.pyramid_level, settings_.scan_interval, settings_.threshold_method);
+	if (settings_.background) thresholder_->toggleFlag(KEY_SPACE,false);
+	fiducialfinder_ = new FidtrackFinder(manager_, &settings_);
+	fiducialfinder_->setThresholder(thresholder_);
+}
+
+CameraPipeline::~CameraPipeline() {
+
+	stop();
+	delete fiducialfinder_;
+	delete thresholder_;
+	delete publisher_;
+	delete manager_;
+	if (destBuffer_) delete[] destBuffer_;
+}
+
+bool CameraPipeline::start() {
+
+	camera_ = CameraTool::getCamera(&camera_config_);
+	if (camera_==NULL) {
+		printf("could not find camera %s\n",camera_settings_.camera_config);
+		return false;
+	}
+
+	if ((!camera_->initCamera()) || (!camera_->startCamera())) {
+		printf("could not start camera %s\n",camera_settings_.camera_config);
+		camera_->closeCamera();
+		delete camera_;
+		camera_ = NULL;
+		return false;
+	}
+	camera_->printInfo();
+
+	destBuffer_ = new unsigned char[camera_->getWidth()*camera_->getHeight()*camera_->getFormat()];
+
+	running_ = true;
+#ifdef WIN32
+	DWORD threadId;
+	thread_ = CreateThread( 0, 0, pipelineThread, this, 0, &threadId );
+	if (thread_==NULL) running_ = false;
+#else
+	if (pthread_create(&thread_ , NULL, pipelineThread, this)!=0) running_ = false;
+#endif
+
+	if (!running_) {
+		camera_->stopCamera();
+		camera_->closeCamera();
+		delete camera_;
+		camera_ = NULL;
+	}
+	return running_;
+}
+
+void CameraPipeline::stop() {
+
+	if (camera_==NULL) return;
+
+	running_ = false;
+#ifdef WIN32
+	WaitForSingleObject(thread_,INFINITE);
+	CloseHandle(thread_);
+#else
+	pthread_join(thread_,NULL);
+#endif
+
+	camera_->stopCamera();
+	camera_->closeCamera();
+	delete camera_;
+	camera_ = NULL;
+}
+
+#ifdef WIN32
+DWORD WINAPI CameraPipeline::pipelineThread(LPVOID obj)
+#else
+void* CameraPipeline::pipelineThread(void *obj)
+#endif
+{
+	CameraPipeline *pipeline = (CameraPipeline *)obj;
+	pipeline->setAffinity();
+	pipeline->processFrames();
+	return 0;
+}
+
+// pins the pipeline to its own cores, the thresholder threads inherit this on Linux
+void CameraPipeline::setAffinity() {
+
+	if (camera_settings_.cpu<0) return;
+
+#ifdef WIN32
+	DWORD_PTR mask = 0;
+	for (int i=0;i<settings_.thread_count;i++) mask |= ((DWORD_PTR)1)<<(camera_settings_.cpu+i);
+	SetThreadAffinityMask(GetCurrentThread(), mask);
+#elif defined LINUX
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	for (int i=0;i<settings_.thread_count;i++) CPU_SET(camera_settings_.cpu+i, &cpus);
+	pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus);
+#endif
+}
+
+void CameraPipeline::processFrames() {
+
+	int width = camera_->getWidth();
+	int height = camera_->getHeight();
+	int format = camera_->getFormat();
+
+	if ((!thresholder_->init(width, height, format, format)) || (!fiducialfinder_->init(width, height, format, format))) {
+		printf("could not initialize camera %s\n",camera_settings_.camera_config);
+		running_ = false;
+		return;
+	}
+
+	while(running_) {
+		unsigned char *cameraBuffer = camera_->getFrame();
+		if (cameraBuffer!=NULL) {
+			thresholder_->process(cameraBuffer,destBuffer_);
+			fiducialfinder_->process(cameraBuffer,destBuffer_);
+			pv_sleep();
+		} else {
+			if (!camera_->stillRunning()) running_ = false;
+			else pv_sleep();
+		}
+	}
+}
@@ -0,0 +1,73 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CAMERAPIPELINE_H
+#define CAMERAPIPELINE_H
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "Main.h"
+#include "CameraTool.h"
+#include "FrameThresholder.h"
+#include "FidtrackFinder.h"
+#include "TuioSnapshotPublisher.h"
+
+// an additional camera of a multi-camera surface, which runs its own thresholder and fiducial finder
+// in a separate thread and publishes the tracked components of its own TuioManager as snapshots
+class CameraPipeline
+{
+public:
+	CameraPipeline(application_settings *config, camera_settings *camera);
+	~CameraPipeline();
+
+	bool start();
+	void stop();
+
+	TUIO::TuioSnapshotPublisher* getPublisher() { return publisher_; };
+	camera_settings* getCameraSettings() { return &camera_settings_; };
+
+	bool running_;
+
+private:
+#ifdef WIN32
+	static DWORD WINAPI pipelineThread(LPVOID obj);
+	HANDLE thread_;
+#else
+	static void* pipelineThread(void *obj);
+	pthread_t thread_;
+#endif
+	void setAffinity();
+	void processFrames();
+
+	application_settings settings_;
+	camera_settings camera_settings_;
+	CameraConfig camera_config_;
+	CameraEngine *camera_;
+
+	TUIO::TuioManager *manager_;
+	TUIO::TuioSnapshotPublisher *publisher_;
+	FrameThresholder *thresholder_;
+	FidtrackFinder *fiducialfinder_;
+	unsigned char *destBuffer_;
+};
+
+#endif
@@ -36,7 +36,7 @@ bool FidtrackFinder::init(int w, int h, int sb, int db) {
 	help_text.push_back( "   y - toggle yamaarashi detection");
 
 	initialize_treeidmap( &treeidmap, tree_config );	
-	initialize_fidtrackerX( &fidtrackerx, &treeidmap, dmap);
+	initialize_fidtrackerX( &fidtrackerx, &treeidmap, &pixelwarp);
 	initialize_segmenter( &segmenter, width, height, treeidmap.max_adjacencies );
 	BlobObject::setDimensions(width,height);
 
@@ -302,7 +302,7 @@ void FidtrackFinder::decodeYamaarashi(FiducialX *yama, unsigned char *img, TuioT
 
 	BlobObject *yamaBlob = NULL;
 	try {
-		yamaBlob = new BlobObject(ftime,yama->root, dmap);
+		yamaBlob = new BlobObject(ftime,yama->root, &pixelwarp);
 	} catch (std::exception e) {
 		yama->id = INVALID_FIDUCIAL_ID;
 		return;
@@ -446,8 +446,10 @@ void FidtrackFinder::decodeYamaarashi(FiducialX *yama, unsigned char *img, TuioT
 			}
 			
 #ifndef NDEBUG
-			ui->setColor(255, 0, 255);
-			ui->drawLine(bx,by,px,py);
+			if (ui) {
+				ui->setColor(255, 0, 255);
+				ui->drawLine(bx,by,px,py);
+			}
 #endif
 			
 			if (bitpos<20) {
@@ -489,11 +491,10 @@ void FidtrackFinder::decodeYamaarashi(FiducialX *yama, unsigned char *img, TuioT
 	}*/
 	
 	if(!empty_grid) {
-		int pixel = width*(int)floor(yama->raw_y+.5f) + (int)floor(yama->raw_x+.5f);
-		if ((pixel>=0) || (pixel<width*height)) {
-			yama->x = dmap[ pixel ].x/width;
-			yama->y = dmap[ pixel ].y/height;
-		}
+		float warped_x, warped_y;
+		warp_point(&pixelwarp, yama->raw_x, yama->raw_y, &warped_x, &warped_y);
+		yama->x = warped_x/width;
+		yama->y = warped_y/height;
 	} else {
 		yama->x = yama->raw_x/width;
 		yama->y = yama->raw_y/height;
@@ -556,7 +557,9 @@ float FidtrackFinder::checkFinger(BlobObject *fblob) {
 void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 	
 	TuioTime frameTime = TuioTime::getSystemTime();
-	tuioManager->initFrame(frameTime);
+	// the processing latency also covers the thresholding of the frame
+	if (thresholder) tuioManager->initFrame(frameTime, thresholder->getFrameStartTime());
+	else tuioManager->initFrame(frameTime);
 	//std::cout << "frame: " << totalframes << std::endl;
 
 	std::list<TuioObject*> objectList = tuioManager->getTuioObjects();
@@ -595,9 +598,15 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 	//std::cout << "blob size: " << min_blob_size << " " << max_blob_size << std::endl;
 	//std::cout << "region size: " << min_region_size << " " << max_region_size << std::endl;
 
+	tracked_windows.clear();
+
 	// -----------------------------------------------------------------------------------------------
 	// do the libfidtrack image segmentation
-	step_segmenter( &segmenter, dest );
+	const SegmenterWindow *windows = NULL;
+	int window_count = 0;
+	if ((thresholder!=NULL) && (thresholder->getWindows(&windows,&window_count)))
+		step_window_segmenter( &segmenter, dest, windows, window_count );
+	else step_segmenter( &segmenter, dest );
 
 #ifndef NDEBUG
 	sanity_check_region_initial_values( &segmenter );
@@ -641,15 +650,6 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 		
 		if ((r->size>=min_region_size) && (r->size<=max_region_size)) {
 			
-			if(!empty_grid) {
-				int pixel = width*(int)floor(r->y+.5f) + (int)floor(r->x+.5f);
-				if ((pixel>=0) || (pixel<width*height)) {
-					r->x = dmap[ pixel ].x;
-					r->y = dmap[ pixel ].y;
-				}
-				//if ((regions[reg_count].x==0) && (regions[reg_count].y==0)) continue;
-			}
-			
 			r->x = r->raw_x/width;
 			r->y = r->raw_y/height;
 
@@ -688,6 +688,7 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 
 			if (fiducials[fid_count].id!=INVALID_FIDUCIAL_ID) {
 				fiducialList.push_back(&fiducials[fid_count]);
+				addTrackedWindow(fiducials[fid_count].root);
 				fid_count ++;
 			}
 		}
@@ -734,8 +735,9 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 			if (add_blob) {
 				BlobObject *root_blob = NULL;
 				try {
-					root_blob = new BlobObject(frameTime,regions[i],dmap);
+					root_blob = new BlobObject(frameTime,regions[i],&pixelwarp);
 					rootBlobs.push_back(root_blob);
+					addTrackedWindow(regions[i]);
 				} catch (std::exception e) { if (root_blob) delete root_blob; }
 			}
 			
@@ -776,8 +778,9 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 			if (add_blob) {
 				BlobObject *finger_blob = NULL;
 				try {
-					finger_blob = new BlobObject(frameTime,regions[i],dmap,true);
+					finger_blob = new BlobObject(frameTime,regions[i],&pixelwarp,true);
 					fingerBlobs.push_back(finger_blob);
+					addTrackedWindow(regions[i]);
 				} catch (std::exception e) { if (finger_blob) delete finger_blob; }
 			}
 			
@@ -788,8 +791,9 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 			// add the remaining plain blob
 			BlobObject *plain_blob = NULL;
 			try {
-				plain_blob = new BlobObject(frameTime,regions[i],dmap);
+				plain_blob = new BlobObject(frameTime,regions[i],&pixelwarp);
 				plainBlobs.push_back(plain_blob);
+				addTrackedWindow(regions[i]);
 			} catch (std::exception e) { if (plain_blob) delete plain_blob; }
 		}
 		
@@ -866,12 +870,12 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 			try {
 				
 				if ((da>M_PI/90.0f) || (dp>2)) {
-					fid_blob = new BlobObject(frameTime,closest_fid->root,dmap);
+					fid_blob = new BlobObject(frameTime,closest_fid->root,&pixelwarp);
 					existing_object->setRootOffset(existing_object->getX()-fid_blob->getX(),existing_object->getY()-fid_blob->getY());
 				}
 				
 				if (send_fiducial_blobs) {
-					if (fid_blob==NULL) fid_blob = new BlobObject(frameTime,closest_fid->root,dmap);
+					if (fid_blob==NULL) fid_blob = new BlobObject(frameTime,closest_fid->root,&pixelwarp);
 					TuioBlob *existing_blob = tuioManager->getTuioBlob(existing_object->getSessionID());
 					if (existing_blob) tuioManager->updateTuioBlob(existing_blob,fid_blob->getX(),fid_blob->getY(),fid_blob->getAngle(),fid_blob->getWidth(),fid_blob->getHeight(),fid_blob->getArea());
 				}
@@ -899,7 +903,7 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 			if (send_fiducial_blobs) {
 				BlobObject *fid_blob = NULL;
 				try {
-					fid_blob = new BlobObject(frameTime,alt_fid->root,dmap);
+					fid_blob = new BlobObject(frameTime,alt_fid->root,&pixelwarp);
 					//existing_object->setRootOffset(existing_object->getX()-fid_blob->getX(),existing_object->getY()-fid_blob->getY());
 					TuioBlob *existing_blob = tuioManager->getTuioBlob(existing_object->getSessionID());
 					if (existing_blob) tuioManager->updateTuioBlob(existing_blob,fid_blob->getX(),fid_blob->getY(),fid_blob->getAngle(),fid_blob->getWidth(),fid_blob->getHeight(),fid_blob->getArea());
@@ -925,7 +929,7 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 				
 				BlobObject *fid_blob = NULL;
 				try {
-					fid_blob = new BlobObject(frameTime,alt_fid->root,dmap);
+					fid_blob = new BlobObject(frameTime,alt_fid->root,&pixelwarp);
 					existing_object->setRootOffset(existing_object->getX()-fid_blob->getX(),existing_object->getY()-fid_blob->getY());
 					
 					if (send_fiducial_blobs) {
@@ -1038,13 +1042,13 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 		
 		BlobObject *fid_blob = NULL;
 		try {
-			fid_blob = new BlobObject(frameTime,fiducial->root,dmap);
+			fid_blob = new BlobObject(frameTime,fiducial->root,&pixelwarp);
 			add_object->setRootOffset(add_object->getX()-fid_blob->getX(),add_object->getY()-fid_blob->getY());
 			
 			if (send_fiducial_blobs) {
 				
 				tuioManager->addExternalTuioBlob(fid_blob);
-				fid_blob->setSessionID(add_object->getSessionID());
+				tuioManager->setBlobSessionID(fid_blob,add_object->getSessionID());
 				
 				fid_blob->addPositionThreshold(position_threshold*2.0f);
 				fid_blob->addAngleThreshold(rotation_threshold*2.0f);
@@ -1119,8 +1123,10 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 
 				tuioManager->updateTuioCursor((*tcur),closest_fblob->getX(),closest_fblob->getY());
 				drawObject(FINGER_ID,(*tcur)->getX(),(*tcur)->getY(),0);
-				ui->setColor(0,255,0);
-				ui->drawEllipse(closest_fblob->getX()*width,closest_fblob->getY()*height,closest_fblob->getWidth()*width,closest_fblob->getHeight()*height,closest_fblob->getAngle());
+				if (ui) {
+					ui->setColor(0,255,0);
+					ui->drawEllipse(closest_fblob->getX()*width,closest_fblob->getY()*height,closest_fblob->getWidth()*width,closest_fblob->getHeight()*height,closest_fblob->getAngle());
+				}
 
 				if (send_finger_blobs) {
 					TuioBlob *existing_blob = tuioManager->getTuioBlob((*tcur)->getSessionID());
@@ -1153,7 +1159,7 @@ void FidtrackFinder::process(unsigned char *src, unsigned char *dest) {
 
 			if (send_finger_blobs) {
 				TuioBlob *cur_blob = tuioManager->addTuioBlob((*fblb)->getX(),(*fblb)->getY(),(*fblb)->getAngle(),(*fblb)->getWidth(),(*fblb)->getHeight(),(*fblb)->getArea());
-				cur_blob->setSessionID(add_cursor->getSessionID());
+				tuioManager->setBlobSessionID(cur_blob,add_cursor->getSessionID());
 				
 				if (blbFilter) {
 					cur_blob->addPositionFilter(2.0f,0.25f);
@@ -1226,8 +1232,10 @@ if (detect_blobs) {
 			tuioManager->updateTuioBlob((*tblb),closest_blob->getX(),closest_blob->getY(),closest_blob->getAngle(),closest_blob->getWidth(),closest_blob->getHeight(),closest_blob->getArea());
 			drawObject(BLOB_ID,(*tblb)->getX(),(*tblb)->getY(),0);
 			
-			ui->setColor(0,0,255);
-			ui->drawEllipse((*tblb)->getX()*width,(*tblb)->getY()*height,(*tblb)->getWidth()*width,(*tblb)->getHeight()*height,(*tblb)->getAngle());
+			if (ui) {
+				ui->setColor(0,0,255);
+				ui->drawEllipse((*tblb)->getX()*width,(*tblb)->getY()*height,(*tblb)->getWidth()*width,(*tblb)->getHeight()*height,(*tblb)->getAngle());
+			}
 			
 			plainBlobs.remove(closest_blob);
 			delete closest_blob;
@@ -1240,8 +1248,8 @@ if (detect_blobs) {
 		
 		// double check if blob is within existing fiducial
 		bool add_blob = true;
-		objectList = tuioManager->getTuioObjects();
-		for (std::list<TuioObject*>::iterator iter = objectList.begin(); iter!=objectList.end(); iter++) {
+		const std::list<TuioObject*> &currentObjects = tuioManager->getTuioObjectList();
+		for (std::list<TuioObject*>::const_iterator iter = currentObjects.begin(); iter!=currentObjects.end(); iter++) {
 			FiducialObject *tobj = (FiducialObject*)(*iter);
 			float distance = tobj->getScreenDistance((*pblb)->getX(), (*pblb)->getY(),width,height);
 			if (distance<tobj->getRootSize()/2.0f) {
@@ -1264,8 +1272,10 @@ if (detect_blobs) {
 			}
 			tuioManager->addExternalTuioBlob(add_blob);
 			drawObject(BLOB_ID,add_blob->getX(),add_blob->getY(),0);
-			ui->setColor(0,0,255);
-			ui->drawEllipse((*pblb)->getX()*width,(*pblb)->getY()*height,(*pblb)->getWidth()*width,(*pblb)->getHeight()*height,(*pblb)->getAngle());
+			if (ui) {
+				ui->setColor(0,0,255);
+				ui->drawEllipse((*pblb)->getX()*width,(*pblb)->getY()*height,(*pblb)->getWidth()*width,(*pblb)->getHeight()*height,(*pblb)->getAngle());
+			}
 			
 			
 		} else delete (*pblb);
@@ -1276,6 +1286,8 @@ if (detect_blobs) {
 		delete (*rblb);
 	}
 }
+	if ((thresholder!=NULL) && (thresholder->getScanInterval()>0)) updateTrackedWindows();
+
 	tuioManager->stopUntouchedMovingObjects();
 	tuioManager->stopUntouchedMovingCursors();
 	tuioManager->stopUntouchedMovingBlobs();
@@ -1283,13 +1295,65 @@ if (detect_blobs) {
 	tuioManager->removeUntouchedStoppedCursors();
 	tuioManager->removeUntouchedStoppedBlobs();
 	//printStatistics(frameTime);
-	((TuioServer*)tuioManager)->commitFrame();
+	tuioManager->commitFrame();
 	
 	if (show_grid) drawGrid(src,dest);
 	if (show_settings) displayControl();
 	totalframes++;
 }
 
+void FidtrackFinder::addTrackedWindow(Region *region) {
+
+	SegmenterWindow window = { region->left, region->top, region->right, region->bottom };
+	tracked_windows.push_back(window);
+}
+
+void FidtrackFinder::updateTrackedWindows() {
+
+	// the windows need to cover the largest predicted motion of all components,
+	// and any component that was not found in this frame requests a full scan
+	TuioTime frameTime = tuioManager->getFrameTime();
+	bool lost = false;
+	float motion = 0.0f;
+	const std::list<TuioObject*> &objectList = tuioManager->getTuioObjectList();
+	for (std::list<TuioObject*>::const_iterator tobj = objectList.begin(); tobj!=objectList.end(); tobj++) {
+		if ((*tobj)->getTuioTime()!=frameTime) lost = true;
+		TuioPoint opos = (*tobj)->predictPosition();
+		float distance = (*tobj)->getScreenDistance(opos.getX(),opos.getY(),width,height);
+		if (distance>motion) motion = distance;
+	}
+	const std::list<TuioCursor*> &cursorList = tuioManager->getTuioCursorList();
+	for (std::list<TuioCursor*>::const_iterator tcur = cursorList.begin(); tcur!=cursorList.end(); tcur++) {
+		if ((*tcur)->getTuioTime()!=frameTime) lost = true;
+		TuioPoint cpos = (*tcur)->predictPosition();
+		float distance = (*tcur)->getScreenDistance(cpos.getX(),cpos.getY(),width,height);
+		if (distance>motion) motion = distance;
+	}
+	const std::list<TuioBlob*> &blobList = tuioManager->getTuioBlobList();
+	for (std::list<TuioBlob*>::const_iterator tblb = blobList.begin(); tblb!=blobList.end(); tblb++) {
+		if ((*tblb)->getTuioTime()!=frameTime) lost = true;
+		TuioPoint bpos = (*tblb)->predictPosition();
+		float distance = (*tblb)->getScreenDistance(bpos.getX(),bpos.getY(),width,height);
+		if (distance>motion) motion = distance;
+	}
+
+	// each window is extended by half its size, twice the motion and two thresholder tiles
+	int margin = (int)(2.0f*motion) + 2*thresholder->getTileSize();
+	for (unsigned int i=0;i<tracked_windows.size();i++) {
+		SegmenterWindow *window = &tracked_windows[i];
+		int extent = window->right-window->left;
+		if (window->bottom-window->top>extent) extent = window->bottom-window->top;
+		extent = extent/2 + margin;
+
+		window->left -= extent;
+		window->top -= extent;
+		window->right += extent;
+		window->bottom += extent;
+	}
+
+	thresholder->setTrackedWindows(tracked_windows, lost);
+}
+
 void FidtrackFinder::printStatistics(TuioTime frameTime) {
 	
 	TuioTime endTime = TuioTime::getSystemTime() -frameTime;
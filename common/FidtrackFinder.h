@@ -21,6 +21,7 @@
 
 #include "Main.h"
 #include "FiducialFinder.h"
+#include "FrameThresholder.h"
 #include "FiducialObject.h"
 #include "BlobObject.h"
 #include "TuioCursor.h"
@@ -81,6 +82,8 @@ public:
 		objFilter = config->obj_filter;
 		curFilter = config->cur_filter;
 		blbFilter = config->blb_filter;
+		
+		thresholder = NULL;
 	};
 	
 	~FidtrackFinder() {
@@ -109,10 +112,17 @@ public:
 	bool getYamaarashi() { return detect_yamaarashi; };
 	bool getYamaFlip() { return invert_yamaarashi; };
 
+	// the mean deviation of the blob contour from its ellipse, which is small for fingers
+	static float checkFinger(BlobObject *fblob);
+
 	void reset();
 	
+	// in the pyramid mode only the windows thresholded by this thresholder are segmented
+	void setThresholder(FrameThresholder *frameThresholder) { thresholder = frameThresholder; };
+	
 private:
 	Segmenter segmenter;
+	FrameThresholder *thresholder;
 	char tree_config[255];
 	
 	FiducialX fiducials[ MAX_FIDUCIAL_COUNT ];
@@ -121,6 +131,10 @@ private:
 	FidtrackerX fidtrackerx;
 	
 	void printStatistics(TUIO::TuioTime frameTime);
+	void addTrackedWindow(Region *region);
+	void updateTrackedWindows();
+	
+	std::vector<SegmenterWindow> tracked_windows;
 	
 	bool detect_fingers;
 	int average_finger_size;
@@ -150,7 +164,6 @@ private:
 	bool detect_yamaarashi;
 	bool invert_yamaarashi;
 	void decodeYamaarashi(FiducialX *yama, unsigned char *img, TuioTime ftime);
-	float checkFinger(BlobObject *fblob);
 };
 
 #endif
@@ -20,6 +20,13 @@
 #include "FiducialObject.h"
 #include "CalibrationGrid.h"
 
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 bool FiducialFinder::init(int w, int h, int sb ,int db) {
 	FrameProcessor::init(w,h,sb,db);
 	
@@ -27,38 +34,189 @@ bool FiducialFinder::init(int w, int h, int sb ,int db) {
 	help_text.push_back( "   i - invert x-axis, y-axis or angle");
 	
 	show_grid=false;
-	dmap = new ShortPoint[height*width];
+	if (dmap) {
+		delete[] dmap;
+		dmap = NULL;
+	}
+	
+	terminate_pixelwarp(&pixelwarp);
 	computeGrid();
 	
 	return true;
 }
 
+typedef struct grid_data {
+	CalibrationGrid *grid;
+	int *target;
+	int width, height;
+	int cell_width, cell_height;
+	int first_row, last_row;
+} grid_data;
+
+// computes the displaced target pixel for each point of the half pixel lattice within a band of rows
+#ifdef WIN32
+static DWORD WINAPI grid_thread_function( LPVOID obj )
+#else
+static void* grid_thread_function( void *obj )
+#endif
+{
+	grid_data *data = (grid_data *)obj;
+	int lattice_width = 2*data->width;
+	
+	for (int j=data->first_row;j<data->last_row;j++) {
+		float y = j*0.5f;
+		int *target = &data->target[j*lattice_width];
+		for (int i=0;i<lattice_width;i++) {
+			float x = i*0.5f;
+			
+			// get the displacement
+			GridPoint new_point =  data->grid->GetInterpolated(x/data->cell_width,y/data->cell_height);
+			
+			// apply the displacement
+			short dx = (short)floor(x+0.5f+new_point.x*data->cell_width);
+			short dy = (short)floor(y+0.5f+new_point.y*data->cell_height);
+			
+			if ((dx>=0) && (dx<data->width) && (dy>=0) && (dy<data->height)) target[i] = dy*data->width+dx;
+			else target[i] = -1;
+		}
+	}
+	
+	return(0);
+}
+
+static int getProcessorCount() {
+#ifdef WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	int count = (int)info.dwNumberOfProcessors;
+#else
+	int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (count<1) count = 1;
+	else if (count>16) count = 16;
+	return count;
+}
+
+// FNV-1a hash of the grid file contents and the frame dimensions
+static unsigned int getGridKey(const char *grid_file, int width, int height) {
+	
+	unsigned int hash = 2166136261u;
+	
+	FILE *file = fopen(grid_file,"rb");
+	if (file!=NULL) {
+		unsigned char buffer[1024];
+		size_t bytes;
+		while ((bytes = fread(buffer,1,sizeof(buffer),file))>0) {
+			for (size_t i=0;i<bytes;i++) {
+				hash ^= buffer[i];
+				hash *= 16777619u;
+			}
+		}
+		fclose(file);
+	}
+	
+	int dimension[2] = { width, height };
+	unsigned char *bytes = (unsigned char*)dimension;
+	for (size_t i=0;i<sizeof(dimension);i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	
+	return hash;
+}
+
+#define DMAP_CACHE_MAGIC 0x50414D44 // "DMAP"
+
+bool FiducialFinder::loadGridCache(const char *cache_file, unsigned int key) {
+	
+	FILE *file = fopen(cache_file,"rb");
+	if (file==NULL) return false;
+	
+	unsigned int header[4];
+	if ((fread(header,sizeof(unsigned int),4,file)!=4) || (header[0]!=DMAP_CACHE_MAGIC) || (header[1]!=key) || ((int)header[2]!=width) || ((int)header[3]!=height)) {
+		fclose(file);
+		return false;
+	}
+	
+	size_t size = (size_t)width*height;
+	bool success = (fread(dmap,sizeof(ShortPoint),size,file)==size);
+	fclose(file);
+	
+	return success;
+}
+
+void FiducialFinder::storeGridCache(const char *cache_file, unsigned int key) {
+	
+	FILE *file = fopen(cache_file,"wb");
+	if (file==NULL) return;
+	
+	unsigned int header[4] = { DMAP_CACHE_MAGIC, key, (unsigned int)width, (unsigned int)height };
+	size_t size = (size_t)width*height;
+	bool success = (fwrite(header,sizeof(unsigned int),4,file)==4) && (fwrite(dmap,sizeof(ShortPoint),size,file)==size);
+	fclose(file);
+	
+	if (!success) remove(cache_file);
+}
+
+int FiducialFinder::gridSizeX(int width, int height) {
+	
+	// wider frames get additional grid columns
+	int size_x = 7;
+	if (((float)width/height) > 1.3) size_x +=2;
+	if (((float)width/height) > 1.7) size_x +=2;
+	return size_x;
+}
+
+int FiducialFinder::gridSizeY(int /*width*/, int /*height*/) {
+	return 7;
+}
+
 void FiducialFinder::computeGrid() {
 	
 	// load the distortion grid
-	grid_size_x = 7;
-	if (((float)width/height) > 1.3) grid_size_x +=2;
-	if (((float)width/height) > 1.7) grid_size_x +=2;
-	grid_size_y = 7;
+	grid_size_x = gridSizeX(width,height);
+	grid_size_y = gridSizeY(width,height);
 	
 	cell_width = width/(grid_size_x-1);
 	cell_height = height/(grid_size_y-1);
 	
+	if (pixelwarp.coefficients==NULL) initialize_pixelwarp(&pixelwarp,width,height,grid_size_x,grid_size_y);
+	
 	CalibrationGrid grid(grid_size_x,grid_size_y);
 	grid.Load(grid_config);
 	
-	// we do not calculate the matrix if the grid is not configured
+	// we use the identity warp if the grid is not configured
 	if (grid.IsEmpty()) {
 		empty_grid = true;
-		for (int y=0;y<height;y++) {
-			for (int x=0;x<width;x++) {
-				dmap[y*width+x].x = x;
-				dmap[y*width+x].y = y;
-			}
-		}
+		set_pixelwarp_grid(&pixelwarp,NULL);
 		return;
 	} else empty_grid = false;
 	
+	std::vector<double> points(grid_size_x*grid_size_y*2);
+	for (int y=0;y<grid_size_y;y++) {
+		for (int x=0;x<grid_size_x;x++) {
+			GridPoint point = grid.Get(x,y);
+			points[(y*grid_size_x+x)*2] = point.x;
+			points[(y*grid_size_x+x)*2+1] = point.y;
+		}
+	}
+	set_pixelwarp_grid(&pixelwarp,&points[0]);
+}
+
+// the full resolution distortion map is only needed to display the grid
+void FiducialFinder::computeDistortionMap() {
+	
+	if (dmap==NULL) dmap = new ShortPoint[height*width];
+	
+	CalibrationGrid grid(grid_size_x,grid_size_y);
+	grid.Load(grid_config);
+	
+	// try the cached distortion matrix for this grid and resolution first
+	char cache_file[1024];
+	snprintf(cache_file,sizeof(cache_file),"%s.%dx%d.dmap",grid_config,width,height);
+	unsigned int key = getGridKey(grid_config,width,height);
+	if (loadGridCache(cache_file,key)) return;
+	
 	//ui->displayMessage("computing distortion matrix ...");
 	// reset the distortion matrix
 	for (int y=0;y<height;y++) {
@@ -68,47 +226,88 @@ void FiducialFinder::computeGrid() {
 		}
 	}
 	
-	// calculate the distortion matrix
-	for (float y=0;y<height;y+=0.5) {
-		for (float x=0;x<width;x+=0.5) {
-			
-			// get the displacement
-			GridPoint new_point =  grid.GetInterpolated(x/cell_width,y/cell_height);
-			
-			// apply the displacement
-			short dx = (short)floor(x+0.5f+new_point.x*cell_width);
-			short dy = (short)floor(y+0.5f+new_point.y*cell_height);
-			
-			int pixel =  dy*width+dx;
-			if ((dx>=0) && (dx<width) && (dy>=0) && (dy<height)) {
-				dmap[pixel].x = (short)x;
-				dmap[pixel].y = (short)y;
+	// calculate the displacement of the half pixel lattice in parallel bands
+	int lattice_width = 2*width;
+	int lattice_height = 2*height;
+	int *target = new int[lattice_width*lattice_height];
+	
+	int thread_count = getProcessorCount();
+	if (thread_count>lattice_height) thread_count = lattice_height;
+	grid_data gdata[16];
+#ifdef WIN32
+	HANDLE gthreads[16];
+#else
+	pthread_t gthreads[16];
+#endif
+	
+	int band = lattice_height/thread_count;
+	for (int i=0;i<thread_count;i++) {
+		gdata[i].grid = &grid;
+		gdata[i].target = target;
+		gdata[i].width = width;
+		gdata[i].height = height;
+		gdata[i].cell_width = cell_width;
+		gdata[i].cell_height = cell_height;
+		gdata[i].first_row = i*band;
+		gdata[i].last_row = (i==thread_count-1) ? lattice_height : (i+1)*band;
+	}
+	
+	for (int i=1;i<thread_count;i++) {
+#ifdef WIN32
+		DWORD threadId;
+		gthreads[i] = CreateThread( 0, 0, grid_thread_function, &gdata[i], 0, &threadId );
+#else
+		pthread_create(&gthreads[i] , NULL, grid_thread_function, &gdata[i]);
+#endif
+	}
+	grid_thread_function(&gdata[0]);
+	for (int i=1;i<thread_count;i++) {
+#ifdef WIN32
+		WaitForSingleObject(gthreads[i], INFINITE);
+		CloseHandle(gthreads[i]);
+#else
+		pthread_join(gthreads[i], NULL);
+#endif
+	}
+	
+	// apply the displacement in lattice order
+	for (int j=0;j<lattice_height;j++) {
+		for (int i=0;i<lattice_width;i++) {
+			int pixel = target[j*lattice_width+i];
+			if (pixel>=0) {
+				dmap[pixel].x = (short)(i*0.5f);
+				dmap[pixel].y = (short)(j*0.5f);
 			}
 		}
 	}
+	
+	delete[] target;
+	storeGridCache(cache_file,key);
 }
 
 bool FiducialFinder::toggleFlag(unsigned char flag, bool lock) {
 	
 	if ((flag==KEY_R) && (!calibration) && (!empty_grid)) {
 		if (!show_grid) {
+			computeDistortionMap();
 			show_grid = true;
 			prevMode = ui->getDisplayMode();
 			ui->setDisplayMode(DEST_DISPLAY);
 		} else {
 			show_grid = false;
 			ui->setDisplayMode(prevMode);
+			delete[] dmap;
+			dmap = NULL;
 		}
 	} else if (flag==KEY_C) {
 		if(!calibration) {
 			calibration=true;
-			show_grid=false;
-			for (int y=0;y<height;y++) {
-				for (int x=0;x<width;x++) {
-					dmap[y*width+x].x = x;
-					dmap[y*width+x].y = y;
-				}
+			if (show_grid) {
+				show_grid=false;
+				delete[] dmap;
+				dmap = NULL;
 			}
+			set_pixelwarp_grid(&pixelwarp,NULL);
 		}
 		else {
 			calibration = false;
@@ -218,6 +417,7 @@ void FiducialFinder::drawGrid(unsigned char *src, unsigned char *dest) {
 	
 	if (ui==NULL) return;
 	if (ui->getDisplayMode()==NO_DISPLAY) return;
+	if (dmap==NULL) return;
 	
 	int size = width*height-1;
 
@@ -31,6 +31,7 @@
 #include "TuioManager.h"
 
 #include "floatpoint.h"
+#include "pixelwarp.h"
 
 #ifdef __APPLE__
 #include <CoreFoundation/CFBundle.h>
@@ -70,10 +71,12 @@ public:
 		show_settings = false;
 
 		dmap = NULL;
+		pixelwarp.coefficients = NULL;
 	}
 	
 	~FiducialFinder() {
 		if (dmap) delete[] dmap;
+		terminate_pixelwarp(&pixelwarp);
 		//delete xposfil,yposfil,anglefil,widthfil,heightfil;
 	}
 	
@@ -81,6 +84,10 @@ public:
 	bool init(int w, int h, int sb ,int db);
 	bool toggleFlag(unsigned char flag, bool lock);
 	
+	// the calibration grid size for a frame of the given aspect ratio
+	static int gridSizeX(int width, int height);
+	static int gridSizeY(int width, int height);
+	
 protected:
 	int session_id;
 	long totalframes;
@@ -93,12 +100,16 @@ protected:
 #endif
 	
 	bool calibration, show_grid, empty_grid;
+	PixelWarp pixelwarp;
 	ShortPoint* dmap;
 	
 	void displayControl();
 	void drawObject(int id, float xpos, float ypos, int state);
 	void drawGrid(unsigned char *src, unsigned char *dest);
 	void computeGrid();
+	void computeDistortionMap();
+	bool loadGridCache(const char *cache_file, unsigned int key);
+	void storeGridCache(const char *cache_file, unsigned int key);
 	
 	TUIO::TuioManager *tuioManager;
 
@@ -19,6 +19,41 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "FrameThresholder.h"
 #include "VisionEngine.h"
 
+// averages the source pixels of each downscaled pixel, width and height are the downscaled dimensions
+static void downscale_frame(const unsigned char *src, unsigned char *dest, unsigned short *column_sum, int src_width, int bytes, int width, int height, int scale) {
+
+	int factor = 1 << scale;
+	int shift = 2*scale;
+	int columns = width << scale;
+	int row_size = src_width*bytes;
+
+	for (int y=0;y<height;y++) {
+
+		// the source rows are summed up first, then the columns of each pixel
+		memset(column_sum,0,columns*sizeof(unsigned short));
+		const unsigned char *row = src + (y<<scale)*row_size;
+		for (int j=0;j<factor;j++) {
+			if (bytes==1) for (int x=0;x<columns;x++) column_sum[x] += row[x];
+			else for (int x=0;x<columns;x++) column_sum[x] += row[x*bytes];
+			row += row_size;
+		}
+
+		unsigned short *column = column_sum;
+		for (int x=0;x<width;x++) {
+			int sum = 0;
+			for (int i=0;i<factor;i++) sum += *column++;
+			*dest++ = (unsigned char)(sum >> shift);
+		}
+	}
+}
+
+// applies the selected thresholder to a frame or a part of it, the integral thresholder averages a window of four tiles
+static void threshold_frame(threshold_data *data, unsigned char *dest, const unsigned char *src, int bytes, int width, int height) {
+
+	if (data->method==THRESHOLD_INTEGRAL) integral_threshold( data->integral, dest, src, bytes, width, height, 2*data->tile_size, data->gradient );
+	else tiled_bernsen_threshold( data->thresholder, dest, src, bytes, width, height, data->tile_size, data->gradient );
+}
+
 // the thread function
 #ifdef WIN32
 void usleep(long value) {
@@ -43,7 +78,10 @@ static void* threshold_thread_function( void *obj )
 			continue;
 		}
 #else
-		pthread_cond_wait(&data->cond, &data->mutex);
+		// the predicate avoids losing a job that was signalled before waiting
+		pthread_mutex_lock(&data->mutex);
+		while (!data->process && !data->done) pthread_cond_wait(&data->cond, &data->mutex);
+		pthread_mutex_unlock(&data->mutex);
 #endif
 		if (data->done) return(0);
 
@@ -59,8 +97,29 @@ static void* threshold_thread_function( void *obj )
 			}
 		}
 
+		// downscaler
+		if (data->scale>0) {
+			downscale_frame(data->src, data->level, data->column_sum, data->src_width, data->bytes, data->width, data->height, data->scale);
+			threshold_frame( data, data->dest, data->level, 1, data->width, data->height );
+			data->process = false;
+			continue;
+		}
+
 		// thresholder
-		tiled_bernsen_threshold( data->thresholder, data->dest, data->src,data->bytes, data->width, data->height, data->tile_size, data->gradient );
+		if (data->windows!=NULL) {
+			// each window is thresholded as a separate image
+			for (int w=0;w<data->window_count;w++) {
+				SegmenterWindow *window = &data->windows[w];
+				int window_width = window->right-window->left+1;
+				int window_height = window->bottom-window->top+1;
+
+				for (int y=0;y<window_height;y++)
+					memcpy(data->window_src+y*window_width*data->bytes, data->src+((window->top+y)*data->width+window->left)*data->bytes, window_width*data->bytes);
+				threshold_frame( data, data->window_dest, data->window_src, data->bytes, window_width, window_height );
+				for (int y=0;y<window_height;y++)
+					memcpy(data->dest+(window->top+y)*data->width+window->left, data->window_dest+y*window_width, window_width);
+			}
+		} else threshold_frame( data, data->dest, data->src, data->bytes, data->width, data->height );
 
 		data->process = false;
 	}
@@ -99,26 +158,33 @@ bool FrameThresholder::init(int w, int h, int sb, int db) {
 
 	if (initialized) {
 
-		for (int i=0;i<thread_count;i++) {
-			tdata[i].done = true;
-#ifdef WIN32
-			SetEvent(tdata[i].ghWriteEvent);
-#else
-			pthread_cond_signal(&tdata[i].cond);
-#endif
-			while(tdata[i].process) usleep(10);
+		for (int i=0;i<max_threads;i++) {
+			stopThread(i);
 
 			terminate_tiled_bernsen_thresholder( thresholder[i] );
 			delete thresholder[i];
+			terminate_integral_thresholder( integral[i] );
+			delete integral[i];
+			delete[] tdata[i].window_src;
+			delete[] tdata[i].window_dest;
 		}
 
 		delete[] tile_sizes;
 		delete[] thresholder;
+		delete[] integral;
 		delete[] pointmap;
+		delete[] window_grid;
+		freePyramid();
 	}
 
 	FrameProcessor::init(w,h,sb,db);
 
+	// a restarted tuning begins again from the configured values
+	if (tune && (tune_list.size()>0)) {
+		thread_count = max_threads;
+		tile_size = tune_list[0].tile_size;
+	}
+
 	short tw = w;
 	short th = h/thread_count;
 
@@ -130,6 +196,7 @@ bool FrameThresholder::init(int w, int h, int sb, int db) {
 		}
 		th = h/thread_count;
 	}
+	max_threads = thread_count;
 
 	short tw_div[8192];
 	short dw_count = getDividers(tw, tw_div);
@@ -170,12 +237,31 @@ bool FrameThresholder::init(int w, int h, int sb, int db) {
 	for (int i=0;i<tile_count;i++) printf("%d ",tile_sizes[i]);
 	printf("\n");*/
 
+	// the windows are combined from blocks of at least WINDOW_BLOCK pixels
+	window_grid = new unsigned char[(w/WINDOW_BLOCK+1)*(h/WINDOW_BLOCK+1)];
+	window_frame = false;
+	tracked_valid = false;
+	scan_count = 0;
+
+	// the auto tuning runs on the first frames with fewer threads than allocated
+	if (tune) initTuning();
+
+	// the window and tuning thresholders need to cover up to the full frame
+	bool pyramid = initPyramid();
+	if (pyramid || (scan_interval>0) || tune) th = h;
+
 	thresholder = new TiledBernsenThresholder*[thread_count];
 	for(int i=0;i<thread_count;i++) {
 		thresholder[i] = new TiledBernsenThresholder();
 		initialize_tiled_bernsen_thresholder(thresholder[i], tw, th, 2 );
 	}
 
+	integral = new IntegralThresholder*[thread_count];
+	for(int i=0;i<thread_count;i++) {
+		integral[i] = new IntegralThresholder();
+		initialize_integral_thresholder(integral[i], tw );
+	}
+
 	average = 0;
 	int size = width*height;
 	pointmap = new unsigned char[size];
@@ -187,8 +273,19 @@ bool FrameThresholder::init(int w, int h, int sb, int db) {
 		tdata[i].done=false;
 
 		tdata[i].thresholder=thresholder[i];
+		tdata[i].integral=integral[i];
+		tdata[i].method=method;
 		tdata[i].bytes=src_format;
 
+		tdata[i].scale=0;
+		tdata[i].src_width=w;
+		tdata[i].level=NULL;
+		tdata[i].windows=NULL;
+		tdata[i].window_count=0;
+		tdata[i].window_src=NULL;
+		tdata[i].window_dest=NULL;
+		tdata[i].window_size=0;
+
 		tdata[i].id=i;
 
 #ifdef WIN32
@@ -211,10 +308,346 @@ bool FrameThresholder::init(int w, int h, int sb, int db) {
 	return true;
 }
 
+void FrameThresholder::startThread(int i) {
+#ifdef WIN32
+	tdata[i].process = true;
+	SetEvent(tdata[i].ghWriteEvent);
+#else
+	pthread_mutex_lock(&tdata[i].mutex);
+	tdata[i].process = true;
+	pthread_cond_signal(&tdata[i].cond);
+	pthread_mutex_unlock(&tdata[i].mutex);
+#endif
+}
+
+void FrameThresholder::stopThread(int i) {
+#ifdef WIN32
+	tdata[i].done = true;
+	SetEvent(tdata[i].ghWriteEvent);
+#else
+	pthread_mutex_lock(&tdata[i].mutex);
+	tdata[i].done = true;
+	pthread_cond_signal(&tdata[i].cond);
+	pthread_mutex_unlock(&tdata[i].mutex);
+#endif
+	while(tdata[i].process) usleep(10);
+}
+
+bool FrameThresholder::initPyramid() {
+
+	level_src = NULL;
+	level_dest = NULL;
+	if (pyramid_level==0) return false;
+
+	level_width = width >> pyramid_level;
+	level_height = height >> pyramid_level;
+	if ((level_width<WINDOW_BLOCK) || (level_height<WINDOW_BLOCK)) {
+		printf("pyramid level %d is too small for %dx%d\n",pyramid_level,width,height);
+		return false;
+	}
+
+	level_src = new unsigned char[level_width*level_height];
+	level_dest = new unsigned char[level_width*level_height];
+	// each thread sums up the source columns of its downscaled rows
+	for (int i=0;i<max_threads;i++) tdata[i].column_sum = new unsigned short[level_width<<pyramid_level];
+	initialize_segmenter(&level_segmenter, level_width, level_height, PYRAMID_ADJACENCIES );
+	return true;
+}
+
+void FrameThresholder::freePyramid() {
+
+	if (level_src==NULL) return;
+
+	terminate_segmenter(&level_segmenter);
+	delete[] level_src;
+	delete[] level_dest;
+	for (int i=0;i<max_threads;i++) {
+		delete[] tdata[i].column_sum;
+		tdata[i].column_sum = NULL;
+	}
+	level_src = NULL;
+}
+
+bool FrameThresholder::getWindows(const SegmenterWindow **windows, int *count) {
+
+	if (!window_frame) return false;
+
+	*windows = window_list.empty() ? NULL : &window_list[0];
+	*count = (int)window_list.size();
+	return true;
+}
+
+void FrameThresholder::findCandidates(unsigned char *src) {
+
+	// the threads downscale and threshold a part of the pyramid level each
+	int level_tile = tile_size >> pyramid_level;
+	if (level_tile<2) level_tile = 2;
+	int part_height = level_height/thread_count;
+	for (int i=0;i<thread_count;i++) {
+
+		int offset = i*part_height*level_width;
+
+		tdata[i].src=src+((i*part_height)<<pyramid_level)*width*src_format;
+		tdata[i].level=level_src+offset;
+		tdata[i].dest=level_dest+offset;
+
+		tdata[i].width=level_width;
+		tdata[i].height=(i==thread_count-1) ? level_height-i*part_height : part_height;
+		tdata[i].scale=pyramid_level;
+
+		tdata[i].tile_size=level_tile;
+		tdata[i].gradient=gradient;
+		tdata[i].average = -1;
+		tdata[i].map = NULL;
+		tdata[i].windows = NULL;
+
+		startThread(i);
+	}
+
+	for (int i=0;i<thread_count;i++) {
+		while(tdata[i].process) usleep(10);
+		tdata[i].scale = 0;
+	}
+
+	step_segmenter(&level_segmenter, level_dest);
+
+	// mark the blocks around all candidate regions except the background
+	clearWindows();
+	int factor = 1 << pyramid_level;
+	int margin = 2*tile_size + factor;
+	Segmenter *segmenter = &level_segmenter;
+	for (int i=0;i<segmenter->region_count;i++) {
+		Region *region = LOOKUP_SEGMENTER_REGION(segmenter,i);
+		if (region->flags & FREE_REGION_FLAG) continue;
+		if ((region->flags & ADJACENT_TO_ROOT_REGION_FLAG) && (((region->right-region->left+1) > level_width/2) || ((region->bottom-region->top+1) > level_height/2))) continue;
+
+		markWindow(region->left*factor - margin, region->top*factor - margin, (region->right+1)*factor - 1 + margin, (region->bottom+1)*factor - 1 + margin);
+	}
+	combineWindows();
+}
+
+void FrameThresholder::setTrackedWindows(const std::vector<SegmenterWindow> &windows, bool lost) {
+
+	tracked_list = windows;
+	tracked_lost = lost;
+	tracked_valid = true;
+}
+
+void FrameThresholder::clearWindows() {
+
+	// the block grid is aligned to the tiles, the last row and column take the remaining pixels
+	window_block = tile_size*((WINDOW_BLOCK+tile_size-1)/tile_size);
+	grid_width = width/window_block;
+	grid_height = height/window_block;
+	if (grid_width<1) grid_width = 1;
+	if (grid_height<1) grid_height = 1;
+	memset(window_grid,0,grid_width*grid_height);
+}
+
+void FrameThresholder::markWindow(int left, int top, int right, int bottom) {
+
+	if ((right<0) || (bottom<0) || (left>=width) || (top>=height)) return;
+
+	int bx0 = left<0 ? 0 : left/window_block;
+	int by0 = top<0 ? 0 : top/window_block;
+	int bx1 = right/window_block; if (bx1>=grid_width) bx1 = grid_width-1;
+	int by1 = bottom/window_block; if (by1>=grid_height) by1 = grid_height-1;
+	if (bx0>bx1) bx0 = bx1;
+	if (by0>by1) by0 = by1;
+	for (int by=by0;by<=by1;by++) memset(window_grid+by*grid_width+bx0,1,bx1-bx0+1);
+}
+
+void FrameThresholder::combineWindows() {
+
+	// the bounding boxes of connected blocks are merged until no windows overlap
+	std::vector<SegmenterWindow> boxes;
+	std::vector<int> stack;
+	for (int b=0;b<grid_width*grid_height;b++) {
+		if (window_grid[b]!=1) continue;
+
+		SegmenterWindow box = { b%grid_width, b/grid_width, b%grid_width, b/grid_width };
+		window_grid[b] = 2;
+		stack.push_back(b);
+		while (!stack.empty()) {
+			int c = stack.back();
+			stack.pop_back();
+			int bx = c%grid_width;
+			int by = c/grid_width;
+			if (bx<box.left) box.left = bx;
+			if (bx>box.right) box.right = bx;
+			if (by<box.top) box.top = by;
+			if (by>box.bottom) box.bottom = by;
+
+			if ((bx>0) && (window_grid[c-1]==1)) { window_grid[c-1] = 2; stack.push_back(c-1); }
+			if ((bx<grid_width-1) && (window_grid[c+1]==1)) { window_grid[c+1] = 2; stack.push_back(c+1); }
+			if ((by>0) && (window_grid[c-grid_width]==1)) { window_grid[c-grid_width] = 2; stack.push_back(c-grid_width); }
+			if ((by<grid_height-1) && (window_grid[c+grid_width]==1)) { window_grid[c+grid_width] = 2; stack.push_back(c+grid_width); }
+		}
+		boxes.push_back(box);
+	}
+
+	bool merged = true;
+	while (merged) {
+		merged = false;
+		for (unsigned int i=0;i<boxes.size();i++) {
+			for (unsigned int j=i+1;j<boxes.size();j++) {
+				if ((boxes[j].left>boxes[i].right) || (boxes[j].right<boxes[i].left) || (boxes[j].top>boxes[i].bottom) || (boxes[j].bottom<boxes[i].top)) continue;
+				if (boxes[j].left<boxes[i].left) boxes[i].left = boxes[j].left;
+				if (boxes[j].right>boxes[i].right) boxes[i].right = boxes[j].right;
+				if (boxes[j].top<boxes[i].top) boxes[i].top = boxes[j].top;
+				if (boxes[j].bottom>boxes[i].bottom) boxes[i].bottom = boxes[j].bottom;
+				boxes.erase(boxes.begin()+j);
+				merged = true;
+				j = i;
+			}
+		}
+	}
+
+	window_list.clear();
+	for (unsigned int i=0;i<boxes.size();i++) {
+		SegmenterWindow window;
+		window.left = boxes[i].left*window_block;
+		window.top = boxes[i].top*window_block;
+		window.right = (boxes[i].right==grid_width-1) ? width-1 : (boxes[i].right+1)*window_block-1;
+		window.bottom = (boxes[i].bottom==grid_height-1) ? height-1 : (boxes[i].bottom+1)*window_block-1;
+		window_list.push_back(window);
+	}
+}
+
+void FrameThresholder::thresholdWindows(unsigned char *src, unsigned char *dest) {
+
+	// the pixels outside of the windows are left black
+	memset(dest,BLACK,width*height);
+
+	int total_area = 0;
+	for (unsigned int w=0;w<window_list.size();w++) {
+		SegmenterWindow *window = &window_list[w];
+		total_area += (window->right-window->left+1)*(window->bottom-window->top+1);
+	}
+
+	// the windows are distributed to the threads in chunks of a similar area
+	int first = 0;
+	int area = 0;
+	for (int i=0;i<thread_count;i++) {
+
+		int last = first;
+		int max_size = 0;
+		int chunk_area = (int)((long long)total_area*(i+1)/thread_count);
+		while ((last<(int)window_list.size()) && ((area<chunk_area) || (i==thread_count-1))) {
+			SegmenterWindow *window = &window_list[last];
+			int size = (window->right-window->left+1)*(window->bottom-window->top+1);
+			if (size>max_size) max_size = size;
+			area += size;
+			last++;
+		}
+
+		if (max_size>tdata[i].window_size) {
+			delete[] tdata[i].window_src;
+			delete[] tdata[i].window_dest;
+			tdata[i].window_src = new unsigned char[max_size*src_format];
+			tdata[i].window_dest = new unsigned char[max_size];
+			tdata[i].window_size = max_size;
+		}
+
+		tdata[i].src=src;
+		tdata[i].dest=dest;
+		tdata[i].width=width;
+		tdata[i].height=height;
+		tdata[i].windows = (last>first) ? &window_list[first] : NULL;
+		tdata[i].window_count = last-first;
+		tdata[i].tile_size=tile_size;
+		tdata[i].gradient=gradient;
+		tdata[i].average = -1;
+		tdata[i].map = NULL;
+		first = last;
+
+		if (tdata[i].windows==NULL) continue;
+		startThread(i);
+	}
+
+	for (int i=0;i<thread_count;i++) {
+		while(tdata[i].process) usleep(10);
+	}
+}
+
+// the candidates are all thread counts up to the allocated threads which divide the frame into even bands,
+// combined with the configured tile size and its closest tile sizes within a factor of 1.5
+void FrameThresholder::initTuning() {
+
+	std::vector<int> thread_list;
+	for (int n=1;n<=max_threads;n++) {
+		if ((height%n!=0) || ((height/n)%2!=0)) continue;
+		if ((n&(n-1))==0 || n==max_threads) thread_list.push_back(n);
+	}
+
+	std::vector<int> tile_list;
+	tile_list.push_back(tile_size);
+	if (method==THRESHOLD_BERNSEN) {
+		int smaller = 0;
+		int larger = 0;
+		for (int i=0;i<tile_count;i++) {
+			if ((tile_sizes[i]<tile_size) && (3*tile_sizes[i]>=2*tile_size)) smaller = tile_sizes[i];
+			if ((tile_sizes[i]>tile_size) && (2*tile_sizes[i]<=3*tile_size) && (larger==0)) larger = tile_sizes[i];
+		}
+		if (smaller>0) tile_list.push_back(smaller);
+		if (larger>0) tile_list.push_back(larger);
+	}
+
+	tune_list.clear();
+	for (unsigned int i=0;i<thread_list.size();i++) {
+		for (unsigned int j=0;j<tile_list.size();j++) {
+			tune_candidate candidate;
+			candidate.threads = thread_list[i];
+			candidate.tile_size = tile_list[j];
+			candidate.time = 0;
+			tune_list.push_back(candidate);
+		}
+	}
+
+	tune_index = 0;
+	tune_frame = 0;
+	if (tune_list.size()<2) tune = false;
+}
+
+void FrameThresholder::tuneFrame(unsigned long start_time) {
+
+	// the first frame of each candidate is not measured, since its threads and caches are not settled yet
+	if (tune_frame>0) tune_list[tune_index].time += VisionEngine::currentMicroSeconds() - start_time;
+	tune_frame++;
+	if (tune_frame<=TUNE_FRAMES) return;
+
+	tune_frame = 0;
+	tune_index++;
+	if (tune_index<(int)tune_list.size()) return;
+
+	int best = 0;
+	for (unsigned int i=0;i<tune_list.size();i++) {
+		if (tune_list[i].time<tune_list[best].time) best = i;
+	}
+
+	thread_count = tune_list[best].threads;
+	tile_size = tune_list[best].tile_size;
+	for (int i=0;i<tile_count;i++) {
+		if (tile_sizes[i]==tile_size) tile_index = i;
+	}
+	tune = false;
+
+	printf("auto tuning selected %d threads and tile size %d (%.2fms)\n",thread_count,tile_size,tune_list[best].time/(TUNE_FRAMES*1000.0f));
+}
+
 void FrameThresholder::process(unsigned char *src, unsigned char *dest) {
 
+	frame_start = TUIO::TuioTime::getSystemTime();
 	//unsigned long start_time = VisionEngine::currentMicroSeconds();
 
+	// the auto tuning applies the next candidate configuration and measures its processing time
+	unsigned long tune_time = 0;
+	if (tune) {
+		thread_count = tune_list[tune_index].threads;
+		tile_size = tune_list[tune_index].tile_size;
+		tune_time = VisionEngine::currentMicroSeconds();
+	}
+
 	if (calibrate) {
 
 		unsigned int sum = 0;
@@ -231,6 +664,27 @@ void FrameThresholder::process(unsigned char *src, unsigned char *dest) {
 		equalize = true;
 	}
 
+	// the tracking mode only thresholds the windows around the tracked components until the next full scan
+	bool track_frame = (scan_interval>0) && tracked_valid && !tracked_lost && (scan_count+1<scan_interval) && !equalize && !tune;
+	tracked_valid = false;
+	if (track_frame) {
+		scan_count++;
+		clearWindows();
+		for (unsigned int i=0;i<tracked_list.size();i++)
+			markWindow(tracked_list[i].left,tracked_list[i].top,tracked_list[i].right,tracked_list[i].bottom);
+		combineWindows();
+	} else scan_count = 0;
+
+	// the pyramid mode thresholds the full frame only around the candidates of the pyramid level
+	window_frame = track_frame || ((level_src!=NULL) && !equalize);
+	if (window_frame) {
+		if (!track_frame) findCandidates(src);
+		thresholdWindows(src,dest);
+		if (tune) tuneFrame(tune_time);
+		if (setGradient || setTilesize) displayControl();
+		return;
+	}
+
 	for (int i=0;i<thread_count;i++) {
 
 		int part_height = height/thread_count;
@@ -253,19 +707,16 @@ void FrameThresholder::process(unsigned char *src, unsigned char *dest) {
 			tdata[i].average = -1;
 			tdata[i].map = NULL;
 		}
+		tdata[i].windows = NULL;
 
-		tdata[i].process = true;
-#ifdef WIN32
-		SetEvent(tdata[i].ghWriteEvent);
-#else
-		pthread_cond_signal(&tdata[i].cond);
-#endif
+		startThread(i);
 	}
 
 	for (int i=0;i<thread_count;i++) {
 		while(tdata[i].process) usleep(10);
 	}
 
+	if (tune) tuneFrame(tune_time);
 	if (setGradient || setTilesize) displayControl();
 
 	//float frm_latency = (VisionEngine::currentMicroSeconds() - start_time)/1000.0f;
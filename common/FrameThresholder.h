@@ -26,8 +26,22 @@
 #include <unistd.h>
 #endif
 
+#include <vector>
 #include "FrameProcessor.h"
 #include "tiled_bernsen_threshold.h"
+#include "integral_threshold.h"
+#include "segment.h"
+#include "TuioTime.h"
+
+#define THRESHOLD_BERNSEN 0
+#define THRESHOLD_INTEGRAL 1
+
+// the block size in pixels used to combine the candidates into windows
+#define WINDOW_BLOCK 32
+// the maximum number of adjacent regions of the pyramid level segmenter
+#define PYRAMID_ADJACENCIES 16
+// the number of frames measured for each configuration during the auto tuning
+#define TUNE_FRAMES 8
 
 #ifdef WIN32
 void usleep(long value);
@@ -42,6 +56,8 @@ typedef struct threshold_data {
 	pthread_mutex_t mutex;
 #endif
 	TiledBernsenThresholder *thresholder;
+	IntegralThresholder *integral;
+	int method;
 	unsigned char *src;
 	unsigned char *dest;
 	int width,height;
@@ -50,14 +66,29 @@ typedef struct threshold_data {
 	int gradient;
 	unsigned char *map;
 	int average;
+	int scale;
+	int src_width;
+	unsigned char *level;
+	unsigned short *column_sum;
+	SegmenterWindow *windows;
+	int window_count;
+	unsigned char *window_src;
+	unsigned char *window_dest;
+	int window_size;
 	bool done;
 	int id;
 } threshold_data;
 
+typedef struct tune_candidate {
+	int threads;
+	int tile_size;
+	unsigned long time;
+} tune_candidate;
+
 class FrameThresholder: public FrameProcessor
 {
 public:
-	FrameThresholder(short g, int s, int t) {
+	FrameThresholder(short g, int s, int t, int p=0, int i=0, int m=THRESHOLD_BERNSEN, bool a=false) {
 		initialized = false;
 		
 		gradient = g;
@@ -72,6 +103,25 @@ public:
 		thread_count = t;
 		if (thread_count<1) thread_count = 1;
 		else if (thread_count>16) thread_count = 16;
+		max_threads = thread_count;
+		
+		pyramid_level = p;
+		if (pyramid_level<0) pyramid_level = 0;
+		else if (pyramid_level>3) pyramid_level = 3;
+		window_frame = false;
+		
+		method = m;
+		if (method!=THRESHOLD_INTEGRAL) method = THRESHOLD_BERNSEN;
+		
+		scan_interval = i;
+		if (scan_interval<0) scan_interval = 0;
+		tracked_valid = false;
+		tracked_lost = false;
+		scan_count = 0;
+		
+		tune = a;
+		tune_index = 0;
+		tune_frame = 0;
 		
 		equalize = false;
 		calibrate = false;
@@ -82,21 +132,22 @@ public:
 	~FrameThresholder() {
 		if (initialized) {
 			
-			for (int i=0;i<thread_count;i++) {
-				tdata[i].done = true;
-#ifdef WIN32
-				SetEvent(tdata[i].ghWriteEvent);
-#else
-				pthread_cond_signal(&tdata[i].cond);
-#endif
-				while(tdata[i].process) usleep(10);
+			for (int i=0;i<max_threads;i++) {
+				stopThread(i);
 				terminate_tiled_bernsen_thresholder( thresholder[i] );
 				delete thresholder[i];
+				terminate_integral_thresholder( integral[i] );
+				delete integral[i];
+				delete[] tdata[i].window_src;
+				delete[] tdata[i].window_dest;
 			}
 
 			delete[] tile_sizes;
 			delete[] thresholder;
+			delete[] integral;
 			delete[] pointmap;
+			delete[] window_grid;
+			freePyramid();
 		}
 	};
 
@@ -110,9 +161,36 @@ public:
 	int getGradientGate() { return gradient; };
 	int getTileSize() { return tile_size; };
 	bool getEqualizerState() { return equalize; };
+	int getPyramidLevel() { return pyramid_level; };
+	int getScanInterval() { return scan_interval; };
+	int getThresholdMethod() { return method; };
+	int getThreadCount() { return thread_count; };
+	bool getTuningState() { return tune; };
+	// the system time at which the processing of the current frame started
+	TUIO::TuioTime getFrameStartTime() { return frame_start; };
+	
+	// provides the windows of the last frame if only these were thresholded
+	bool getWindows(const SegmenterWindow **windows, int *count);
+	// the windows around the tracked components, which are searched in the next frame unless a track was lost
+	void setTrackedWindows(const std::vector<SegmenterWindow> &windows, bool lost);
 	
 private:
+	void startThread(int i);
+	void stopThread(int i);
+	bool initPyramid();
+	void freePyramid();
+	void findCandidates(unsigned char *src);
+	void clearWindows();
+	void markWindow(int left, int top, int right, int bottom);
+	void combineWindows();
+	void thresholdWindows(unsigned char *src, unsigned char *dest);
+	void initTuning();
+	void tuneFrame(unsigned long start_time);
+	
+
 	TiledBernsenThresholder **thresholder;
+	IntegralThresholder **integral;
+	int method;
 	short gradient;
 	bool setGradient;
 	short tile_size;
@@ -121,6 +199,7 @@ private:
 	short tile_index;
 	bool setTilesize;
 	int thread_count;
+	int max_threads;
 
 	unsigned char *pointmap;
 	int average;
@@ -129,6 +208,29 @@ private:
 	
 	float min_latency, max_latency;
 	
+	int pyramid_level;
+	int level_width, level_height;
+	unsigned char *level_src;
+	unsigned char *level_dest;
+	Segmenter level_segmenter;
+	unsigned char *window_grid;
+	int window_block;
+	int grid_width, grid_height;
+	std::vector<SegmenterWindow> window_list;
+	bool window_frame;
+	
+	int scan_interval;
+	int scan_count;
+	std::vector<SegmenterWindow> tracked_list;
+	bool tracked_lost;
+	bool tracked_valid;
+	
+	bool tune;
+	TUIO::TuioTime frame_start;
+	int tune_index;
+	int tune_frame;
+	std::vector<tune_candidate> tune_list;
+	
 #ifdef WIN32
 	HANDLE tthreads[16];
 #else
@@ -0,0 +1,119 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "LatencyProbe.h"
+#include "UdpSource.h"
+#include "TcpSource.h"
+#include "WebSockSource.h"
+#include "SceneCamera.h"
+#include <algorithm>
+
+LatencyProbe::LatencyProbe(int type, int port, TUIO::TuioManager *manager) {
+
+	// the probe receives the output of this tracker, which therefore needs to be sent to the local host
+	switch (type) {
+		case TUIO_UDP: receiver_ = new TUIO::UdpSource(port); break;
+		case TUIO_TCP_HOST: receiver_ = new TUIO::TcpSource("localhost",port); break;
+		case TUIO_WEB: receiver_ = new TUIO::WebSockSource("localhost",port); break;
+		default:
+			std::cout << "the latency probe only supports udp, tcp host and web outputs" << std::endl;
+			throw std::exception();
+	}
+	receiver_->setPacketListener(this);
+	manager_ = manager;
+	last_probe_ = -1;
+
+#ifdef WIN32
+	sampleMutex = CreateMutex(NULL,FALSE,NULL);
+#else
+	pthread_mutex_init(&sampleMutex,NULL);
+#endif
+}
+
+LatencyProbe::~LatencyProbe() {
+	receiver_->disconnect();
+	delete receiver_;
+
+#ifdef WIN32
+	CloseHandle(sampleMutex);
+#else
+	pthread_mutex_destroy(&sampleMutex);
+#endif
+}
+
+bool LatencyProbe::connect() {
+	return receiver_->connect();
+}
+
+void LatencyProbe::lockSamples() {
+#ifdef WIN32
+	WaitForSingleObject(sampleMutex, INFINITE);
+#else
+	pthread_mutex_lock(&sampleMutex);
+#endif
+}
+
+void LatencyProbe::unlockSamples() {
+#ifdef WIN32
+	ReleaseMutex(sampleMutex);
+#else
+	pthread_mutex_unlock(&sampleMutex);
+#endif
+}
+
+void LatencyProbe::ProcessMessage(const osc::ReceivedMessage& message, const IpEndpointName& /*remoteEndpoint*/) {
+
+	long long arrival_time = SceneCamera::getProbeClock();
+	if (strcmp(message.AddressPattern(), "/tuio/2Dobj")!=0) return;
+
+	osc::ReceivedMessageArgumentStream args = message.ArgumentStream();
+	const char *cmd;
+	args >> cmd;
+	if (strcmp(cmd, "set")!=0) return;
+
+	osc::int32 session_id, symbol_id;
+	float xpos, ypos, angle;
+	args >> session_id >> symbol_id >> xpos >> ypos >> angle;
+	if (manager_->getInvertAngle()) angle = 2.0f*(float)M_PI - angle;
+
+	// only the first message showing a new probe orientation belongs to a new frame
+	long long probe_time = SceneCamera::getProbeTime(symbol_id, angle);
+	if ((probe_time<0) || (probe_time==last_probe_)) return;
+	last_probe_ = probe_time;
+
+	lockSamples();
+	samples_.push_back((long)(arrival_time-probe_time));
+	unlockSamples();
+}
+
+void LatencyProbe::report() {
+
+	lockSamples();
+	std::vector<long> samples = samples_;
+	unlockSamples();
+
+	if (samples.size()==0) {
+		std::cout << receiver_->tuio_type() << " latency: no probe frames received" << std::endl;
+		return;
+	}
+
+	std::sort(samples.begin(),samples.end());
+	size_t last = samples.size()-1;
+	printf("%s latency: %d frames, median %.2fms, 90%% %.2fms, 99%% %.2fms, max %.2fms\n",receiver_->tuio_type(),(int)samples.size(),
+		samples[last/2]/1000.0f,samples[last*90/100]/1000.0f,samples[last*99/100]/1000.0f,samples[last]/1000.0f);
+}
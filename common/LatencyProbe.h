@@ -0,0 +1,62 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LATENCYPROBE_H
+#define LATENCYPROBE_H
+
+#include <vector>
+#include "Main.h"
+#include "OscSource.h"
+#include "TuioManager.h"
+#include "osc/OscPacketListener.h"
+
+#ifndef WIN32
+#include <pthread.h>
+#endif
+
+// receives the TUIO output of this tracker through a local receiver and measures the delay from the delivery
+// of each probe frame of the scene camera to the arrival of the first TUIO message reporting its probe orientation
+class LatencyProbe: public osc::OscPacketListener
+{
+public:
+	LatencyProbe(int type, int port, TUIO::TuioManager *manager);
+	~LatencyProbe();
+
+	bool connect();
+	void report();
+
+protected:
+	void ProcessMessage(const osc::ReceivedMessage& message, const IpEndpointName& remoteEndpoint);
+
+private:
+	void lockSamples();
+	void unlockSamples();
+
+	TUIO::OscSource *receiver_;
+	TUIO::TuioManager *manager_;
+	std::vector<long> samples_;
+	long long last_probe_;
+
+#ifdef WIN32
+	HANDLE sampleMutex;
+#else
+	pthread_mutex_t sampleMutex;
+#endif
+};
+
+#endif
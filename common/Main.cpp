@@ -34,15 +34,26 @@
 #include "FrameThresholder.h"
 #include "FidtrackFinder.h"
 #include "CalibrationEngine.h"
+#include "CameraPipeline.h"
+#include "CameraMerger.h"
+#include "TuioAggregator.h"
+#include "ReplayClock.h"
+#include "LatencyProbe.h"
+#include "Benchmark.h"
+#include "SelfTest.h"
 
 #include "TuioServer.h"
+#include "TuioSharedMemory.h"
+#include "TuioLogger.h"
 
 VisionEngine *engine;
+TuioAggregator *aggregator = NULL;
 using namespace tinyxml2;
 
 static void terminate (int param)
 {
 	if (engine!=NULL) engine->stop();
+	if (aggregator!=NULL) aggregator->stop();
 }
 
 void printUsage(const char* app_name) {
@@ -50,10 +61,21 @@ void printUsage(const char* app_name) {
 	std::cout << "the default configuration file is " << app_name << ".xml" << std::endl;
 	std::cout << "\t -n starts " << app_name << " without GUI" << std::endl;
 	std::cout << "\t -l lists all available cameras" << std::endl;
+	std::cout << "\t -b [result_file] runs the benchmarks and writes their results" << std::endl;
+	std::cout << "\t -t runs the self tests" << std::endl;
 	std::cout << "\t -h shows this help message" << std::endl;
 	std::cout << std::endl;
 }
 
+void readSurfaceRegion(tinyxml2::XMLElement* element, float *x, float *y, float *width, float *height, float *angle) {
+	// the region of the normalized surface covered by a camera or source, the angle is given in degrees
+	if(element->Attribute("x")!=NULL) *x = (float)atof(element->Attribute("x"));
+	if(element->Attribute("y")!=NULL) *y = (float)atof(element->Attribute("y"));
+	if(element->Attribute("width")!=NULL) *width = (float)atof(element->Attribute("width"));
+	if(element->Attribute("height")!=NULL) *height = (float)atof(element->Attribute("height"));
+	if(element->Attribute("angle")!=NULL) *angle = (float)atof(element->Attribute("angle"));
+}
+
 void readSettings(application_settings *config) {
 
 	config->tuio_count=1;
@@ -61,6 +83,14 @@ void readSettings(application_settings *config) {
 	config->tuio_port[0] = 3333;
 	config->tuio_host[0] = "localhost";
 	sprintf(config->tuio_source,"rtv");
+	config->tuio_queue = 32;
+	config->tuio_delta = 0.0f;
+	config->tuio_keyframe = 1;
+	config->tuio_shm[0] = '\0';
+	config->tuio_predict = false;
+	config->tuio_predict_obj = 0.0f;
+	config->tuio_predict_cur = 0.0f;
+	config->tuio_predict_blb = 0.0f;
 
 	for (int i=1;i<32;i++) {
 		config->tuio_type[i] = -1;
@@ -71,6 +101,37 @@ void readSettings(application_settings *config) {
 	sprintf(config->tree_config,"default");
 	sprintf(config->grid_config,"none");
 	sprintf(config->camera_config,"default");
+	config->camera_count = 1;
+	config->merge_distance = 0.02f;
+	for (int i=0;i<MAX_CAMERAS;i++) {
+		sprintf(config->cameras[i].camera_config,"default");
+		sprintf(config->cameras[i].grid_config,"none");
+		config->cameras[i].x = 0.0f;
+		config->cameras[i].y = 0.0f;
+		config->cameras[i].width = 1.0f;
+		config->cameras[i].height = 1.0f;
+		config->cameras[i].angle = 0.0f;
+		config->cameras[i].thread_count = 1;
+		config->cameras[i].cpu = -1;
+	}
+	config->source_count = 0;
+	config->aggregator_fps = 60;
+	config->aggregator_timeout = 0.0f;
+	config->replay_frames = 0;
+	config->replay_fps = 30.0f;
+	sprintf(config->replay_log,"replay.log");
+	config->replay_golden[0] = '\0';
+	config->latency_probe = false;
+	for (int i=0;i<MAX_SOURCES;i++) {
+		config->sources[i].type = TUIO_UDP;
+		config->sources[i].port = 3333;
+		sprintf(config->sources[i].host,"localhost");
+		config->sources[i].x = 0.0f;
+		config->sources[i].y = 0.0f;
+		config->sources[i].width = 1.0f;
+		config->sources[i].height = 1.0f;
+		config->sources[i].angle = 0.0f;
+	}
 	config->invert_x = false;
 	config->invert_y = false;
 	config->invert_a = false;
@@ -92,6 +153,11 @@ void readSettings(application_settings *config) {
 	config->gradient_gate = 32;
 	config->tile_size = 10;
 	config->thread_count = 1;
+	config->pyramid_level = 0;
+	config->scan_interval = 0;
+	config->threshold_method = THRESHOLD_BERNSEN;
+	config->auto_tune = false;
+	config->save_tune = false;
 	config->display_mode = 2;
 	
 	if (strcmp( config->file, "none" ) == 0) {
@@ -143,6 +209,18 @@ void readSettings(application_settings *config) {
 			tcount++;
 		} else if(tuio_element->Attribute("source")!=NULL) {
 			sprintf(config->tuio_source,"%s",tuio_element->Attribute("source"));
+		} else if(tuio_element->Attribute("queue")!=NULL) {
+			config->tuio_queue = atoi(tuio_element->Attribute("queue"));
+		} else if(tuio_element->Attribute("delta")!=NULL) {
+			config->tuio_delta = (float)atof(tuio_element->Attribute("delta"));
+			if(tuio_element->Attribute("keyframe")!=NULL) config->tuio_keyframe = atoi(tuio_element->Attribute("keyframe"));
+		} else if(tuio_element->Attribute("shm")!=NULL) {
+			snprintf(config->tuio_shm,sizeof(config->tuio_shm),"%s",tuio_element->Attribute("shm"));
+		} else if(tuio_element->Attribute("predict")!=NULL) {
+			if ((strcmp( tuio_element->Attribute("predict"), "true" ) == 0) || atoi(tuio_element->Attribute("predict"))==1) config->tuio_predict = true;
+			if(tuio_element->Attribute("fiducial")!=NULL) config->tuio_predict_obj = (float)atof(tuio_element->Attribute("fiducial"))/1000.0f;
+			if(tuio_element->Attribute("finger")!=NULL) config->tuio_predict_cur = (float)atof(tuio_element->Attribute("finger"))/1000.0f;
+			if(tuio_element->Attribute("blob")!=NULL) config->tuio_predict_blb = (float)atof(tuio_element->Attribute("blob"))/1000.0f;
 		}
 
 		tuio_element = tuio_element->NextSiblingElement("tuio");
@@ -163,6 +241,18 @@ void readSettings(application_settings *config) {
 				if (tcount==32) break;
 			} else if(tuio_element->Attribute("source")!=NULL) {
 				sprintf(config->tuio_source,"%s",tuio_element->Attribute("source"));
+			} else if(tuio_element->Attribute("queue")!=NULL) {
+				config->tuio_queue = atoi(tuio_element->Attribute("queue"));
+			} else if(tuio_element->Attribute("delta")!=NULL) {
+				config->tuio_delta = (float)atof(tuio_element->Attribute("delta"));
+				if(tuio_element->Attribute("keyframe")!=NULL) config->tuio_keyframe = atoi(tuio_element->Attribute("keyframe"));
+			} else if(tuio_element->Attribute("shm")!=NULL) {
+				snprintf(config->tuio_shm,sizeof(config->tuio_shm),"%s",tuio_element->Attribute("shm"));
+			} else if(tuio_element->Attribute("predict")!=NULL) {
+				if ((strcmp( tuio_element->Attribute("predict"), "true" ) == 0) || atoi(tuio_element->Attribute("predict"))==1) config->tuio_predict = true;
+				if(tuio_element->Attribute("fiducial")!=NULL) config->tuio_predict_obj = (float)atof(tuio_element->Attribute("fiducial"))/1000.0f;
+				if(tuio_element->Attribute("finger")!=NULL) config->tuio_predict_cur = (float)atof(tuio_element->Attribute("finger"))/1000.0f;
+				if(tuio_element->Attribute("blob")!=NULL) config->tuio_predict_blb = (float)atof(tuio_element->Attribute("blob"))/1000.0f;
 			}
 
 			tuio_element = tuio_element->NextSiblingElement("tuio");
@@ -174,6 +264,70 @@ void readSettings(application_settings *config) {
 	if( camera_element!=NULL )
 	{
 		if(camera_element->Attribute("config")!=NULL) sprintf(config->camera_config,"%s",camera_element->Attribute("config"));
+		if(camera_element->Attribute("merge")!=NULL) config->merge_distance = (float)atof(camera_element->Attribute("merge"));
+		readSurfaceRegion(camera_element, &config->cameras[0].x, &config->cameras[0].y, &config->cameras[0].width, &config->cameras[0].height, &config->cameras[0].angle);
+
+		// any further camera elements define additional cameras of the same surface
+		camera_element = camera_element->NextSiblingElement("camera");
+		while ((camera_element!=NULL) && (config->camera_count<MAX_CAMERAS)) {
+			camera_settings *camera = &config->cameras[config->camera_count];
+			if(camera_element->Attribute("config")!=NULL) sprintf(camera->camera_config,"%s",camera_element->Attribute("config"));
+			if(camera_element->Attribute("grid")!=NULL) sprintf(camera->grid_config,"%s",camera_element->Attribute("grid"));
+			if(camera_element->Attribute("threads")!=NULL) {
+				camera->thread_count = atoi(camera_element->Attribute("threads"));
+				if(camera->thread_count<1) camera->thread_count = 1;
+				if(camera->thread_count>SDL_GetCPUCount()) camera->thread_count = SDL_GetCPUCount();
+			}
+			if(camera_element->Attribute("cpu")!=NULL) camera->cpu = atoi(camera_element->Attribute("cpu"));
+			readSurfaceRegion(camera_element, &camera->x, &camera->y, &camera->width, &camera->height, &camera->angle);
+			config->camera_count++;
+			camera_element = camera_element->NextSiblingElement("camera");
+		}
+	}
+
+	tinyxml2::XMLElement* aggregator_element = config_root.FirstChildElement("aggregator").ToElement();
+	if( aggregator_element!=NULL )
+	{
+		if(aggregator_element->Attribute("fps")!=NULL) {
+			config->aggregator_fps = atoi(aggregator_element->Attribute("fps"));
+			if(config->aggregator_fps<1) config->aggregator_fps = 1;
+		}
+		if(aggregator_element->Attribute("merge")!=NULL) config->merge_distance = (float)atof(aggregator_element->Attribute("merge"));
+		if(aggregator_element->Attribute("timeout")!=NULL) config->aggregator_timeout = (float)atof(aggregator_element->Attribute("timeout"));
+
+		tinyxml2::XMLElement* source_element = aggregator_element->FirstChildElement("source");
+		while ((source_element!=NULL) && (config->source_count<MAX_SOURCES)) {
+			source_settings *source = &config->sources[config->source_count];
+			if(source_element->Attribute("type")!=NULL) {
+				if ( strcmp( source_element->Attribute("type"), "udp" ) == 0 ) source->type = TUIO_UDP;
+				else if ( strcmp( source_element->Attribute("type"), "tcp" ) == 0 ) source->type = TUIO_TCP_CLIENT;
+				else {
+					std::cout << "unsupported TUIO source type " << source_element->Attribute("type") << std::endl;
+					source_element = source_element->NextSiblingElement("source");
+					continue;
+				}
+			}
+			if(source_element->Attribute("host")!=NULL) sprintf(source->host,"%s",source_element->Attribute("host"));
+			if(source_element->Attribute("port")!=NULL) source->port = atoi(source_element->Attribute("port"));
+			readSurfaceRegion(source_element, &source->x, &source->y, &source->width, &source->height, &source->angle);
+			config->source_count++;
+			source_element = source_element->NextSiblingElement("source");
+		}
+	}
+
+	tinyxml2::XMLElement* replay_element = config_root.FirstChildElement("replay").ToElement();
+	if( replay_element!=NULL )
+	{
+		if(replay_element->Attribute("frames")!=NULL) config->replay_frames = atol(replay_element->Attribute("frames"));
+		if(replay_element->Attribute("fps")!=NULL) config->replay_fps = (float)atof(replay_element->Attribute("fps"));
+		if(replay_element->Attribute("log")!=NULL) sprintf(config->replay_log,"%s",replay_element->Attribute("log"));
+		if(replay_element->Attribute("golden")!=NULL) sprintf(config->replay_golden,"%s",replay_element->Attribute("golden"));
+	}
+
+	tinyxml2::XMLElement* probe_element = config_root.FirstChildElement("probe").ToElement();
+	if( probe_element!=NULL )
+	{
+		if(probe_element->Attribute("latency")!=NULL) config->latency_probe = (strcmp(probe_element->Attribute("latency"),"true")==0);
 	}
 
 	tinyxml2::XMLElement* finger_element = config_root.FirstChildElement("finger").ToElement();
@@ -226,6 +380,30 @@ void readSettings(application_settings *config) {
 				if(config->thread_count>SDL_GetCPUCount()) config->thread_count =  SDL_GetCPUCount();
 			}
 		}
+
+		if(threshold_element->Attribute("pyramid")!=NULL) {
+			config->pyramid_level = atoi(threshold_element->Attribute("pyramid"));
+			if(config->pyramid_level<0) config->pyramid_level = 0;
+			if(config->pyramid_level>3) config->pyramid_level = 3;
+		}
+
+		if(threshold_element->Attribute("scan")!=NULL) {
+			config->scan_interval = atoi(threshold_element->Attribute("scan"));
+			if(config->scan_interval<0) config->scan_interval = 0;
+		}
+
+		if(threshold_element->Attribute("method")!=NULL) {
+			if (strcmp(threshold_element->Attribute("method"), "integral" ) == 0) config->threshold_method = THRESHOLD_INTEGRAL;
+			else config->threshold_method = THRESHOLD_BERNSEN;
+		}
+
+		if(threshold_element->Attribute("tune")!=NULL) {
+			if (strcmp(threshold_element->Attribute("tune"), "true" ) == 0) config->auto_tune = true;
+			else if (strcmp(threshold_element->Attribute("tune"), "save" ) == 0) {
+				config->auto_tune = true;
+				config->save_tune = true;
+			}
+		}
 	}
 
 	tinyxml2::XMLElement* fiducial_element = config_root.FirstChildElement("fiducial").ToElement();
@@ -378,10 +556,16 @@ void writeSettings(application_settings *config) {
 			sprintf(config_value,"%d",config->gradient_gate);
 			threshold_element->SetAttribute("gradient",config_value);
 		}
-		if(threshold_element->Attribute("tile")!=NULL) {
+		if((threshold_element->Attribute("tile")!=NULL) || config->save_tune) {
 			sprintf(config_value,"%d",config->tile_size);
 			threshold_element->SetAttribute("tile",config_value);
 		}
+		// the tuned configuration is used directly from the next start
+		if (config->save_tune) {
+			sprintf(config_value,"%d",config->thread_count);
+			threshold_element->SetAttribute("threads",config_value);
+			threshold_element->SetAttribute("tune","false");
+		}
 	}
 	
 	tinyxml2::XMLElement* fiducial_element = config_root.FirstChildElement("fiducial").ToElement();
@@ -416,6 +600,45 @@ void writeSettings(application_settings *config) {
 
 }
 
+TuioServer* createServer(application_settings *config) {
+
+	// all UDP targets share a single socket, so the sender list is completed before the server is created
+	std::vector<OscSender*> senderList;
+	UdpFanoutSender *udp_sender = NULL;
+	for (int i=0;i<config->tuio_count;i++) {
+		OscSender *sender = NULL;
+		try { switch (config->tuio_type[i]) {
+			case TUIO_UDP:
+				if (udp_sender) { udp_sender->addTarget(config->tuio_host[i].c_str(),config->tuio_port[i]); continue; }
+				sender = udp_sender = new UdpFanoutSender(config->tuio_host[i].c_str(),config->tuio_port[i]); break;
+			case TUIO_TCP_CLIENT: sender = new TcpSender(config->tuio_host[i].c_str(),config->tuio_port[i]); break;
+			case TUIO_TCP_HOST: sender = new TcpSender(config->tuio_port[i]); break;
+			case TUIO_WEB: sender = new WebSockSender(config->tuio_port[i]); break;
+			case TUIO_FLASH: sender = new FlashSender(); break;
+			default: continue;
+		} } catch (std::exception e) {}
+
+		if (sender) {
+			senderList.push_back(sender);
+			pv_sleep(1);
+		}
+	}
+
+	TuioServer *server = NULL;
+	for (unsigned int i=0;i<senderList.size();i++) {
+		if(i==0) server = new TuioServer(senderList[i]);
+		else server->addOscSender(senderList[i]);
+	}
+	server->setSourceName(config->tuio_source);
+	if (config->tuio_queue>0) server->enableOutputThread(config->tuio_queue);
+	if (config->tuio_delta>0) server->enableDeltaUpdates(config->tuio_delta, config->tuio_keyframe);
+	if (config->tuio_predict) server->enablePrediction(config->tuio_predict_obj, config->tuio_predict_cur, config->tuio_predict_blb);
+	// none of the outputs uses the motion paths of the TUIO components
+	server->enablePathHistory(false);
+
+	return server;
+}
+
 int main(int argc, char* argv[]) {
 
 	application_settings config;
@@ -443,6 +666,14 @@ int main(int argc, char* argv[]) {
 		} else if( strcmp( argv[1], "-l" ) == 0 ) {
 			CameraTool::listDevices();
 			return 0;
+		} else if( strcmp( argv[1], "-b" ) == 0 ) {
+			Benchmark benchmark;
+			if (benchmark.run(argc==3 ? argv[2] : NULL)) return 0;
+			else return 1;
+		} else if( strcmp( argv[1], "-t" ) == 0 ) {
+			SelfTest selftest;
+			if (selftest.run()) return 0;
+			else return 1;
 		} else if ( (std::string(argv[1]).find("-NSDocumentRevisionsDebugMode")==0 ) || (std::string(argv[1]).find("-psn_")==0) ){
 			// ignore mac specific arguments
 		} else {
@@ -460,6 +691,47 @@ int main(int argc, char* argv[]) {
 	readSettings(&config);
 	config.headless = headless;
 
+	// the replay mode fixes the TUIO time before the server is created and logs all TUIO events
+	ReplayClock *replayclock = NULL;
+	if ((config.replay_frames>0) && (config.source_count==0)) replayclock = new ReplayClock(config.replay_fps);
+
+	TuioServer *server = createServer(&config);
+
+	TuioLogger *logger = NULL;
+	if (replayclock) {
+		try { logger = new TuioLogger(server, config.replay_log); }
+		catch (std::exception e) { logger = NULL; }
+	}
+
+	// the aggregator mode merges the TUIO streams of other trackers without using a camera
+	if (config.source_count>0) {
+		aggregator = new TuioAggregator(server, &config);
+		aggregator->run();
+		delete aggregator;
+		aggregator = NULL;
+
+		if (server->getDroppedPackets()>0) std::cout << "dropped " << server->getDroppedPackets() << " TUIO packets" << std::endl;
+		delete server;
+		return 0;
+	}
+	server->setInversion(config.invert_x, config.invert_y, config.invert_a);
+
+	// the latency probes receive the TUIO outputs of the probe frames rendered by the scene camera
+	std::vector<LatencyProbe*> probeList;
+	if (config.latency_probe) {
+		for (int i=0;i<config.tuio_count;i++) {
+			try { probeList.push_back(new LatencyProbe(config.tuio_type[i], config.tuio_port[i], server)); }
+			catch (std::exception e) { continue; }
+			probeList.back()->connect();
+		}
+	}
+
+	// the additional cameras copy their configuration before the main camera is configured
+	std::vector<CameraPipeline*> pipelineList;
+	for (int i=1;i<config.camera_count;i++) {
+		pipelineList.push_back(new CameraPipeline(&config, &config.cameras[i]));
+	}
+
 	engine = new VisionEngine(app_name,&config);
 
 	if (!headless) {
@@ -472,37 +744,43 @@ int main(int argc, char* argv[]) {
 		engine->setInterface(uiface);
 	}
 
-	TuioServer *server = NULL;
 	FrameProcessor *fiducialfinder	= NULL;
 	FrameProcessor *thresholder	= NULL;
 	FrameProcessor *calibrator	= NULL;
 
-	for (int i=0;i<config.tuio_count;i++) {
-		OscSender *sender = NULL;
-		try { switch (config.tuio_type[i]) {
-			case TUIO_UDP: sender = new UdpSender(config.tuio_host[i].c_str(),config.tuio_port[i]); break;
-			case TUIO_TCP_CLIENT: sender = new TcpSender(config.tuio_host[i].c_str(),config.tuio_port[i]); break;
-			case TUIO_TCP_HOST: sender = new TcpSender(config.tuio_port[i]); break;
-			case TUIO_WEB: sender = new WebSockSender(config.tuio_port[i]); break;
-			case TUIO_FLASH: sender = new FlashSender(); break;
-			default: continue;
-		} } catch (std::exception e) {}
 
-		if (sender) {
-			if(i==0) server = new TuioServer(sender);
-			else server->addOscSender(sender);
-			pv_sleep(1);
-		}
+	TuioSharedMemory *shm = NULL;
+	if (config.tuio_shm[0]!='\0') {
+		try { shm = new TuioSharedMemory(server, config.tuio_shm); }
+		catch (std::exception e) { shm = NULL; }
 	}
-	server->setSourceName(config.tuio_source);
-	server->setInversion(config.invert_x, config.invert_y, config.invert_a);
 
-	thresholder = new FrameThresholder(config.gradient_gate, config.tile_size, config.thread_count);
+	if (replayclock) {
+		engine->addFrameProcessor(replayclock);
+		engine->setFrameLimit(config.replay_frames);
+	}
+
+	thresholder = new FrameThresholder(config.gradient_gate, config.tile_size, config.thread_count, config.pyramid_level, config.scan_interval, config.threshold_method, config.auto_tune);
 	if (config.background) thresholder->toggleFlag(KEY_SPACE,false);
 	engine->addFrameProcessor(thresholder);
 
-	fiducialfinder = new FidtrackFinder(server, &config);
+	// with several cameras the main camera tracks into its own manager, which is merged with the other pipelines
+	TuioManager *manager = server;
+	CameraMerger *merger = NULL;
+	if (config.camera_count>1) {
+		manager = new TuioManager();
+		manager->enablePathHistory(false);
+		manager->setInversion(config.invert_x, config.invert_y, config.invert_a);
+		merger = new CameraMerger(server, manager, &config);
+		for (unsigned int i=0;i<pipelineList.size();i++) {
+			if (pipelineList[i]->start()) merger->addPipeline(pipelineList[i]);
+		}
+	}
+
+	fiducialfinder = new FidtrackFinder(manager, &config);
+	((FidtrackFinder*)fiducialfinder)->setThresholder((FrameThresholder*)thresholder);
 	engine->addFrameProcessor(fiducialfinder);
+	if (merger) engine->addFrameProcessor(merger);
 
 	calibrator = new CalibrationEngine(config.grid_config);
 	engine->addFrameProcessor(calibrator);
@@ -520,22 +798,64 @@ int main(int argc, char* argv[]) {
 	config.yamaarashi = ((FidtrackFinder*)fiducialfinder)->getYamaarashi();
 	config.yama_flip = ((FidtrackFinder*)fiducialfinder)->getYamaFlip();
 
+	for (unsigned int i=0;i<pipelineList.size();i++) {
+		pipelineList[i]->stop();
+	}
+
+	if (merger) {
+		engine->removeFrameProcessor(merger);
+		delete merger;
+	}
+
 	engine->removeFrameProcessor(fiducialfinder);
 	delete fiducialfinder;
 
 	config.gradient_gate = ((FrameThresholder*)thresholder)->getGradientGate();
-	config.tile_size = ((FrameThresholder*)thresholder)->getTileSize();
+	// an unfinished auto tuning keeps the configured values
+	if (((FrameThresholder*)thresholder)->getTuningState()) config.save_tune = false;
+	else {
+		config.tile_size = ((FrameThresholder*)thresholder)->getTileSize();
+		if (config.auto_tune) config.thread_count = ((FrameThresholder*)thresholder)->getThreadCount();
+	}
 	config.background = ((FrameThresholder*)thresholder)->getEqualizerState();
 	engine->removeFrameProcessor(thresholder);
 	delete thresholder;
 
-	config.invert_x = server->getInvertXpos();
-	config.invert_y = server->getInvertYpos();
-	config.invert_a = server->getInvertAngle();
+	config.invert_x = manager->getInvertXpos();
+	config.invert_y = manager->getInvertYpos();
+	config.invert_a = manager->getInvertAngle();
+	if (manager!=server) delete manager;
+	for (unsigned int i=0;i<pipelineList.size();i++) {
+		delete pipelineList[i];
+	}
+	if (server->getDroppedPackets()>0) std::cout << "dropped " << server->getDroppedPackets() << " TUIO packets" << std::endl;
+
+	for (unsigned int i=0;i<probeList.size();i++) {
+		probeList[i]->report();
+		delete probeList[i];
+	}
+
+	int result = 0;
+	if (replayclock) {
+		engine->removeFrameProcessor(replayclock);
+		delete replayclock;
+	}
+	if (logger) {
+		std::cout << "logged " << logger->getFrameCount() << " frames to " << config.replay_log << std::endl;
+		delete logger;
+
+		if (config.replay_golden[0]!='\0') {
+			int differences = TuioLogger::compareLogs(config.replay_golden, config.replay_log);
+			if (differences==0) std::cout << "TUIO log matches " << config.replay_golden << std::endl;
+			else if (differences>0) std::cout << "TUIO log differs from " << config.replay_golden << " in " << differences << " frames" << std::endl;
+			if (differences!=0) result = 1;
+		}
+	}
 
 	delete engine;
+	if (shm) delete shm;
 	delete server;
 
 	writeSettings(&config);
-	return 0;
+	return result;
 }
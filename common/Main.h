@@ -22,16 +22,59 @@
 
 enum TuioType { TUIO_UDP,TUIO_TCP_CLIENT,TUIO_TCP_HOST,TUIO_WEB,TUIO_FLASH };
 
+#define MAX_CAMERAS 8
+
+struct camera_settings {
+	char camera_config[1024];
+	char grid_config[1024];
+	float x, y;
+	float width, height;
+	float angle;
+	int thread_count;
+	int cpu;
+};
+
+#define MAX_SOURCES 32
+
+struct source_settings {
+	int type;
+	int port;
+	char host[256];
+	float x, y;
+	float width, height;
+	float angle;
+};
+
 struct application_settings {
 	char file[1024];
 	int tuio_count;
 	int tuio_type[32];
 	int tuio_port[32];
 	char tuio_source[1024];
+	int tuio_queue;
+	float tuio_delta;
+	int tuio_keyframe;
+	char tuio_shm[256];
+	bool tuio_predict;
+	float tuio_predict_obj;
+	float tuio_predict_cur;
+	float tuio_predict_blb;
 	std::string tuio_host[32];
 	char tree_config[1024];
 	char grid_config[1024];
 	char camera_config[1024];
+	int camera_count;
+	camera_settings cameras[MAX_CAMERAS];
+	float merge_distance;
+	int source_count;
+	source_settings sources[MAX_SOURCES];
+	int aggregator_fps;
+	float aggregator_timeout;
+	long replay_frames;
+	float replay_fps;
+	char replay_log[1024];
+	char replay_golden[1024];
+	bool latency_probe;
 	bool invert_x;
 	bool invert_y;
 	bool invert_a;
@@ -53,6 +96,11 @@ struct application_settings {
 	int gradient_gate;
     int tile_size;
     int thread_count;
+	int pyramid_level;
+	int scan_interval;
+	int threshold_method;
+	bool auto_tune;
+	bool save_tune;
 	int display_mode;
 };
 
@@ -0,0 +1,38 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ReplayClock.h"
+
+ReplayClock::ReplayClock(float fps) {
+
+	if (fps<=0) fps = 30.0f;
+	frame_interval_ = (long)(USEC_SECOND/fps);
+	frame_count_ = 0;
+	TUIO::TuioTime::setFixedTime(TUIO::TuioTime(0,0));
+}
+
+ReplayClock::~ReplayClock() {
+	TUIO::TuioTime::releaseFixedTime();
+}
+
+void ReplayClock::process(unsigned char * /*src*/, unsigned char * /*dest*/) {
+
+	frame_count_++;
+	long frame_time = frame_count_*frame_interval_;
+	TUIO::TuioTime::setFixedTime(TUIO::TuioTime(frame_time/USEC_SECOND,frame_time%USEC_SECOND));
+}
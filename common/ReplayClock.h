@@ -0,0 +1,40 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REPLAYCLOCK_H
+#define REPLAYCLOCK_H
+
+#include "FrameProcessor.h"
+#include "TuioTime.h"
+
+// replaces the system time with a fixed TUIO time, which advances by one frame interval before each frame
+// it is added before all other processors, so a replayed frame sequence always produces the same timestamps
+class ReplayClock: public FrameProcessor
+{
+public:
+	ReplayClock(float fps);
+	~ReplayClock();
+
+	void process(unsigned char *src, unsigned char *dest);
+
+private:
+	long frame_interval_;
+	long frame_count_;
+};
+
+#endif
@@ -0,0 +1,313 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SelfTest.h"
+#include "TuioServer.h"
+#include "TuioFrameReader.h"
+#include "TuioMerger.h"
+#include "UdpSender.h"
+#include "OscMessageTemplate.h"
+#include "integral_threshold.h"
+#include "FrameThresholder.h"
+#include "FidtrackFinder.h"
+#include "CameraTool.h"
+#include <vector>
+#include <string.h>
+
+// the packets are passed to the listener directly, which are usually delivered by the receiver thread
+class LoopbackSource: public TUIO::OscSource
+{
+public:
+	bool connect() { return true; };
+	void disconnect() {};
+	bool isConnected() { return true; };
+	const char* tuio_type() { return "TUIO/NONE"; };
+
+	void deliver(const char *data, unsigned int size) { if (listener) listener->ProcessPacket(data,size,IpEndpointName()); };
+};
+
+// delivers the TUIO packets to the loopback source and counts them
+class LoopbackSender: public TUIO::OscSender
+{
+public:
+	LoopbackSender(LoopbackSource *source): packets(0), source(source) {
+		local = true;
+		buffer_size = MAX_UDP_SIZE;
+	};
+
+	bool sendOscData(const char *data, unsigned int size) {
+		source->deliver(data,size);
+		packets++;
+		return true;
+	};
+	bool isConnected() { return true; };
+	const char* tuio_type() { return "TUIO/NONE"; };
+
+	int packets;
+
+private:
+	LoopbackSource *source;
+};
+
+SelfTest::SelfTest() {
+	failures = 0;
+}
+
+bool SelfTest::run() {
+
+	checkSplitFrame();
+	checkMessageTemplates();
+	checkMergedBlobs();
+	checkIntegralBorder();
+	checkHeadlessPipeline();
+
+	if (failures>0) printf("%d self tests failed\n",failures);
+	else printf("all self tests passed\n");
+	return (failures==0);
+}
+
+// a frame exceeding the bundle size is delivered in several bundles with the same frame sequence,
+// which all need to be accepted by the receiving side
+void SelfTest::checkSplitFrame() {
+
+	LoopbackSource *source = new LoopbackSource();
+	TUIO::TuioFrameReader *reader = new TUIO::TuioFrameReader(source);
+	LoopbackSender *sender = new LoopbackSender(source);
+	TUIO::TuioServer *server = new TUIO::TuioServer(sender);
+	reader->connect();
+
+	std::vector<TUIO::TuioObject*> objectList;
+	server->initFrame(TUIO::TuioTime::getSessionTime());
+	for (int i=0;i<SELFTEST_OBJECTS;i++)
+		objectList.push_back(server->addTuioObject(i,(i%10)/10.0f,(i/10)/10.0f,0.0f));
+	sender->packets = 0;
+	server->commitFrame();
+	bool split = (sender->packets>1);
+
+	std::vector<tuio_shm_object> objects;
+	std::vector<tuio_shm_cursor> cursors;
+	std::vector<tuio_shm_blob> blobs;
+	reader->getFrame(objects,cursors,blobs);
+	bool complete = split && (objects.size()==SELFTEST_OBJECTS);
+
+	// the following frame moves all objects, so every split bundle carries updates
+	server->initFrame(TUIO::TuioTime::getSessionTime()+20000L);
+	for (int i=0;i<SELFTEST_OBJECTS;i++)
+		server->updateTuioObject(objectList[i],(i%10)/10.0f+0.05f,(i/10)/10.0f+0.05f,0.0f);
+	server->commitFrame();
+
+	reader->getFrame(objects,cursors,blobs);
+	bool updated = split && (objects.size()==SELFTEST_OBJECTS);
+	for (unsigned int i=0;i<objects.size();i++) {
+		float x = (objects[i].symbol_id%10)/10.0f+0.05f;
+		if ((objects[i].x<x-0.001f) || (objects[i].x>x+0.001f)) updated = false;
+	}
+
+	delete server;
+	delete reader;
+	delete source;
+
+	report("TuioFrameReader split frame",complete);
+	report("TuioFrameReader split frame update",updated);
+}
+
+// composes the same set message from a template and argument by argument, with arbitrary values of both signs
+static bool compareTemplate(const char *address, const char *types) {
+
+	char templateBuffer[MAX_TEMPLATE_SIZE*2];
+	char streamBuffer[MAX_TEMPLATE_SIZE*2];
+	osc::OutboundPacketStream templatePacket(templateBuffer,sizeof(templateBuffer));
+	osc::OutboundPacketStream streamPacket(streamBuffer,sizeof(streamBuffer));
+	TUIO::OscMessageTemplate messageTemplate(address,"set",types);
+
+	templatePacket << osc::BeginBundleImmediate;
+	streamPacket << osc::BeginBundleImmediate;
+	streamPacket << osc::BeginMessage(address) << "set";
+	for (int i=0;types[i]!=0;i++) {
+		int sign = (i%2) ? -1 : 1;
+		if (types[i]=='i') {
+			osc::int32 value = sign*(i+1)*123457;
+			messageTemplate.setInt32(i,value);
+			streamPacket << value;
+		} else {
+			float value = sign*(i+1)*0.1234567f;
+			messageTemplate.setFloat(i,value);
+			streamPacket << value;
+		}
+	}
+	streamPacket << osc::EndMessage << osc::EndBundle;
+	messageTemplate.appendTo(&templatePacket);
+	templatePacket << osc::EndBundle;
+
+	if (templatePacket.Size()!=streamPacket.Size()) return false;
+	return (memcmp(templatePacket.Data(),streamPacket.Data(),streamPacket.Size())==0);
+}
+
+// the preformatted set messages need to be byte identical to the messages composed argument by argument,
+// including a profile with the additional fields of the 2.5D objects
+void SelfTest::checkMessageTemplates() {
+
+	report("OscMessageTemplate 2Dobj",compareTemplate("/tuio/2Dobj","iiffffffff"));
+	report("OscMessageTemplate 2Dcur",compareTemplate("/tuio/2Dcur","ifffff"));
+	report("OscMessageTemplate 2Dblb",compareTemplate("/tuio/2Dblb","ifffffffffff"));
+	report("OscMessageTemplate 25Dobj",compareTemplate("/tuio/25Dobj","iiffffffffff"));
+}
+
+// a source blob with the session ID of a source object or cursor needs to keep this association after merging
+void SelfTest::checkMergedBlobs() {
+
+	TUIO::TuioManager *manager = new TUIO::TuioManager();
+	TUIO::TuioMerger *merger = new TUIO::TuioMerger(manager);
+	int left = merger->addSource(0.0f,0.0f,0.5f,1.0f);
+	int right = merger->addSource(0.5f,0.0f,0.5f,1.0f);
+
+	// each source reports an object and a cursor with their blobs, and a separate blob
+	std::vector<tuio_shm_object> objects(1);
+	std::vector<tuio_shm_cursor> cursors(1);
+	std::vector<tuio_shm_blob> blobs(3);
+	memset(&objects[0],0,sizeof(tuio_shm_object));
+	memset(&cursors[0],0,sizeof(tuio_shm_cursor));
+	memset(&blobs[0],0,3*sizeof(tuio_shm_blob));
+	objects[0].session_id = blobs[0].session_id = 7;
+	objects[0].symbol_id = 3;
+	objects[0].x = blobs[0].x = 0.2f;
+	objects[0].y = blobs[0].y = 0.3f;
+	cursors[0].session_id = blobs[1].session_id = 8;
+	cursors[0].x = blobs[1].x = 0.6f;
+	cursors[0].y = blobs[1].y = 0.7f;
+	blobs[2].session_id = 9;
+	blobs[2].x = blobs[2].y = 0.9f;
+	for (int i=0;i<3;i++) blobs[i].width = blobs[i].height = blobs[i].area = 0.1f;
+
+	merger->updateSource(left,objects,cursors,blobs);
+	merger->updateSource(right,objects,cursors,blobs);
+	merger->commitFrame(TUIO::TuioTime::getSessionTime());
+
+	const std::list<TUIO::TuioObject*> &objectList = manager->getTuioObjectList();
+	const std::list<TUIO::TuioCursor*> &cursorList = manager->getTuioCursorList();
+	const std::list<TUIO::TuioBlob*> &blobList = manager->getTuioBlobList();
+	int linked = 0;
+	for (std::list<TUIO::TuioBlob*>::const_iterator tblb=blobList.begin(); tblb!=blobList.end(); tblb++) {
+		long session_id = (*tblb)->getSessionID();
+		for (std::list<TUIO::TuioObject*>::const_iterator tobj=objectList.begin(); tobj!=objectList.end(); tobj++)
+			if ((*tobj)->getSessionID()==session_id) linked++;
+		for (std::list<TUIO::TuioCursor*>::const_iterator tcur=cursorList.begin(); tcur!=cursorList.end(); tcur++)
+			if ((*tcur)->getSessionID()==session_id) linked++;
+	}
+	bool passed = (objectList.size()==2) && (cursorList.size()==2) && (blobList.size()==6) && (linked==4);
+
+	delete merger;
+	delete manager;
+
+	report("TuioMerger linked blobs",passed);
+}
+
+// a pattern with the same contrast everywhere needs to be thresholded the same within the cropped windows along the border,
+// the third value of the pattern is close to the window mean and is compared with the mid gray level
+void SelfTest::checkIntegralBorder() {
+
+	static const unsigned char pattern[4] = { 100, 156, 156, 128 };
+	static const unsigned char expected[4] = { 0, 255, 255, 255 };
+
+	unsigned char *src = new unsigned char[SELFTEST_WIDTH*SELFTEST_HEIGHT];
+	unsigned char *dest = new unsigned char[SELFTEST_WIDTH*SELFTEST_HEIGHT];
+	for (int y=0;y<SELFTEST_HEIGHT;y++) {
+		for (int x=0;x<SELFTEST_WIDTH;x++) src[y*SELFTEST_WIDTH+x] = pattern[(y%2)*2+(x%2)];
+	}
+
+	IntegralThresholder thresholder;
+	initialize_integral_thresholder(&thresholder,SELFTEST_WIDTH);
+	integral_threshold(&thresholder,dest,src,1,SELFTEST_WIDTH,SELFTEST_HEIGHT,10,40);
+	terminate_integral_thresholder(&thresholder);
+
+	bool passed = true;
+	for (int y=0;y<SELFTEST_HEIGHT;y++) {
+		for (int x=0;x<SELFTEST_WIDTH;x++) {
+			if (dest[y*SELFTEST_WIDTH+x]!=expected[(y%2)*2+(x%2)]) passed = false;
+		}
+	}
+
+	delete[] src;
+	delete[] dest;
+
+	report("integral_threshold border",passed);
+}
+
+// fills a rotated ellipse with the given gray value
+static void fillEllipse(unsigned char *buffer, float cx, float cy, float width, float height, float angle, unsigned char value) {
+
+	float ca = cosf(angle);
+	float sa = sinf(angle);
+	for (int y=0;y<SELFTEST_FRAME_HEIGHT;y++) {
+		for (int x=0;x<SELFTEST_FRAME_WIDTH;x++) {
+			float dx = ((x-cx)*ca + (y-cy)*sa)/(width/2.0f);
+			float dy = ((y-cy)*ca - (x-cx)*sa)/(height/2.0f);
+			if (dx*dx+dy*dy<=1.0f) buffer[y*SELFTEST_FRAME_WIDTH+x] = value;
+		}
+	}
+}
+
+// the finders of the secondary camera pipelines have no user interface attached,
+// so a frame with a finger and a plain blob needs to be processed without any drawing
+void SelfTest::checkHeadlessPipeline() {
+
+	application_settings config;
+	memset(&config,0,sizeof(application_settings));
+	sprintf(config.tree_config,"default");
+	sprintf(config.grid_config,"none");
+	config.finger_size = 16;
+	config.finger_sensitivity = 75;
+	config.max_blob_size = 64;
+	config.min_blob_size = 32;
+	config.max_fid = 299;
+
+	unsigned char *src = new unsigned char[SELFTEST_FRAME_WIDTH*SELFTEST_FRAME_HEIGHT];
+	unsigned char *dest = new unsigned char[SELFTEST_FRAME_WIDTH*SELFTEST_FRAME_HEIGHT];
+	memset(src,48,SELFTEST_FRAME_WIDTH*SELFTEST_FRAME_HEIGHT);
+	fillEllipse(src,40.3f,60.7f,16.0f,12.0f,0.5f,208);
+	fillEllipse(src,110.0f,60.0f,48.0f,24.0f,0.5f,208);
+
+	TUIO::TuioManager *manager = new TUIO::TuioManager();
+	FrameThresholder *thresholder = new FrameThresholder(32,10,1);
+	FidtrackFinder *finder = new FidtrackFinder(manager,&config);
+	finder->setThresholder(thresholder);
+
+	bool passed = thresholder->init(SELFTEST_FRAME_WIDTH,SELFTEST_FRAME_HEIGHT,1,1) && finder->init(SELFTEST_FRAME_WIDTH,SELFTEST_FRAME_HEIGHT,1,1);
+	if (passed) {
+		// the frames are spaced like camera frames, since the motion of the tracked components is derived from the frame times
+		for (int i=0;i<3;i++) {
+			thresholder->process(src,dest);
+			finder->process(src,dest);
+			pv_sleep(SELFTEST_FRAME_DELAY);
+		}
+		passed = (manager->getTuioObjectList().size()==0) && (manager->getTuioCursorList().size()==1) && (manager->getTuioBlobList().size()==1);
+	}
+
+	delete finder;
+	delete thresholder;
+	delete manager;
+	delete[] src;
+	delete[] dest;
+
+	report("FidtrackFinder headless pipeline",passed);
+}
+
+void SelfTest::report(const char *check, bool passed) {
+	printf("%s\t%s\n",passed?"ok":"FAIL",check);
+	if (!passed) failures++;
+}
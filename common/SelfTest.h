@@ -0,0 +1,52 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SELFTEST_H
+#define SELFTEST_H
+
+#include <stdio.h>
+
+#define SELFTEST_OBJECTS 100
+#define SELFTEST_WIDTH 64
+#define SELFTEST_HEIGHT 48
+#define SELFTEST_FRAME_WIDTH 160
+#define SELFTEST_FRAME_HEIGHT 120
+#define SELFTEST_FRAME_DELAY 10
+
+// runs functional checks of the TUIO and image processing kernels without any camera or network,
+// each check is reported on its own line and the run fails if any of the checks has failed
+class SelfTest
+{
+public:
+	SelfTest();
+
+	bool run();
+
+private:
+	void checkSplitFrame();
+	void checkMessageTemplates();
+	void checkMergedBlobs();
+	void checkIntegralBorder();
+	void checkHeadlessPipeline();
+
+	void report(const char *check, bool passed);
+
+	int failures;
+};
+
+#endif
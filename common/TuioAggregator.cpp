@@ -0,0 +1,89 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TuioAggregator.h"
+#include "CameraTool.h"
+
+TuioAggregator::TuioAggregator(TUIO::TuioServer *server, application_settings *config)
+: running_( false )
+, server_( server )
+{
+	merger_ = new TUIO::TuioMerger(server_, config->merge_distance);
+	merger_->setSourceTimeout(config->aggregator_timeout);
+	frame_interval_ = 1000000/config->aggregator_fps;
+
+	for (int i=0;i<config->source_count;i++) {
+		source_settings *source = &config->sources[i];
+
+		TUIO::OscSource *receiver = NULL;
+		try { switch (source->type) {
+			case TUIO_UDP: receiver = new TUIO::UdpSource(source->port); break;
+			case TUIO_TCP_CLIENT: receiver = new TUIO::TcpSource(source->host,source->port); break;
+			default: continue;
+		} } catch (std::exception e) { continue; }
+
+		TUIO::TuioFrameReader *client = new TUIO::TuioFrameReader(receiver);
+		receiverList.push_back(receiver);
+		clientList.push_back(client);
+		sourceList.push_back(merger_->addSource(source->x, source->y, source->width, source->height, source->angle*(float)M_PI/180.0f));
+	}
+}
+
+TuioAggregator::~TuioAggregator() {
+
+	for (unsigned int i=0;i<clientList.size();i++) {
+		delete clientList[i];
+		delete receiverList[i];
+	}
+	delete merger_;
+}
+
+void TuioAggregator::run() {
+
+	if (clientList.size()==0) {
+		printf("no TUIO sources available\n");
+		return;
+	}
+
+	for (unsigned int i=0;i<clientList.size();i++) {
+		clientList[i]->connect();
+	}
+
+	running_ = true;
+	TUIO::TuioTime frameTime = TUIO::TuioTime::getSystemTime();
+	while (running_) {
+
+		for (unsigned int i=0;i<clientList.size();i++) {
+			// the components of a lost TCP connection are removed immediately
+			if (!clientList[i]->isConnected()) clientList[i]->reset();
+			if (clientList[i]->getFrame(objects_, cursors_, blobs_)) merger_->updateSource(sourceList[i], objects_, cursors_, blobs_);
+		}
+		merger_->commitFrame(TUIO::TuioTime::getSystemTime());
+
+		// the merged frames are published at a fixed rate independent of the source frame rates
+		frameTime = frameTime + frame_interval_;
+		TUIO::TuioTime currentTime = TUIO::TuioTime::getSystemTime();
+		long frame_delay = (frameTime.getSeconds()-currentTime.getSeconds())*1000000 + (frameTime.getMicroseconds()-currentTime.getMicroseconds());
+		if (frame_delay>=1000) pv_sleep((int)(frame_delay/1000));
+		else if (frame_delay<0) frameTime = currentTime;
+	}
+
+	for (unsigned int i=0;i<clientList.size();i++) {
+		clientList[i]->disconnect();
+	}
+}
@@ -0,0 +1,57 @@
+/*  reacTIVision tangible interaction framework
+	Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+ 
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+ 
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TUIOAGGREGATOR_H
+#define TUIOAGGREGATOR_H
+
+#include <vector>
+#include "Main.h"
+#include "TuioServer.h"
+#include "TuioMerger.h"
+#include "TuioFrameReader.h"
+#include "UdpSource.h"
+#include "TcpSource.h"
+
+// receives the TUIO streams of several tracker hosts and republishes them as one merged TUIO session
+// each source covers a region of the common surface, the merged frames are committed at a fixed rate
+class TuioAggregator
+{
+public:
+	TuioAggregator(TUIO::TuioServer *server, application_settings *config);
+	~TuioAggregator();
+
+	void run();
+	void stop() { running_ = false; };
+
+	bool running_;
+
+private:
+	TUIO::TuioServer *server_;
+	TUIO::TuioMerger *merger_;
+
+	std::vector<TUIO::OscSource*> receiverList;
+	std::vector<TUIO::TuioFrameReader*> clientList;
+	std::vector<int> sourceList;
+
+	int frame_interval_;
+	std::vector<tuio_shm_object> objects_;
+	std::vector<tuio_shm_cursor> cursors_;
+	std::vector<tuio_shm_blob> blobs_;
+};
+
+#endif
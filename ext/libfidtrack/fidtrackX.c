@@ -69,21 +69,15 @@ static void sum_leaf_centers( FidtrackerX *ft, Region *r, int width, int height
         y = ((r->top + r->bottom) * .5f);
 		
 		if( ft->pixelwarp ){
-			int pixel = width*(int)floor(y+.5f) + (int)floor(x+.5f);
-			//int pixel = width*(int)y + (int)x;
-			if ((pixel>=0) && (pixel<width*height)) {
-				x = ft->pixelwarp[ pixel ].x;
-				y = ft->pixelwarp[ pixel ].y;
-			}
-
-			if ((x>0) && (y>0)) {
+			float warped_x, warped_y;
+			if( warp_point( ft->pixelwarp, x, y, &warped_x, &warped_y ) ){
 				if( r->colour == 0 ){
-					ft->black_x_sum_warped += x * n;
-					ft->black_y_sum_warped += y * n;
+					ft->black_x_sum_warped += warped_x * n;
+					ft->black_y_sum_warped += warped_y * n;
 					ft->black_leaf_count_warped += n;
 				}else{
-					ft->white_x_sum_warped += x * n;
-					ft->white_y_sum_warped += y * n;
+					ft->white_x_sum_warped += warped_x * n;
+					ft->white_y_sum_warped += warped_y * n;
 					ft->white_leaf_count_warped += n;
 				}
 			}
@@ -122,73 +116,65 @@ static void sum_leaf_centers( FidtrackerX *ft, Region *r, int width, int height
     }
 }
 
-// for bcb compatibility
-#ifndef _USERENTRY
-#define _USERENTRY
-#endif
-
-int _USERENTRY depth_string_cmp(const void *a, const void *b)
-{
-    Region **aa = (Region**)a;
-    Region **bb = (Region**)b;
-
-    if( !(*aa)->depth_string ){
-        if( !(*bb)->depth_string )
-            return 0;
-        else
-            return 1;
-    }else if( !(*bb)->depth_string ){
-        return -1;
-    }else{
-        return -strcmp( (*aa)->depth_string, (*bb)->depth_string ); // left heavy order
-    }
-}
-
+/*
+    the left heavy depth string of a subtree is the depth of its root followed
+    by the depth strings of its children in descending lexicographic order.
+    it is encoded as a TreeCode relative to the subtree root, which is built
+    bottom-up while propagating the descendent count. since the codes order
+    like the strings, the children are sorted as integers.
+*/
 
-static char *build_left_heavy_depth_string( FidtrackerX *ft, Region *r )
+static TreeCode tree_code_increment( int length )
 {
+    TreeCode result = 0;
     int i;
-    char *result;
-    Region *adjacent;
-    char *p, *p2;
-
-//mk    assert( ft->next_depth_string < ft->depth_string_count );
-    result = &ft->depth_strings[ ft->depth_string_length * (ft->next_depth_string++) ];
-
-    result[0] = (char)('0' + r->depth);
-    result[1] = '\0';
-    p = &result[1];
 
-    if( r->adjacent_region_count != 1 ){
-
-        for( i=0; i < r->adjacent_region_count; ++i ){
-            adjacent = r->adjacent_regions[i];
-            if( adjacent->level == TRAVERSED
-                    && adjacent->descendent_count < r->descendent_count ){
+    for( i=1; i <= length; ++i )
+        result |= ((TreeCode)1) << ( TREE_CODE_BITS - TREE_CODE_FIELD_BITS*i );
 
-                adjacent->depth_string = build_left_heavy_depth_string( ft, adjacent );
-            }else{
-                adjacent->depth_string = 0;
-            }
-        }
+    return result;
+}
 
-        qsort( r->adjacent_regions, r->adjacent_region_count, sizeof(Region*), depth_string_cmp ); 
+static void compute_tree_code( Region *r )
+{
+    TreeCode children[ TREE_CODE_MAX_LENGTH ];
+    int child_lengths[ TREE_CODE_MAX_LENGTH ];
+    int child_count = 0;
+    int offset = 1;
+    int i, j;
 
-        for( i=0; i < r->adjacent_region_count; ++i ){
-            Region *adjacent = r->adjacent_regions[i];
-            if( adjacent->depth_string ){
-                p2 = adjacent->depth_string;
-                while( *p2 )
-                    *p++ = *p2++;
+    r->tree_code = INVALID_TREE_CODE;
+    if( r->descendent_count >= TREE_CODE_MAX_LENGTH || r->depth > TREE_CODE_MAX_DEPTH )
+        return;
 
-                adjacent->depth_string = 0;
+    for( i=0; i < r->adjacent_region_count; ++i ){
+        Region *adjacent = r->adjacent_regions[i];
+        if( adjacent->level == TRAVERSED
+                && adjacent->descendent_count < r->descendent_count ){
+
+            TreeCode code = adjacent->tree_code;
+            int length = adjacent->descendent_count + 1;
+            if( code == INVALID_TREE_CODE )
+                return;
+
+            // insertion sort in descending order, children are few
+            for( j=child_count; j > 0 && children[j-1] < code; --j ){
+                children[j] = children[j-1];
+                child_lengths[j] = child_lengths[j-1];
             }
+            children[j] = code;
+            child_lengths[j] = length;
+            ++child_count;
         }
-
-        *p = '\0';
     }
 
-    return result;
+    r->tree_code = ((TreeCode)1) << ( TREE_CODE_BITS - TREE_CODE_FIELD_BITS );
+    for( i=0; i < child_count; ++i ){
+        // the children are one level deeper than this node
+        TreeCode code = children[i] + tree_code_increment( child_lengths[i] );
+        r->tree_code |= code >> ( TREE_CODE_FIELD_BITS*offset );
+        offset += child_lengths[i];
+    }
 }
 
 /*
@@ -228,7 +214,6 @@ void compute_fiducial_statistics( FidtrackerX *ft, FiducialX *f,
 	double all_y_warped = 0.;
     double black_x_warped = 0.;
 	double black_y_warped = 0.;
-    char *depth_string;
 
 	double black_average = 0.;
 	double white_average = 0.;
@@ -278,32 +263,27 @@ void compute_fiducial_statistics( FidtrackerX *ft, FiducialX *f,
 	
 	if (ft->pixelwarp) {
 		if (ft->total_leaf_count>(ft->black_leaf_count_warped+ft->white_leaf_count_warped)) { 
-			int pixel = width*(int)floor(all_y+.5f)+(int)floor(all_x+.5f);
-
-			if ((pixel>=0) && (pixel<width*height)) {
-				all_x_warped = ft->pixelwarp[pixel].x;
-				all_y_warped = ft->pixelwarp[pixel].y;
-				if ((all_x_warped>0) || (all_y_warped>0)) {
-
-					pixel = width*(int)floor(black_y+.5f)+(int)floor(black_x+.5f);
-					if ((pixel>=0) && (pixel<width*height)) {
-						black_x_warped = ft->pixelwarp[pixel].x;
-						black_y_warped = ft->pixelwarp[pixel].y;
-						if ((black_x_warped>0) || (black_y_warped>0)) {
-							f->angle = calculate_angle( all_x_warped - black_x_warped, all_y_warped - black_y_warped );
-						} else f->angle = 0.0f;
-					} else f->angle = 0.0f;
+			float warped_x, warped_y;
+
+			if( warp_point( ft->pixelwarp, (float)all_x, (float)all_y, &warped_x, &warped_y ) ){
+				all_x_warped = warped_x;
+				all_y_warped = warped_y;
+
+				if( warp_point( ft->pixelwarp, (float)black_x, (float)black_y, &warped_x, &warped_y ) ){
+					black_x_warped = warped_x;
+					black_y_warped = warped_y;
+					f->angle = calculate_angle( all_x_warped - black_x_warped, all_y_warped - black_y_warped );
+				} else f->angle = 0.0f;
 						
-					f->x = all_x_warped;
-					f->y = all_y_warped;	
-				} else {
-
-					f->x = 0.0f;
-					f->y = 0.0f;
-					f->angle = 0.0f;
-					r->flags |= FUZZY_SYMBOL_FLAG;
-				}
-			} else r->flags |= FUZZY_SYMBOL_FLAG;
+				f->x = all_x_warped;
+				f->y = all_y_warped;	
+			} else {
+
+				f->x = 0.0f;
+				f->y = 0.0f;
+				f->angle = 0.0f;
+				r->flags |= FUZZY_SYMBOL_FLAG;
+			}
 		} else {
 			all_x_warped = (double)(ft->black_x_sum_warped + ft->white_x_sum_warped) / (double)(ft->black_leaf_count_warped + ft->white_leaf_count_warped);
 			all_y_warped = (double)(ft->black_y_sum_warped + ft->white_y_sum_warped) / (double)(ft->black_leaf_count_warped + ft->white_leaf_count_warped);
@@ -365,20 +345,17 @@ void compute_fiducial_statistics( FidtrackerX *ft, FiducialX *f,
 			f->id = FUZZY_FIDUCIAL_ID;
 	} else {
 		// decode valid fiducal candidates
-		ft->next_depth_string = 0;
-		depth_string = build_left_heavy_depth_string( ft, r );
-				
-		ft->temp_coloured_depth_string[0] = (char)( r->colour ? 'w' : 'b' );
-		ft->temp_coloured_depth_string[1] = '\0';
-		strcat( ft->temp_coloured_depth_string, depth_string );
+		TreeCode tree_code = r->tree_code;
+		if( tree_code != INVALID_TREE_CODE && r->colour )
+			tree_code |= TREE_CODE_WHITE;
 		
-		f->id = treestring_to_id( ft->treeidmap, ft->temp_coloured_depth_string );
+		f->id = treecode_to_id( ft->treeidmap, tree_code );
 		if (f->id != INVALID_FIDUCIAL_ID)
 			r->flags |= ROOT_REGION_FLAG;
 		else if ((ft->white_leaf_nodes>=ft->min_leafs) || (ft->black_leaf_nodes>=ft->min_leafs))
 			f->id = FUZZY_FIDUCIAL_ID;
 		
-		//if (f->id != INVALID_FIDUCIAL_ID) printf("%d %s %f\n",f->id,ft->temp_coloured_depth_string,leaf_variation);
+		//if (f->id != INVALID_FIDUCIAL_ID) printf("%d %llx %f\n",f->id,tree_code,leaf_variation);
 	}
 }
 
@@ -463,6 +440,7 @@ void propagate_descendent_count_and_max_depth_upwards(
     }
 
     r->level = TRAVERSED;
+    compute_tree_code( r );
 
     if( (r->descendent_count == ft->max_target_root_descendent_count
 		|| (r->descendent_count==YAMA_COUNT && r->colour==WHITE && r->children_visited_count==3 && r->adjacent_region_count==4))
@@ -567,7 +545,7 @@ static void find_roots( Segmenter *s, FidtrackerX *ft)
 /* -------------------------------------------------------------------------- */
 
 
-void initialize_fidtrackerX( FidtrackerX *ft, TreeIdMap *treeidmap, ShortPoint *pixelwarp )
+void initialize_fidtrackerX( FidtrackerX *ft, TreeIdMap *treeidmap, PixelWarp *pixelwarp )
 {
 	
     ft->min_target_root_descendent_count = treeidmap->min_node_count - 1;
@@ -579,13 +557,6 @@ void initialize_fidtrackerX( FidtrackerX *ft, TreeIdMap *treeidmap, ShortPoint *
     ft->max_depth = treeidmap->max_depth;
 	ft->min_leafs = treeidmap->min_deep_leafs-1;
 
-    ft->depth_string_count = treeidmap->max_node_count;
-    ft->depth_string_length = treeidmap->max_node_count + 1;
-    ft->depth_strings = (char*)malloc( ft->depth_string_count * ft->depth_string_length );
-
-    ft->temp_coloured_depth_string = (char*)malloc( ft->depth_string_length + 1 );
-    // includes space for colour prefix
-
     ft->treeidmap = treeidmap;
     ft->pixelwarp = pixelwarp;
 }
@@ -593,8 +564,8 @@ void initialize_fidtrackerX( FidtrackerX *ft, TreeIdMap *treeidmap, ShortPoint *
 
 void terminate_fidtrackerX( FidtrackerX *ft )
 {
-    free( ft->depth_strings );
-    free( ft->temp_coloured_depth_string );
+    // nothing to release, tree codes are stored within the regions
+    (void)ft;
 }
 
 
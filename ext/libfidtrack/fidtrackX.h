@@ -27,6 +27,7 @@ extern "C"
 
 #include "segment.h"
 #include "treeidmap.h"
+#include "pixelwarp.h"
 #include "floatpoint.h"
 	
 #ifndef M_PI
@@ -47,12 +48,6 @@ typedef struct FidtrackerX{
 
     struct Region root_regions_head;
 
-    char *depth_strings;
-    int depth_string_count;
-    int depth_string_length;
-    int next_depth_string;
-    char *temp_coloured_depth_string;
-
     double black_x_sum, black_y_sum, black_leaf_count;
     double white_x_sum, white_y_sum, white_leaf_count;
 	double black_x_sum_warped, black_y_sum_warped, black_leaf_count_warped;
@@ -64,12 +59,12 @@ typedef struct FidtrackerX{
 	int white_leaf_nodes, black_leaf_nodes;
 
     TreeIdMap *treeidmap;
-    ShortPoint *pixelwarp;
+    PixelWarp *pixelwarp;
 } FidtrackerX;
 
-/* pixelwarp is a Width by Height array of pixel coordinates and can be NULL */
+/* pixelwarp undistorts the leaf and fiducial centers and can be NULL */
 
-void initialize_fidtrackerX( FidtrackerX *ft, TreeIdMap *treeidmap, ShortPoint *pixelwarp );
+void initialize_fidtrackerX( FidtrackerX *ft, TreeIdMap *treeidmap, PixelWarp *pixelwarp );
 
 void terminate_fidtrackerX( FidtrackerX *ft );
 
@@ -0,0 +1,251 @@
+/*	Fiducial tracking library.
+	Copyright (C) 2004 Ross Bencina <rossb@audiomulch.com>
+	Maintainer (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+ 
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+ 
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "integral_threshold.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define WHITE ((unsigned char)255)
+#define BLACK ((unsigned char)0)
+
+/*
+    the window size is limited so that the sum of squares of a window always
+    fits into an int, which allows the compiler to vectorize the inner loop.
+*/
+#define MAX_WINDOW_SIZE (90)
+
+/*
+    the integral image is built incrementally: the column sums of the current
+    window rows are updated by adding the row entering and removing the row
+    leaving the window, and their prefix sums form the integral image row of
+    the window. this keeps the memory to a few rows of the frame.
+*/
+
+
+void initialize_integral_thresholder( IntegralThresholder *thresholder, int width )
+{
+    thresholder->column_sum = (unsigned int*)malloc( width * sizeof(unsigned int) );
+    thresholder->column_square = (unsigned int*)malloc( width * sizeof(unsigned int) );
+    thresholder->row_sum = (unsigned int*)malloc( (width+1) * sizeof(unsigned int) );
+    thresholder->row_square = (unsigned int*)malloc( (width+1) * sizeof(unsigned int) );
+    thresholder->width = width;
+}
+
+
+void terminate_integral_thresholder( IntegralThresholder *thresholder )
+{
+    free( thresholder->column_sum );
+    free( thresholder->column_square );
+    free( thresholder->row_sum );
+    free( thresholder->row_square );
+}
+
+
+static void add_row( unsigned int *column_sum, unsigned int *column_square,
+        const unsigned char *source, int source_stride, int width )
+{
+    int x;
+    unsigned int value;
+
+    if( source_stride == 1 ){
+        for( x=0; x < width; ++x ){
+            value = source[x];
+            column_sum[x] += value;
+            column_square[x] += value * value;
+        }
+    }else{
+        for( x=0; x < width; ++x ){
+            value = source[x * source_stride];
+            column_sum[x] += value;
+            column_square[x] += value * value;
+        }
+    }
+}
+
+
+static void replace_row( unsigned int *column_sum, unsigned int *column_square,
+        const unsigned char *entering, const unsigned char *leaving, int source_stride, int width )
+{
+    int x;
+    unsigned int value, old_value;
+
+    if( source_stride == 1 ){
+        for( x=0; x < width; ++x ){
+            value = entering[x];
+            old_value = leaving[x];
+            column_sum[x] += value - old_value;
+            column_square[x] += value * value - old_value * old_value;
+        }
+    }else{
+        for( x=0; x < width; ++x ){
+            value = entering[x * source_stride];
+            old_value = leaving[x * source_stride];
+            column_sum[x] += value - old_value;
+            column_square[x] += value * value - old_value * old_value;
+        }
+    }
+}
+
+
+static void remove_row( unsigned int *column_sum, unsigned int *column_square,
+        const unsigned char *source, int source_stride, int width )
+{
+    int x;
+    unsigned int value;
+
+    if( source_stride == 1 ){
+        for( x=0; x < width; ++x ){
+            value = source[x];
+            column_sum[x] -= value;
+            column_square[x] -= value * value;
+        }
+    }else{
+        for( x=0; x < width; ++x ){
+            value = source[x * source_stride];
+            column_sum[x] -= value;
+            column_square[x] -= value * value;
+        }
+    }
+}
+
+
+static void threshold_span( unsigned char *dest, const unsigned char *source, int source_stride,
+        const unsigned int *row_sum, const unsigned int *row_square,
+        int start, int end, int width, int rows, int window_size, float contrast )
+{
+    int x, left, right;
+    float count, mean, variance, value, threshold;
+    int flat, near;
+
+    for( x=start; x < end; ++x ){
+        left = x - window_size;
+        if( left < 0 )
+            left = 0;
+        right = x + window_size + 1;
+        if( right > width )
+            right = width;
+
+        count = (float)((right - left) * rows);
+        mean = (float)(int)(row_sum[right] - row_sum[left]) / count;
+        variance = (float)(int)(row_square[right] - row_square[left]) / count - mean * mean;
+        value = (float)source[x * source_stride];
+
+        // windows with a standard deviation below half the contrast threshold are clamped
+        // and pixels close to the mean are compared with the mid gray level
+        flat = ( 4.0f * variance < contrast );
+        near = ( 16.0f * (value - mean) * (value - mean) < contrast );
+        threshold = ( flat || near ) ? 127.5f : mean;
+        value = flat ? mean : value;
+        dest[x] = ( value > threshold ) ? WHITE : BLACK;
+    }
+}
+
+
+static void threshold_row( IntegralThresholder *thresholder,
+        unsigned char *dest, const unsigned char *source, int source_stride,
+        int width, int rows, int window_size, int contrast_threshold )
+{
+    int x, start, end;
+    float count, scale, contrast, mean, variance, value, threshold;
+    int flat, near;
+    unsigned int sum, square;
+    unsigned int *row_sum = thresholder->row_sum;
+    unsigned int *row_square = thresholder->row_square;
+
+    // the integral image row of the current window rows, the differences
+    // of the wrapped around sums are still exact for the limited window size
+    sum = 0;
+    square = 0;
+    row_sum[0] = 0;
+    row_square[0] = 0;
+    for( x=0; x < width; ++x ){
+        sum += thresholder->column_sum[x];
+        square += thresholder->column_square[x];
+        row_sum[x+1] = sum;
+        row_square[x+1] = square;
+    }
+
+    contrast = (float)(contrast_threshold * contrast_threshold);
+
+    // the windows at the left and right border are cropped
+    start = window_size;
+    end = width - window_size - 1;
+    if( end < start ){
+        threshold_span( dest, source, source_stride, row_sum, row_square, 0, width, width, rows, window_size, contrast );
+        return;
+    }
+    threshold_span( dest, source, source_stride, row_sum, row_square, 0, start, width, rows, window_size, contrast );
+    threshold_span( dest, source, source_stride, row_sum, row_square, end, width, width, rows, window_size, contrast );
+
+    // all other windows have the same size
+    count = (float)((2 * window_size + 1) * rows);
+    scale = 1.0f / count;
+    for( x=start; x < end; ++x ){
+        mean = (float)(int)(row_sum[x + window_size + 1] - row_sum[x - window_size]) * scale;
+        variance = (float)(int)(row_square[x + window_size + 1] - row_square[x - window_size]) * scale - mean * mean;
+        value = (float)source[x * source_stride];
+
+        // the conditional assignments avoid branches
+        flat = ( 4.0f * variance < contrast );
+        near = ( 16.0f * (value - mean) * (value - mean) < contrast );
+        threshold = ( flat || near ) ? 127.5f : mean;
+        value = flat ? mean : value;
+        dest[x] = ( value > threshold ) ? WHITE : BLACK;
+    }
+}
+
+
+void integral_threshold( IntegralThresholder *thresholder,
+        unsigned char *dest, const unsigned char *source, int source_stride,
+        int width, int height, int window_size, int contrast_threshold )
+{
+    int y, rows;
+    int increment = source_stride * width;
+
+    if( width > thresholder->width )
+        return;
+    if( window_size > MAX_WINDOW_SIZE )
+        window_size = MAX_WINDOW_SIZE;
+
+    memset( thresholder->column_sum, 0, width * sizeof(unsigned int) );
+    memset( thresholder->column_square, 0, width * sizeof(unsigned int) );
+
+    // the window of the first row
+    for( y=0; y < window_size && y < height; ++y )
+        add_row( thresholder->column_sum, thresholder->column_square, source + y * increment, source_stride, width );
+    rows = y;
+
+    for( y=0; y < height; ++y ){
+
+        // the row below the window enters and the row above it leaves
+        if( y + window_size < height && y - window_size - 1 >= 0 ){
+            replace_row( thresholder->column_sum, thresholder->column_square, source + (y + window_size) * increment,
+                    source + (y - window_size - 1) * increment, source_stride, width );
+        }else if( y + window_size < height ){
+            add_row( thresholder->column_sum, thresholder->column_square, source + (y + window_size) * increment, source_stride, width );
+            ++rows;
+        }else if( y - window_size - 1 >= 0 ){
+            remove_row( thresholder->column_sum, thresholder->column_square, source + (y - window_size - 1) * increment, source_stride, width );
+            --rows;
+        }
+
+        threshold_row( thresholder, dest + y * width, source + y * increment, source_stride,
+                width, rows, window_size, contrast_threshold );
+    }
+}
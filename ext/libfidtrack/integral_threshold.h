@@ -0,0 +1,66 @@
+/*	Fiducial tracking library.
+	Copyright (C) 2004 Ross Bencina <rossb@audiomulch.com>
+	Maintainer (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+ 
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+ 
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_INTEGRAL_THRESHOLD_H
+#define INCLUDED_INTEGRAL_THRESHOLD_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+typedef struct IntegralThresholder{
+    unsigned int *column_sum;
+    unsigned int *column_square;
+    unsigned int *row_sum;
+    unsigned int *row_square;
+    int width;
+} IntegralThresholder;
+
+void initialize_integral_thresholder( IntegralThresholder *thresholder, int width );
+void terminate_integral_thresholder( IntegralThresholder *thresholder );
+
+
+/*
+    compares each pixel with the mean of the surrounding (2*window_size+1)
+    square window. the window sums are taken from an integral image, therefore
+    the cost per pixel does not depend on the window size, which is limited to
+    90 pixels.
+
+    windows with a standard deviation below half the contrast_threshold are
+    clamped like the tiles of the tiled bernsen thresholder, so that the
+    output can be passed to the same segmenter. pixels closer than a quarter
+    of the contrast_threshold to the mean are compared with the mid gray
+    level instead, which avoids the noise around small bright or dark parts
+    of a window.
+
+    source can be a monochrome (source_stride==1) or RGB (source_stride==3) or
+    RGBA (source_stride==4) etc image. only the first byte is examined and
+    assumed to be luma. width must not exceed the initialized width.
+*/
+
+void integral_threshold( IntegralThresholder *thresholder,
+        unsigned char *dest, const unsigned char *source, int source_stride,
+        int width, int height, int window_size, int contrast_threshold );
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* INCLUDED_INTEGRAL_THRESHOLD_H */
@@ -0,0 +1,165 @@
+/*	Fiducial tracking library.
+	Copyright (C) 2004 Ross Bencina <rossb@audiomulch.com>
+	Maintainer (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+ 
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+ 
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pixelwarp.h"
+#include <stdlib.h>
+#include <math.h>
+
+#define WARP_ITERATIONS (8)
+#define WARP_PRECISION (0.01f)
+
+/*
+    the displacement within a grid cell (u,v) is interpolated as in CalibrationGrid:
+    the x displacement blends the vertical splines of the left and right grid column,
+    the y displacement blends the horizontal splines of the top and bottom grid row.
+    each cell therefore stores four cubic polynomials with four coefficients each.
+*/
+
+static void spline_coefficients( float *c, double v1, double v2, double v3, double v4 )
+{
+    c[0] = (float)( 1.0*v2 );
+    c[1] = (float)( -0.5*v1 + 0.5*v3 );
+    c[2] = (float)( 1.0*v1 - 2.5*v2 + 2.0*v3 - 0.5*v4 );
+    c[3] = (float)( -0.5*v1 + 1.5*v2 - 1.5*v3 + 0.5*v4 );
+}
+
+static float evaluate_spline( const float *c, float t )
+{
+    return ((c[3]*t + c[2])*t + c[1])*t + c[0];
+}
+
+void initialize_pixelwarp( PixelWarp *warp, int width, int height,
+        int grid_width, int grid_height )
+{
+    /* a grid needs at least two points per axis to span one cell */
+    if( grid_width < 2 ) grid_width = 2;
+    if( grid_height < 2 ) grid_height = 2;
+
+    warp->width = width;
+    warp->height = height;
+    warp->grid_width = grid_width;
+    warp->grid_height = grid_height;
+    warp->cell_width = width/(grid_width-1);
+    warp->cell_height = height/(grid_height-1);
+    warp->coefficients = 0;
+}
+
+void terminate_pixelwarp( PixelWarp *warp )
+{
+    free( warp->coefficients );
+    warp->coefficients = 0;
+}
+
+void set_pixelwarp_grid( PixelWarp *warp, const double *points )
+{
+    int gw = warp->grid_width;
+    int gh = warp->grid_height;
+    int cx, cy, i;
+
+    if( points == 0 ){
+        free( warp->coefficients );
+        warp->coefficients = 0;
+        return;
+    }
+
+    if( warp->coefficients == 0 )
+        warp->coefficients = (float*)malloc( (gw-1) * (gh-1) * 16 * sizeof(float) );
+
+    for( cy=0; cy < gh-1; ++cy ){
+        /* clamped neighbour rows and columns as in CalibrationGrid */
+        int y1 = (cy<=0) ? cy : cy-1;
+        int y4 = (cy>=gh-2) ? cy+1 : cy+2;
+
+        for( cx=0; cx < gw-1; ++cx ){
+            int x1 = (cx<=0) ? cx : cx-1;
+            int x4 = (cx>=gw-2) ? cx+1 : cx+2;
+            float *c = &warp->coefficients[ (cy*(gw-1) + cx) * 16 ];
+
+            /* vertical splines of the x displacement along both grid columns */
+            for( i=0; i < 2; ++i ){
+                int x = cx+i;
+                spline_coefficients( &c[i*4],
+                        points[ (y1*gw + x)*2 ], points[ (cy*gw + x)*2 ],
+                        points[ ((cy+1)*gw + x)*2 ], points[ (y4*gw + x)*2 ] );
+            }
+
+            /* horizontal splines of the y displacement along both grid rows */
+            for( i=0; i < 2; ++i ){
+                int y = cy+i;
+                spline_coefficients( &c[8+i*4],
+                        points[ (y*gw + x1)*2+1 ], points[ (y*gw + cx)*2+1 ],
+                        points[ (y*gw + cx+1)*2+1 ], points[ (y*gw + x4)*2+1 ] );
+            }
+        }
+    }
+}
+
+static void displacement( const PixelWarp *warp, float x, float y, float *dx, float *dy )
+{
+    float gx = x / warp->cell_width;
+    float gy = y / warp->cell_height;
+    int cx = (int)floor( gx );
+    int cy = (int)floor( gy );
+    float u, v;
+    const float *c;
+
+    if( cx < 0 ) cx = 0;
+    else if( cx > warp->grid_width-2 ) cx = warp->grid_width-2;
+    if( cy < 0 ) cy = 0;
+    else if( cy > warp->grid_height-2 ) cy = warp->grid_height-2;
+
+    u = gx - cx;
+    v = gy - cy;
+    c = &warp->coefficients[ (cy*(warp->grid_width-1) + cx) * 16 ];
+
+    *dx = ( (1.f-u) * evaluate_spline( &c[0], v ) + u * evaluate_spline( &c[4], v ) ) * warp->cell_width;
+    *dy = ( (1.f-v) * evaluate_spline( &c[8], u ) + v * evaluate_spline( &c[12], u ) ) * warp->cell_height;
+}
+
+int warp_point( const PixelWarp *warp, float x, float y, float *warped_x, float *warped_y )
+{
+    float wx = x;
+    float wy = y;
+    int i;
+
+    if( warp->coefficients ){
+        /*
+            the grid displaces undistorted positions into the camera image,
+            so the inverse is found by fixed point iteration of p = w + d(w)
+        */
+        for( i=0; i < WARP_ITERATIONS; ++i ){
+            float dx, dy, nx, ny;
+            displacement( warp, wx, wy, &dx, &dy );
+            nx = x - dx;
+            ny = y - dy;
+            if( fabs( nx-wx ) < WARP_PRECISION && fabs( ny-wy ) < WARP_PRECISION ){
+                wx = nx;
+                wy = ny;
+                break;
+            }
+            wx = nx;
+            wy = ny;
+        }
+    }
+
+    *warped_x = wx;
+    *warped_y = wy;
+
+    return ( wx >= 0 && wx < warp->width && wy >= 0 && wy < warp->height );
+}
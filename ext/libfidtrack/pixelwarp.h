@@ -0,0 +1,65 @@
+/*	Fiducial tracking library.
+	Copyright (C) 2004 Ross Bencina <rossb@audiomulch.com>
+	Maintainer (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+ 
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+ 
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INCLUDED_PIXELWARP_H
+#define INCLUDED_PIXELWARP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+    PixelWarp corrects the lens distortion described by a calibration grid
+    of grid_width by grid_height displacement points (in units of a grid cell).
+
+    instead of a full resolution lookup table it keeps the Catmull-Rom spline
+    coefficients of each grid cell and undistorts single points on demand with
+    sub-pixel accuracy. without a grid it behaves as the identity warp.
+*/
+
+typedef struct PixelWarp{
+    int width, height;
+    int grid_width, grid_height;
+    int cell_width, cell_height;
+    float *coefficients; /* 16 per grid cell, NULL for the identity warp */
+} PixelWarp;
+
+/* grid sizes below 2 are clamped to 2 */
+void initialize_pixelwarp( PixelWarp *warp, int width, int height,
+        int grid_width, int grid_height );
+void terminate_pixelwarp( PixelWarp *warp );
+
+/*
+    points contains grid_width*grid_height x,y displacement pairs in row order,
+    NULL resets the warp to the identity.
+*/
+void set_pixelwarp_grid( PixelWarp *warp, const double *points );
+
+/*
+    computes the undistorted frame position of the distorted point x,y.
+    returns 0 if the point maps outside of the frame.
+*/
+int warp_point( const PixelWarp *warp, float x, float y, float *warped_x, float *warped_y );
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* INCLUDED_PIXELWARP_H */
@@ -22,6 +22,22 @@
 #include <stdlib.h>
 #include <assert.h>
 
+/*
+    the region building functions are always inlined into the specialized
+    variants below, so that they are compiled with a constant adjacency count.
+    the rarely called adjacency functions receive it as an argument.
+*/
+#if defined(_MSC_VER)
+#define ALWAYS_INLINE __forceinline
+#elif defined(__GNUC__)
+#define ALWAYS_INLINE __inline__ __attribute__((always_inline))
+#else
+#define ALWAYS_INLINE
+#endif
+
+#define SIZEOF_REGION( max_adjacent_regions )\
+    (sizeof(Region) + sizeof(Region*) * ((max_adjacent_regions)-1))
+
 
 /* -------------------------------------------------------------------------- */
 
@@ -51,7 +67,7 @@ void unlink_region( Region* r )
 /* -------------------------------------------------------------------------- */
 
 
-static RegionReference* new_region( Segmenter *s, int x, int y, int colour )
+static ALWAYS_INLINE RegionReference* new_region( Segmenter *s, int x, int y, int colour, int max_adjacent_regions )
 {
     RegionReference *result;
     Region *r;
@@ -61,7 +77,7 @@ static RegionReference* new_region( Segmenter *s, int x, int y, int colour )
         r = s->freed_regions_head;
         s->freed_regions_head = r->next;
     }else{
-        r = LOOKUP_SEGMENTER_REGION( s, s->region_count++ );
+        r = (Region*)(s->regions + SIZEOF_REGION( max_adjacent_regions ) * s->region_count++);
     }
 
 	assert( colour == 0 || colour == 255 );
@@ -206,7 +222,7 @@ static void make_fragmented( Region* r1 )
 }
 */
 
-static void make_adjacent( Segmenter *s, Region* r1, Region* r2 )
+static void make_adjacent( Region* r1, Region* r2, int max_adjacent_regions )
 {
     if( !is_adjacent( r1, r2 ) ){
         if( r1->flags & SATURATED_REGION_FLAG ){
@@ -216,22 +232,22 @@ static void make_adjacent( Segmenter *s, Region* r1, Region* r2 )
             r1->flags |= FRAGMENTED_REGION_FLAG;
 
         }else{
-            if( r1->adjacent_region_count == s->max_adjacent_regions ){
+            if( r1->adjacent_region_count == max_adjacent_regions ){
                 make_saturated(r1);
                 r2->flags |= FRAGMENTED_REGION_FLAG;
 
-                if( r2->adjacent_region_count == s->max_adjacent_regions ){
+                if( r2->adjacent_region_count == max_adjacent_regions ){
                     make_saturated(r2);
                     r1->flags |= FRAGMENTED_REGION_FLAG;
                 }
-            }else if( r2->adjacent_region_count == s->max_adjacent_regions ){
+            }else if( r2->adjacent_region_count == max_adjacent_regions ){
                 make_saturated(r2);
                 r1->flags |= FRAGMENTED_REGION_FLAG;
             }else{
                 assert( !(r1->flags & SATURATED_REGION_FLAG) );
                 assert( !(r2->flags & SATURATED_REGION_FLAG) );
-                assert( r1->adjacent_region_count < s->max_adjacent_regions );
-                assert( r2->adjacent_region_count < s->max_adjacent_regions );
+                assert( r1->adjacent_region_count < max_adjacent_regions );
+                assert( r2->adjacent_region_count < max_adjacent_regions );
                 r1->adjacent_regions[ r1->adjacent_region_count++ ] = r2;
                 r2->adjacent_regions[ r2->adjacent_region_count++ ] = r1;
             }
@@ -270,7 +286,7 @@ static void replace_adjacent( Region *r1, Region *r2, Region *r3 )  // replace r
 // merge r2 into r1 by first removing all common adjacencies from r2
 // then transferring the remainder of adjacencies to r1 after discarding
 // any excess adjacencies.
-static void merge_regions( Segmenter *s, Region* r1, Region* r2 )
+static void merge_regions( Region* r1, Region* r2, int max_adjacent_regions )
 {
     int i;
  
@@ -297,7 +313,7 @@ static void merge_regions( Segmenter *s, Region* r1, Region* r2 )
             }
         }
 
-        if( r1->adjacent_region_count + r2->adjacent_region_count > s->max_adjacent_regions ){
+        if( r1->adjacent_region_count + r2->adjacent_region_count > max_adjacent_regions ){
             make_saturated( r1 );
             make_saturated( r2 );
         }else{
@@ -309,8 +325,8 @@ static void merge_regions( Segmenter *s, Region* r1, Region* r2 )
                 replace_adjacent( a, r2, r1 ); // replace r2 with r1 in the adjacency list of a
                 r1->adjacent_regions[r1->adjacent_region_count++] = a;
 
-                assert( a->adjacent_region_count <= s->max_adjacent_regions );
-                assert( r1->adjacent_region_count <= s->max_adjacent_regions );
+                assert( a->adjacent_region_count <= max_adjacent_regions );
+                assert( r1->adjacent_region_count <= max_adjacent_regions );
             }
 
             r2->adjacent_region_count = 0;
@@ -342,47 +358,51 @@ static void merge_regions( Segmenter *s, Region* r1, Region* r2 )
 }
 
 
-static void build_regions( Segmenter *s, const unsigned char *source )
+/*
+    segments the window from left,top to right,bottom (inclusive) of the source
+    image. the spans and region bounds keep their frame coordinates, and the
+    window border is treated like the frame border.
+*/
+
+static ALWAYS_INLINE void build_window_regions( Segmenter *s, const unsigned char *source,
+        int left, int top, int right, int bottom, int max_adjacent_regions )
 {
     Span *new_span;
 	int x, y, i;
     RegionReference **current_row = &s->regions_under_construction[0];
     RegionReference **previous_row = &s->regions_under_construction[s->width];
 
-    s->region_ref_count = 0;
-    s->region_count = 0;
-    s->freed_regions_head = 0;
-
     // top line
 
-    x = 0;
-    y = 0;
-    current_row[0] = new_region( s, x, y, source[0] );
-    current_row[0]->region->flags |= ADJACENT_TO_ROOT_REGION_FLAG;
-    for( x=1, y=0, i=1 ; x < s->width; ++x, ++i ){
+    x = left;
+    y = top;
+    i = y * s->width + x;
+    current_row[x] = new_region( s, x, y, source[i], max_adjacent_regions );
+    current_row[x]->region->flags |= ADJACENT_TO_ROOT_REGION_FLAG;
+    for( x=left+1, ++i ; x <= right; ++x, ++i ){
 
         if( source[i] == source[i-1] ){
             current_row[x] = current_row[x-1];
         }else{
 			current_row[x-1]->region->last_span->end=i-1;
 			current_row[x-1]->region->area += i-current_row[x-1]->region->last_span->start;
-            current_row[x] = new_region( s, x, y, source[i] );
+            current_row[x] = new_region( s, x, y, source[i], max_adjacent_regions );
             current_row[x]->region->flags |= ADJACENT_TO_ROOT_REGION_FLAG;
-            make_adjacent( s, current_row[x]->region, current_row[x-1]->region );
+            make_adjacent( current_row[x]->region, current_row[x-1]->region, max_adjacent_regions );
         }
     }
 
     // process lines
 
-    for( y=1; y < s->height; ++y ){
+    for( y=top+1; y <= bottom; ++y ){
 
         // swap previous and current rows
         RegionReference **temp = previous_row;
         previous_row = current_row;
         current_row = temp;
 
-        i = y * s->width;
-        x = 0;
+        x = left;
+        i = y * s->width + x;
 
         // left edge
 
@@ -399,17 +419,17 @@ static void build_regions( Segmenter *s, const unsigned char *source )
 
 		}else{ // source[i] != previous_row[x]->colour
 
-            current_row[x] = new_region( s, x, y, source[i] );
+            current_row[x] = new_region( s, x, y, source[i], max_adjacent_regions );
             current_row[x]->region->flags |= ADJACENT_TO_ROOT_REGION_FLAG;
-            make_adjacent( s, current_row[x]->region, previous_row[x]->region );
+            make_adjacent( current_row[x]->region, previous_row[x]->region, max_adjacent_regions );
         }
 
         ++i;
-        x=1;
+        x=left+1;
 
         // center span
 
-        for( ; x < s->width; ++x, ++i ){
+        for( ; x <= right; ++x, ++i ){
             //RESOLVE_REGIONREF_REDIRECTS( current_row[x-1], current_row[x-1] );   // this isn't needed because the the west cell's redirect is always up to date
             RESOLVE_REGIONREF_REDIRECTS( previous_row[x], previous_row[x] );
 
@@ -429,7 +449,7 @@ static void build_regions( Segmenter *s, const unsigned char *source )
 					previous_row[x]->region->last_span = current_row[x]->region->last_span;
 					previous_row[x]->region->area += current_row[x]->region->area;
 
-                    merge_regions( s, previous_row[x]->region, current_row[x]->region );
+                    merge_regions( previous_row[x]->region, current_row[x]->region, max_adjacent_regions );
                     current_row[x]->region->flags = FREE_REGION_FLAG;
                     current_row[x]->region->next = s->freed_regions_head;
                     s->freed_regions_head = current_row[x]->region;
@@ -466,40 +486,78 @@ static void build_regions( Segmenter *s, const unsigned char *source )
 					current_row[x]->region->last_span = new_span;
 
                 }else{
-                    current_row[x] = new_region( s, x, y, source[i] );
-                    make_adjacent( s, current_row[x]->region, previous_row[x]->region );
+                    current_row[x] = new_region( s, x, y, source[i], max_adjacent_regions );
+                    make_adjacent( current_row[x]->region, previous_row[x]->region, max_adjacent_regions );
                     /* disable diagonal links //mk
 					if( current_row[x-1]->region != previous_row[x]->region )
-                        make_adjacent( s, current_row[x]->region, current_row[x-1]->region );
+                        make_adjacent( current_row[x]->region, current_row[x-1]->region, max_adjacent_regions );
 					//*/
                 }
             }
         }
 
         // right edge
-        current_row[s->width-1]->region->flags |= ADJACENT_TO_ROOT_REGION_FLAG;
-		current_row[s->width-1]->region->last_span->end=i-1;
+        current_row[right]->region->flags |= ADJACENT_TO_ROOT_REGION_FLAG;
+		current_row[right]->region->last_span->end=i-1;
 		current_row[x-1]->region->area+=i-current_row[x-1]->region->last_span->start+2;
     }
 
     // make regions of bottom row adjacent or merge with root
 
-    for( x = 0; x < s->width; ++x ){
+    for( x = left; x <= right; ++x ){
         RESOLVE_REGIONREF_REDIRECTS( current_row[x], current_row[x] );
         current_row[x]->region->flags |= ADJACENT_TO_ROOT_REGION_FLAG;
     }
 }
 
 
+/*
+    each variant passes either a constant or the initialized adjacency count,
+    the variant for the adjacency count of the segmenter is selected once by
+    initialize_segmenter. the counts are those of the mini, small and default
+    trees and of the pyramid level segmenter.
+*/
+#define SEGMENTER_VARIANT( name, adjacent_regions )                            \
+static void name( Segmenter *s, const unsigned char *source,                   \
+        int left, int top, int right, int bottom )                             \
+{                                                                              \
+    build_window_regions( s, source, left, top, right, bottom,                 \
+            adjacent_regions );                                                \
+}
+
+SEGMENTER_VARIANT( build_window_regions_generic, s->max_adjacent_regions )
+SEGMENTER_VARIANT( build_window_regions_10, 10 )
+SEGMENTER_VARIANT( build_window_regions_13, 13 )
+SEGMENTER_VARIANT( build_window_regions_16, 16 )
+SEGMENTER_VARIANT( build_window_regions_19, 19 )
+
+
+static void build_regions( Segmenter *s, const unsigned char *source )
+{
+    s->region_ref_count = 0;
+    s->region_count = 0;
+    s->freed_regions_head = 0;
+
+    s->build_window_regions( s, source, 0, 0, s->width-1, s->height-1 );
+}
+
+
 /* -------------------------------------------------------------------------- */
 
 
 void initialize_segmenter( Segmenter *s, int width, int height, int max_adjacent_regions )
 {
     s->max_adjacent_regions = max_adjacent_regions;
+    switch( max_adjacent_regions ){
+        case 10: s->build_window_regions = build_window_regions_10; break;
+        case 13: s->build_window_regions = build_window_regions_13; break;
+        case 16: s->build_window_regions = build_window_regions_16; break;
+        case 19: s->build_window_regions = build_window_regions_19; break;
+        default: s->build_window_regions = build_window_regions_generic;
+    }
     s->region_refs = (RegionReference*)malloc( sizeof(RegionReference) * width * height );
     s->region_ref_count = 0;
-    s->sizeof_region = sizeof(Region) + sizeof(Region*) * (max_adjacent_regions-1);
+    s->sizeof_region = SIZEOF_REGION( max_adjacent_regions );
     s->regions = (unsigned char*)malloc( s->sizeof_region * width * height );
     s->spans = (unsigned char*)malloc( sizeof(Span) * width * height );
     s->region_count = 0;
@@ -523,3 +581,20 @@ void step_segmenter( Segmenter *s, const unsigned char *source )
     if( s->region_refs && s->regions && s->regions_under_construction && s->spans) 
 		build_regions( s, source );
 }
+
+void step_window_segmenter( Segmenter *s, const unsigned char *source,
+        const SegmenterWindow *windows, int window_count )
+{
+    int i;
+
+    if( !(s->region_refs && s->regions && s->regions_under_construction && s->spans) )
+        return;
+
+    s->region_ref_count = 0;
+    s->region_count = 0;
+    s->freed_regions_head = 0;
+
+    for( i=0; i < window_count; ++i )
+        s->build_window_regions( s, source, windows[i].left, windows[i].top,
+                windows[i].right, windows[i].bottom );
+}
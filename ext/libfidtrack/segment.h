@@ -99,7 +99,7 @@ typedef struct Region{
     short depth;                            /* initialized to 0 */
     short children_visited_count;           /* initialized to 0 */
     short descendent_count;                 /* initialized to 0x7FFF */
-    char *depth_string;                     /* not initialized by segmenter */
+    unsigned long long tree_code;           /* not initialized by segmenter */
 
     short adjacent_region_count;
     struct Region *adjacent_regions[ 1 ];   /* variable length array of length max_adjacent_regions */
@@ -145,6 +145,10 @@ typedef struct Segmenter{
 
     int sizeof_region;
     int max_adjacent_regions;
+
+    /* the region building variant for max_adjacent_regions */
+    void (*build_window_regions)( struct Segmenter *s, const unsigned char *source,
+            int left, int top, int right, int bottom );
 	
 	int width, height;
 
@@ -162,6 +166,21 @@ void terminate_segmenter( Segmenter *segments );
 
 void step_segmenter( Segmenter *segments, const unsigned char *source );
 
+/*
+    a rectangular part of the frame from left,top to right,bottom (inclusive)
+*/
+typedef struct SegmenterWindow{
+    int left, top, right, bottom;
+} SegmenterWindow;
+
+/*
+    segments only the given windows of the source image, which must not overlap.
+    the regions of all windows are stored in the same frame coordinates as with
+    step_segmenter, regions touching a window border are adjacent to the root.
+*/
+void step_window_segmenter( Segmenter *segments, const unsigned char *source,
+        const SegmenterWindow *windows, int window_count );
+
 
 #ifdef __cplusplus
 }
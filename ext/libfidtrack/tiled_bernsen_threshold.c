@@ -23,6 +23,18 @@
 #define WHITE ((unsigned char)255)
 #define BLACK ((unsigned char)0)
 
+/*
+    the frame functions are always inlined into the specialized variants below,
+    so that their loops are compiled with a constant stride and tile size.
+*/
+#if defined(_MSC_VER)
+#define ALWAYS_INLINE __forceinline
+#elif defined(__GNUC__)
+#define ALWAYS_INLINE __inline__ __attribute__((always_inline))
+#else
+#define ALWAYS_INLINE
+#endif
+
 /*
     thresholder works on tile_size tiles of the image. applying one threshold
     to each tile. each tile's threshold is taken of the mean of the min and max
@@ -71,7 +83,7 @@ static void init_min_max( unsigned char *min_max_dest, int count )
 }
 
 
-static void compute_span_min_max( unsigned char *min_max_dest,
+static ALWAYS_INLINE void compute_span_min_max( unsigned char *min_max_dest,
         const unsigned char *source, int source_stride, int count )
 {
     int i;
@@ -100,7 +112,7 @@ static void compute_span_min_max( unsigned char *min_max_dest,
 }
 
 
-static void compute_multiple_spans_min_max( unsigned char *min_max_dest,
+static ALWAYS_INLINE void compute_multiple_spans_min_max( unsigned char *min_max_dest,
         const unsigned char *source, int source_stride,
         int vector_size, int span_count )
 {
@@ -114,7 +126,7 @@ static void compute_multiple_spans_min_max( unsigned char *min_max_dest,
 }
 
 
-static void compute_line_min_max_spans( unsigned char *min_max_dest,
+static ALWAYS_INLINE void compute_line_min_max_spans( unsigned char *min_max_dest,
         const unsigned char *source, int source_stride,
         int first_vector_size, int full_span_count, int last_vector_size,
         int tile_size )
@@ -131,7 +143,7 @@ static void compute_line_min_max_spans( unsigned char *min_max_dest,
 }
 
 
-static void compute_frame_min_max_tiles( unsigned char *min_max_dest,
+static ALWAYS_INLINE void compute_frame_min_max_tiles( unsigned char *min_max_dest,
         const unsigned char *source, int source_stride,
         int width, int height, int tile_size )
 {
@@ -239,7 +251,7 @@ static void compute_frame_threshold_tiles( unsigned char *thresholds_dest,
 }
 
 
-static void apply_frame_thresholds( unsigned char *dest,
+static ALWAYS_INLINE void apply_frame_thresholds( unsigned char *dest,
         const unsigned char *source, int source_stride,
         const unsigned char *threshold,
         int width, int height, int tile_size )
@@ -267,7 +279,7 @@ static void apply_frame_thresholds( unsigned char *dest,
 }
 
 
-void tiled_bernsen_threshold( TiledBernsenThresholder *thresholder,
+static ALWAYS_INLINE void threshold_frame( TiledBernsenThresholder *thresholder,
         unsigned char *dest, const unsigned char *source, int source_stride,
         int width, int height, int tile_size, int contrast_threshold )
 {
@@ -282,4 +294,67 @@ void tiled_bernsen_threshold( TiledBernsenThresholder *thresholder,
 }
 
 
+typedef void (*TiledBernsenFunction)( TiledBernsenThresholder *thresholder,
+        unsigned char *dest, const unsigned char *source, int source_stride,
+        int width, int height, int tile_size, int contrast_threshold );
 
+/*
+    each variant passes either constants or its own arguments as the stride
+    and tile size, the generic variant is used for all other cases.
+*/
+#define TILED_BERNSEN_VARIANT( name, stride, tile )                            \
+static void name( TiledBernsenThresholder *thresholder,                        \
+        unsigned char *dest, const unsigned char *source, int source_stride,   \
+        int width, int height, int tile_size, int contrast_threshold )         \
+{                                                                              \
+    (void)source_stride;                                                       \
+    (void)tile_size;                                                           \
+    threshold_frame( thresholder, dest, source, stride,                        \
+            width, height, tile, contrast_threshold );                         \
+}
+
+TILED_BERNSEN_VARIANT( threshold_generic, source_stride, tile_size )
+TILED_BERNSEN_VARIANT( threshold_luma, 1, tile_size )
+TILED_BERNSEN_VARIANT( threshold_luma_4, 1, 4 )
+TILED_BERNSEN_VARIANT( threshold_luma_8, 1, 8 )
+TILED_BERNSEN_VARIANT( threshold_luma_16, 1, 16 )
+TILED_BERNSEN_VARIANT( threshold_luma_32, 1, 32 )
+TILED_BERNSEN_VARIANT( threshold_rgb, 3, tile_size )
+TILED_BERNSEN_VARIANT( threshold_rgb_4, 3, 4 )
+TILED_BERNSEN_VARIANT( threshold_rgb_8, 3, 8 )
+TILED_BERNSEN_VARIANT( threshold_rgb_16, 3, 16 )
+TILED_BERNSEN_VARIANT( threshold_rgb_32, 3, 32 )
+
+
+static TiledBernsenFunction select_variant( int source_stride, int tile_size )
+{
+    if( source_stride == 1 ){
+        switch( tile_size ){
+            case 4: return threshold_luma_4;
+            case 8: return threshold_luma_8;
+            case 16: return threshold_luma_16;
+            case 32: return threshold_luma_32;
+            default: return threshold_luma;
+        }
+    }else if( source_stride == 3 ){
+        switch( tile_size ){
+            case 4: return threshold_rgb_4;
+            case 8: return threshold_rgb_8;
+            case 16: return threshold_rgb_16;
+            case 32: return threshold_rgb_32;
+            default: return threshold_rgb;
+        }
+    }
+
+    return threshold_generic;
+}
+
+
+void tiled_bernsen_threshold( TiledBernsenThresholder *thresholder,
+        unsigned char *dest, const unsigned char *source, int source_stride,
+        int width, int height, int tile_size, int contrast_threshold )
+{
+    TiledBernsenFunction threshold = select_variant( source_stride, tile_size );
+
+    threshold( thresholder, dest, source, source_stride, width, height, tile_size, contrast_threshold );
+}
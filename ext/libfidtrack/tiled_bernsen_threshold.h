@@ -38,7 +38,8 @@ void terminate_tiled_bernsen_thresholder( TiledBernsenThresholder *thresholder )
 /*
     source can be a monochrome (source_stride==1) or RGB (source_stride==3) or
     RGBA (source_stride==4) etc image. only the first byte is examined and
-    assumed to be luma.
+    assumed to be luma. monochrome and RGB images with a tile_size of 4, 8, 16
+    or 32 are processed by variants compiled for these constants.
 
     dest is the thresholded data as 8 bit black and white
 
@@ -22,7 +22,6 @@
 
 #include <string.h>
 #include <assert.h>
-#include <map>
 #include <vector>
 #include <string>
 #include <fstream>
@@ -92,17 +91,28 @@ static int find_maximum_descendent_count( const std::string& s )
 class TreeIdMapImplementation{
     TreeIdMap* owner_;
 
-    struct charstar_less{
-        bool operator()( const char *lhs, const char *rhs ) const
-        {
-            return strcmp( lhs, rhs ) < 0;
-        }
-    };
+    // open addressing hash table of tree codes, sized to a power of two
+    std::vector< TreeCode > codes_;
+    std::vector< int > ids_;
+    unsigned int mask_;
+    int shift_;
 
-    typedef std::map<const char*, int, charstar_less> map_type;
-    map_type treeIdMap_;
+    unsigned int slot( TreeCode code ) const
+    {
+        return (unsigned int)( (code * 0x9E3779B97F4A7C15ULL) >> shift_ ) & mask_;
+    }
 
-    std::vector< const char *> strings_;
+    bool insert( TreeCode code, int id )
+    {
+        unsigned int i = slot( code );
+        while( codes_[i] != INVALID_TREE_CODE ){
+            if( codes_[i] == code ) return false;
+            i = (i + 1) & mask_;
+        }
+        codes_[i] = code;
+        ids_[i] = id;
+        return true;
+    }
 
 public:
     TreeIdMapImplementation( TreeIdMap* treeidmap, const char *tree )
@@ -117,8 +127,9 @@ public:
 		int minDeepLeafs = 0x7FFF;
 
 		const char* file_buffer[1024];
-		const char** tree_buffer;
+		const char** tree_buffer = 0;
 		int tree_length = 0;
+		bool tree_file = false;
 		
 		if (strstr(tree,".trees")!=NULL) {
 			std::ifstream is( tree );
@@ -127,18 +138,19 @@ public:
 				std::cout << "error opening tree file: " << tree << std::endl;
 			} else {
 				std::string s;
-				while( !is.eof() ) {
+				while( !is.eof() && tree_length < 1024 ) {
 					s.clear();
 					is >> s;
 					if( s.empty() ) continue;
 					
-					char *ss = new char[128];
+					char *ss = new char[ s.size() + 1 ];
 					strcpy( ss , s.c_str() );
 					file_buffer[tree_length] = ss;
 					tree_length++;
 				}
 				
 				tree_buffer = file_buffer;
+				tree_file = true;
 			}
 		} else if(strcmp(tree,"default")==0) {
 			tree_buffer = default_tree;
@@ -151,7 +163,19 @@ public:
 			tree_length = mini_tree_length;
 		}
 
-		treeIdMap_.insert( std::make_pair( "w012211", YAMA_ID ));
+		// at most half of the table is occupied
+		int size = 16;
+		shift_ = 60;
+		while( size < 2*(tree_length+1) ){
+			size <<= 1;
+			shift_--;
+		}
+		mask_ = size - 1;
+		codes_.assign( size, INVALID_TREE_CODE );
+		ids_.assign( size, INVALID_TREE_ID );
+
+		insert( treestring_to_code( "w012211" ), YAMA_ID );
+		int tree_count = 1;
 		
 		int id = 0;
 		for (int j=0;j<tree_length;j++) {
@@ -160,11 +184,10 @@ public:
 			
 			int depthSequenceLength = (int)( s.size() - 1 );
 			
-			char *ss = new char[ s.size() + 1 ];
-			strings_.push_back( ss );
-			strcpy( ss, s.c_str() );
-			std::pair<map_type::iterator, bool> i = treeIdMap_.insert( std::make_pair( ss, id++ ) );
-			if( i.second ){
+			TreeCode code = treestring_to_code( s.c_str() );
+			int treeId = id++;
+			if( code != INVALID_TREE_CODE && insert( code, treeId ) ){
+				tree_count++;
 				if( depthSequenceLength < minNodeCount )
 					minNodeCount = depthSequenceLength;
 				if( depthSequenceLength > maxNodeCount )
@@ -189,8 +212,12 @@ public:
 			}
 		}
 		
+		if( tree_file ){
+			for (int j=0;j<tree_length;j++) delete [] file_buffer[j];
+		}
+		
 		maxAdjacencies = maxNodeCount;
-		owner_->tree_count = treeIdMap_.size();
+		owner_->tree_count = tree_count;
 		owner_->min_node_count = minNodeCount;
 		owner_->max_node_count = maxNodeCount;
 		owner_->min_depth = minDepth;
@@ -257,22 +284,40 @@ public:
     }
 */
 
-    ~TreeIdMapImplementation()
+    int treecode_to_id( TreeCode code ) const
     {
-        while( !strings_.empty() ){
-            delete [] strings_.back();
-            strings_.pop_back();
+        if( code == INVALID_TREE_CODE ) return INVALID_TREE_ID;
+        
+        unsigned int i = slot( code );
+        while( codes_[i] != INVALID_TREE_CODE ){
+            if( codes_[i] == code ) return ids_[i];
+            i = (i + 1) & mask_;
         }
+        return INVALID_TREE_ID;
     }
+};
 
-    int treestring_to_id( const char *treestring )
-    {
-        map_type::iterator i = treeIdMap_.find( treestring );
-        if( i != treeIdMap_.end() ) return i->second;
-        else  return INVALID_TREE_ID;
+
+TreeCode treestring_to_code( const char *treestring )
+{
+    TreeCode code = INVALID_TREE_CODE;
+    int length = 0;
+    const char *p;
+
+    if( treestring[0] == 'w' ) code = TREE_CODE_WHITE;
+    else if( treestring[0] != 'b' ) return INVALID_TREE_CODE;
+
+    for( p = treestring+1; *p; ++p ){
+        int d = *p - '0';
+        if( d < 0 || d > TREE_CODE_MAX_DEPTH || length == TREE_CODE_MAX_LENGTH )
+            return INVALID_TREE_CODE;
+
+        code |= ((TreeCode)(d + 1)) << ( TREE_CODE_BITS - TREE_CODE_FIELD_BITS*(++length) );
     }
-};
 
+    if( length == 0 ) return INVALID_TREE_CODE;
+    return code;
+}
 
 void initialize_treeidmap( TreeIdMap* treeidmap, const char* tree )
 {
@@ -286,7 +331,27 @@ void terminate_treeidmap( TreeIdMap* treeidmap )
 }
 
 // returns -1 for unfound id
+int treecode_to_id( TreeIdMap* treeidmap, TreeCode treecode )
+{
+    return ((TreeIdMapImplementation*)treeidmap->implementation_)->treecode_to_id( treecode );
+}
+
 int treestring_to_id( TreeIdMap* treeidmap, const char *treestring )
 {
-    return ((TreeIdMapImplementation*)treeidmap->implementation_)->treestring_to_id( treestring );
+    return treecode_to_id( treeidmap, treestring_to_code( treestring ) );
+}
+
+const char* default_treestring( const char *tree, int id )
+{
+    if( id < 0 ) return 0;
+
+    if( strcmp( tree, "default" ) == 0 ){
+        if( id < default_tree_length ) return default_tree[id];
+    }else if( strcmp( tree, "small" ) == 0 ){
+        if( id < small_tree_length ) return small_tree[id];
+    }else if( strcmp( tree, "mini" ) == 0 ){
+        if( id < mini_tree_length ) return mini_tree[id];
+    }
+
+    return 0;
 }
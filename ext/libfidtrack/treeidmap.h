@@ -44,9 +44,32 @@ void terminate_treeidmap( TreeIdMap* treeidmap );
 #define YAMA_COUNT  (5)
 #define YAMA_ID  (-5)
 
+/*
+    trees are looked up by a compact integer encoding of the coloured depth string.
+    each depth digit d is stored as d+1 in a three bit field, left aligned within
+    the lower TREE_CODE_BITS, so that the numerical order of two codes follows the
+    lexicographic order of their depth strings. the colour flag is stored above.
+*/
+typedef unsigned long long TreeCode;
+
+#define TREE_CODE_FIELD_BITS    (3)
+#define TREE_CODE_MAX_LENGTH    (19)
+#define TREE_CODE_MAX_DEPTH     (6)
+#define TREE_CODE_BITS          (TREE_CODE_FIELD_BITS*TREE_CODE_MAX_LENGTH)
+#define TREE_CODE_WHITE         (((TreeCode)1) << TREE_CODE_BITS)
+#define INVALID_TREE_CODE       ((TreeCode)0)
+
+// returns INVALID_TREE_CODE if the string can not be encoded
+TreeCode treestring_to_code( const char *treestring );
+
 // returns INVALID_TREE_ID for unfound id
+int treecode_to_id( TreeIdMap* treeidmap, TreeCode treecode );
 int treestring_to_id( TreeIdMap* treeidmap, const char *treestring );
 
+// returns the tree string with the provided id of the built-in tree sets default, small or mini,
+// or NULL if the tree set is unknown or the id is out of range
+const char* default_treestring( const char *tree, int id );
+
 
 #ifdef __cplusplus
 }
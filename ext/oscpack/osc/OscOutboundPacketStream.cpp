@@ -433,6 +433,27 @@ OutboundPacketStream& OutboundPacketStream::operator<<( const MessageTerminator&
 }
 
 
+void OutboundPacketStream::AppendMessage( const char *message, std::size_t size )
+{
+    if( IsMessageInProgress() )
+        throw MessageInProgressException();
+
+    std::size_t required = Size() + ((ElementSizeSlotRequired())?4:0) + size;
+
+    if( required > Capacity() )
+        throw OutOfBufferMemoryException();
+
+    messageCursor_ = BeginElement( messageCursor_ );
+
+    std::memcpy( messageCursor_, message, size );
+    messageCursor_ += size;
+
+    argumentCurrent_ = messageCursor_;
+
+    EndElement( messageCursor_ );
+}
+
+
 OutboundPacketStream& OutboundPacketStream::operator<<( bool rhs )
 {
     CheckForAvailableArgumentSpace(0);
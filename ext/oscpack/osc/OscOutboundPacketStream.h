@@ -124,6 +124,9 @@ public:
     OutboundPacketStream& operator<<( const ArrayInitiator& rhs );
     OutboundPacketStream& operator<<( const ArrayTerminator& rhs );
 
+    // appends a complete, preformatted message (including address and type tags)
+    void AppendMessage( const char *message, std::size_t size );
+
 private:
 
     char *BeginElement( char *beginPtr );
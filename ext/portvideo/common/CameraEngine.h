@@ -87,6 +87,7 @@ extern const char* dstr[];
 #define DRIVER_UVCCAM   4
 #define DRIVER_FILE    10
 #define DRIVER_FOLDER  11
+#define DRIVER_SCENE   12
 
 #define VALUE_INCREASE   79
 #define VALUE_DECREASE   80
@@ -198,6 +198,11 @@ CameraEngine* CameraTool::getCamera(CameraConfig *cam_cfg) {
 	}
 #endif
 
+	if (cam_cfg->driver==DRIVER_SCENE) {
+		camera = SceneCamera::getCamera(cam_cfg);
+		if (camera) return camera;
+	}
+
 #ifndef LINUX
 	if(cam_cfg->driver == DRIVER_PS3EYE) {
 		dev_count = PS3EyeCamera::getDeviceCount();
@@ -381,6 +386,7 @@ CameraConfig* CameraTool::readSettings(const char* cfgfile) {
 		else if (strcmp(camera_element->Attribute("driver"), "ps3eye" ) == 0) cam_cfg.driver=DRIVER_PS3EYE;
 		else if (strcmp(camera_element->Attribute("driver"), "file" ) == 0) cam_cfg.driver=DRIVER_FILE;
 		else if (strcmp(camera_element->Attribute("driver"), "folder" ) == 0) cam_cfg.driver=DRIVER_FOLDER;
+		else if (strcmp(camera_element->Attribute("driver"), "scene" ) == 0) cam_cfg.driver=DRIVER_SCENE;
 	}
 	
 	if(camera_element->Attribute("id")!=NULL) {
@@ -44,6 +44,7 @@
 #include "FileCamera.h"
 #include "FolderCamera.h"
 #endif
+#include "SceneCamera.h"
 
 #include <iostream>
 #include <vector>
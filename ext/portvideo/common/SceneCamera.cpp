@@ -0,0 +1,624 @@
+/*  portVideo, a cross platform camera framework
+ Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SceneCamera.h"
+#include "treeidmap.h"
+#include <thread>
+#include <fstream>
+
+#define SCENE_GAP 1.0f
+#define SCENE_DARK 48
+#define SCENE_BRIGHT 208
+#define NOISE_RANGE 65536
+
+std::atomic<long long> SceneCamera::probe_time[PROBE_CODES];
+std::atomic<int> SceneCamera::probe_id(-1);
+
+// the same angle convention as the fiducial tracker
+static double leafAngle( double dx, double dy ) {
+	double result;
+	if( fabs(dx) > 0.001 ) {
+		result = atan(dy/dx) - M_PI * .5;
+		if( dx < 0 ) result =  result - M_PI;
+		if( result < 0 ) result += 2. * M_PI;
+	} else {
+		if (dy>0) result = 0;
+		else result = M_PI;
+	}
+	return result;
+}
+
+SceneCamera::SceneCamera(CameraConfig *cam_cfg): CameraEngine(cam_cfg)
+{
+	cam_buffer = NULL;
+	scene_buffer = NULL;
+	noise_buffer = NULL;
+	truth = NULL;
+	sprintf(cfg->name,"SceneCamera");
+	running=false;
+
+	sprintf(tree_set,"default");
+	truth_file[0] = '\0';
+	fiducial_count = 20;
+	finger_count = 0;
+	blob_count = 0;
+	symbol_size = 80.0f;
+	finger_size = 16.0f;
+	blob_size = 48.0f;
+	speed = 1.0f;
+	noise = 8;
+	seed = 1;
+	probe = false;
+	probe_symbol = 0;
+	noise_offset = 0;
+	frame_count = 0;
+}
+
+SceneCamera::~SceneCamera()
+{
+	if (cam_buffer!=NULL) delete []cam_buffer;
+	if (scene_buffer!=NULL) delete []scene_buffer;
+	if (noise_buffer!=NULL) delete []noise_buffer;
+	if (truth!=NULL) fclose(truth);
+}
+
+CameraEngine* SceneCamera::getCamera(CameraConfig *cam_cfg) {
+
+	if (strcmp(cam_cfg->src,"none")!=0) {
+		struct stat info;
+		if (stat(cam_cfg->src,&info)!=0) {
+			printf("could not find scene %s\n",cam_cfg->src);
+			return NULL;
+		}
+	}
+	return new SceneCamera(cam_cfg);
+}
+
+bool SceneCamera::readScene() {
+
+	// without a scene file the default scene is used
+	if (strcmp(cfg->src,"none")==0) return true;
+
+	tinyxml2::XMLDocument xml_settings;
+	xml_settings.LoadFile(cfg->src);
+	tinyxml2::XMLElement* scene_element = xml_settings.FirstChildElement("scene");
+	if (scene_element==NULL) {
+		printf("error loading scene %s\n",cfg->src);
+		return false;
+	}
+
+	if(scene_element->Attribute("amoeba")!=NULL) sprintf(tree_set,"%s",scene_element->Attribute("amoeba"));
+	if(scene_element->Attribute("truth")!=NULL) sprintf(truth_file,"%s",scene_element->Attribute("truth"));
+	if(scene_element->Attribute("fiducials")!=NULL) fiducial_count = atoi(scene_element->Attribute("fiducials"));
+	if(scene_element->Attribute("fingers")!=NULL) finger_count = atoi(scene_element->Attribute("fingers"));
+	if(scene_element->Attribute("blobs")!=NULL) blob_count = atoi(scene_element->Attribute("blobs"));
+	if(scene_element->Attribute("fiducial_size")!=NULL) symbol_size = (float)atof(scene_element->Attribute("fiducial_size"));
+	if(scene_element->Attribute("finger_size")!=NULL) finger_size = (float)atof(scene_element->Attribute("finger_size"));
+	if(scene_element->Attribute("blob_size")!=NULL) blob_size = (float)atof(scene_element->Attribute("blob_size"));
+	if(scene_element->Attribute("speed")!=NULL) speed = (float)atof(scene_element->Attribute("speed"));
+	if(scene_element->Attribute("noise")!=NULL) noise = atoi(scene_element->Attribute("noise"));
+	if(scene_element->Attribute("seed")!=NULL) seed = (unsigned int)atoi(scene_element->Attribute("seed"));
+	if(scene_element->Attribute("probe")!=NULL) probe = (strcmp(scene_element->Attribute("probe"),"true")==0);
+
+	if (fiducial_count<0) fiducial_count = 0;
+	if (finger_count<0) finger_count = 0;
+	if (blob_count<0) blob_count = 0;
+	if (noise<0) noise = 0;
+	if (noise>127) noise = 127;
+	if (seed==0) seed = 1;
+	return true;
+}
+
+bool SceneCamera::readTrees() {
+
+	tree_list.clear();
+	if (strstr(tree_set,".trees")!=NULL) {
+		std::ifstream is( tree_set );
+		if( !is.good() ) {
+			printf("error opening tree file: %s\n",tree_set);
+			return false;
+		}
+		std::string s;
+		while( !is.eof() ) {
+			s.clear();
+			is >> s;
+			if( !s.empty() ) tree_list.push_back(s);
+		}
+	} else {
+		const char *tree;
+		for (int id=0; (tree=default_treestring(tree_set,id))!=NULL; id++) tree_list.push_back(tree);
+	}
+
+	if (tree_list.size()==0) {
+		printf("no amoeba trees in %s\n",tree_set);
+		return false;
+	}
+
+	if ((probe) && (tree_list.size()<2)) {
+		printf("amoeba set %s is too small for the latency probe\n",tree_set);
+		probe = false;
+	}
+	return true;
+}
+
+float SceneCamera::layoutNode(std::vector<SceneNode> &nodes, int n) {
+
+	SceneNode *node = &nodes[n];
+	int count = (int)node->children.size();
+	if (count==0) {
+		node->radius = 1.0f;
+		return node->radius;
+	}
+
+	float max_radius = 0.0f;
+	for (int i=0;i<count;i++) {
+		float radius = layoutNode(nodes, node->children[i]);
+		if (radius>max_radius) max_radius = radius;
+	}
+	node = &nodes[n];
+
+	if (count==1) {
+		nodes[node->children[0]].x = 0.0f;
+		nodes[node->children[0]].y = 0.0f;
+		node->radius = max_radius + SCENE_GAP;
+		return node->radius;
+	}
+
+	// the children are placed on a ring, which is widened until all of them fit
+	float ring = max_radius + SCENE_GAP/2.0f;
+	float sector = 0.0f;
+	for (;;) {
+		sector = 0.0f;
+		for (int i=0;i<count;i++) {
+			float extent = (nodes[node->children[i]].radius + SCENE_GAP/2.0f)/ring;
+			if (extent>1.0f) extent = 1.0f;
+			sector += 2.0f*asinf(extent);
+		}
+		if (sector<=2.0f*(float)M_PI) break;
+		ring *= 1.05f;
+	}
+
+	float slack = (2.0f*(float)M_PI - sector)/count;
+	float angle = 0.0f;
+	for (int i=0;i<count;i++) {
+		SceneNode *child = &nodes[node->children[i]];
+		float extent = asinf((child->radius + SCENE_GAP/2.0f)/ring) + slack/2.0f;
+		angle += extent;
+		child->x = ring*cosf(angle);
+		child->y = ring*sinf(angle);
+		angle += extent;
+	}
+
+	node->radius = ring + max_radius + SCENE_GAP;
+	return node->radius;
+}
+
+bool SceneCamera::buildSymbol(const char *tree, int id, SceneSymbol *symbol) {
+
+	// the tree string lists the node depths in depth first order, prefixed by the root colour
+	int root_colour = 1;
+	if (tree[0]=='b') root_colour = 0;
+	if ((tree[0]=='w') || (tree[0]=='b')) tree++;
+
+	std::vector<SceneNode> nodes;
+	std::vector<int> last;
+	for (const char *p=tree; *p; p++) {
+		int depth = *p - '0';
+		if ((depth<0) || (depth>9) || (depth>(int)last.size())) return false;
+		if ((depth==0) != nodes.empty()) return false;
+
+		SceneNode node;
+		node.depth = depth;
+		node.colour = root_colour ^ (depth&1);
+		node.parent = (depth>0) ? last[depth-1] : -1;
+		node.x = node.y = 0.0f;
+		node.radius = 1.0f;
+
+		int index = (int)nodes.size();
+		nodes.push_back(node);
+		if (node.parent>=0) nodes[node.parent].children.push_back(index);
+		last.resize(depth);
+		last.push_back(index);
+	}
+	if (nodes.size()<2) return false;
+
+	layoutNode(nodes, 0);
+
+	symbol->id = id;
+	symbol->radius = nodes[0].radius;
+	symbol->disks.clear();
+
+	// a black root needs a bright margin to be separated from the dark surface
+	if (root_colour==0) {
+		SceneDisk margin = { 0.0f, 0.0f, nodes[0].radius + SCENE_GAP*1.5f, 1, -1, false };
+		symbol->disks.push_back(margin);
+		symbol->radius = margin.radius;
+	}
+
+	// the parents are listed before their children, so their positions are already absolute
+	for (unsigned int i=0;i<nodes.size();i++) {
+		if (nodes[i].parent>=0) {
+			nodes[i].x += nodes[nodes[i].parent].x;
+			nodes[i].y += nodes[nodes[i].parent].y;
+		}
+		SceneDisk disk = { nodes[i].x, nodes[i].y, nodes[i].radius, nodes[i].colour, nodes[i].depth, nodes[i].children.empty() };
+		symbol->disks.push_back(disk);
+	}
+	return true;
+}
+
+// the orientation the tracker reports for the unrotated symbol
+float SceneCamera::symbolAngle(SceneSymbol *symbol) {
+
+	double all_x = 0, all_y = 0, all_w = 0;
+	double black_x = 0, black_y = 0, black_w = 0;
+	for (unsigned int j=0;j<symbol->disks.size();j++) {
+		SceneDisk *disk = &symbol->disks[j];
+		if (!disk->leaf) continue;
+		double w = (0.5+disk->depth)*(0.5+disk->depth);
+		all_x += disk->x*w; all_y += disk->y*w; all_w += w;
+		if (disk->colour==0) { black_x += disk->x*w; black_y += disk->y*w; black_w += w; }
+	}
+
+	if ((all_w==0) || (black_w==0)) return 0.0f;
+	return (float)leafAngle(all_x/all_w-black_x/black_w,all_y/all_w-black_y/black_w);
+}
+
+unsigned int SceneCamera::random() {
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+void SceneCamera::setupItems() {
+
+	random_state = seed;
+	symbol_list.clear();
+	item_list.clear();
+
+	// the last symbol of the amoeba set is reserved for the probe fiducial
+	int tree_count = (int)tree_list.size();
+	if (probe) tree_count--;
+
+	float max_size = 0.0f;
+	if (probe) {
+		SceneItem item;
+		item.type = SCENE_PROBE;
+		item.id = -1;
+		item.symbol = -1;
+		item.width = item.height = symbol_size;
+		item_list.push_back(item);
+		max_size = symbol_size;
+	}
+
+	for (int i=0;i<fiducial_count;i++) {
+		int id = i%tree_count;
+		if (i<tree_count) {
+			SceneSymbol symbol;
+			if (!buildSymbol(tree_list[id].c_str(), id, &symbol)) {
+				printf("invalid amoeba tree %s\n",tree_list[id].c_str());
+				continue;
+			}
+			symbol_list.push_back(symbol);
+		}
+		if (symbol_list.size()==0) break;
+
+		SceneItem item;
+		item.type = SCENE_OBJECT;
+		item.symbol = i%(int)symbol_list.size();
+		item.id = symbol_list[item.symbol].id;
+		item.width = item.height = symbol_size;
+		item_list.push_back(item);
+	}
+	if (fiducial_count>0) max_size = symbol_size;
+
+	if (probe) {
+		SceneSymbol symbol;
+		if (buildSymbol(tree_list[tree_count].c_str(), tree_count, &symbol)) {
+			probe_symbol = (int)symbol_list.size();
+			symbol_list.push_back(symbol);
+		} else {
+			printf("invalid amoeba tree %s\n",tree_list[tree_count].c_str());
+			probe = false;
+			item_list.erase(item_list.begin());
+		}
+	}
+
+	for (int i=0;i<finger_count;i++) {
+		SceneItem item;
+		item.type = SCENE_CURSOR;
+		item.id = i;
+		item.symbol = -1;
+		// a fingertip touches the surface with an elongated contact area
+		item.width = finger_size;
+		item.height = finger_size*0.75f;
+		item_list.push_back(item);
+	}
+	if ((finger_count>0) && (finger_size>max_size)) max_size = finger_size;
+
+	for (int i=0;i<blob_count;i++) {
+		SceneItem item;
+		item.type = SCENE_BLOB;
+		item.id = i;
+		item.symbol = -1;
+		item.width = blob_size;
+		item.height = blob_size/2.0f;
+		item_list.push_back(item);
+	}
+	if ((blob_count>0) && (blob_size>max_size)) max_size = blob_size;
+
+	if (item_list.size()==0) return;
+
+	// each item moves within its own grid cell, so that items never overlap
+	float cell_size = max_size*2.0f;
+	int columns = (int)(cfg->cam_width/cell_size);
+	int rows = (int)(cfg->cam_height/cell_size);
+	if (columns*rows<(int)item_list.size()) {
+		printf("scene only fits %d of %d items\n",columns*rows,(int)item_list.size());
+		item_list.resize(columns*rows);
+	}
+
+	std::vector<int> cells;
+	for (int i=0;i<columns*rows;i++) cells.push_back(i);
+	for (int i=(int)cells.size()-1;i>0;i--) std::swap(cells[i],cells[random()%(i+1)]);
+
+	float x_offset = (cfg->cam_width - columns*cell_size)/2.0f + cell_size/2.0f;
+	float y_offset = (cfg->cam_height - rows*cell_size)/2.0f + cell_size/2.0f;
+	for (unsigned int i=0;i<item_list.size();i++) {
+		SceneItem *item = &item_list[i];
+		float item_size = (item->width>item->height) ? item->width : item->height;
+		item->cell_x = x_offset + (cells[i]%columns)*cell_size;
+		item->cell_y = y_offset + (cells[i]/columns)*cell_size;
+		item->orbit = (cell_size - item_size)/2.0f * 0.8f;
+		item->phase = randomFloat()*2.0f*(float)M_PI;
+		item->speed = (0.5f+randomFloat())*speed;
+		if (random()&1) item->speed = -item->speed;
+		item->angle = randomFloat()*2.0f*(float)M_PI;
+		item->spin = (randomFloat()*2.0f-1.0f)*speed;
+
+		// the probe fiducial stays in place and turns by one code step per frame,
+		// starting from the orientation at which the tracker reports an angle of zero
+		if (item->type==SCENE_PROBE) {
+			item->orbit = 0.0f;
+			item->angle = -symbolAngle(&symbol_list[probe_symbol]);
+			item->spin = 2.0f*(float)M_PI/PROBE_CODES*cfg->cam_fps;
+		}
+	}
+
+	if (probe) {
+		for (int i=0;i<PROBE_CODES;i++) probe_time[i] = -1;
+		probe_id = tree_count;
+	}
+}
+
+bool SceneCamera::initCamera() {
+
+	if (!readScene()) return false;
+	if (((fiducial_count>0) || (probe)) && (!readTrees())) return false;
+
+	if (cfg->cam_width==SETTING_MAX) cfg->cam_width = 1920;
+	else if ((cfg->cam_width==SETTING_MIN) || (cfg->cam_width<=0)) cfg->cam_width = 640;
+	if (cfg->cam_height==SETTING_MAX) cfg->cam_height = 1080;
+	else if ((cfg->cam_height==SETTING_MIN) || (cfg->cam_height<=0)) cfg->cam_height = 480;
+	if (cfg->cam_fps==SETTING_MIN) cfg->cam_fps = 15;
+	else if ((cfg->cam_fps==SETTING_MAX) || (cfg->cam_fps<=0)) cfg->cam_fps = 60;
+	cfg->cam_format = FORMAT_GRAY;
+	cfg->frame = false;
+
+	setupItems();
+
+	int size = cfg->cam_width*cfg->cam_height;
+	cam_buffer = new unsigned char[size*cfg->buf_format];
+	if (cfg->buf_format!=FORMAT_GRAY) scene_buffer = new unsigned char[size];
+
+	if (noise>0) {
+		// the noise is taken from a random offset of a precomputed table for each frame
+		noise_buffer = new signed char[size+NOISE_RANGE];
+		for (int i=0;i<size+NOISE_RANGE;i++) noise_buffer[i] = (signed char)((int)(random()%(noise+1)) + (int)(random()%(noise+1)) - noise);
+	}
+
+	if (truth_file[0]!='\0') {
+		truth = fopen(truth_file,"w");
+		if (truth==NULL) printf("could not open ground truth file %s\n",truth_file);
+		else fprintf(truth,"# frame time type id x y angle width height\n");
+	}
+
+	setupFrame();
+	return true;
+}
+
+void SceneCamera::drawDisk(float x, float y, float radius, unsigned char value) {
+
+	unsigned char *buffer = scene_buffer ? scene_buffer : cam_buffer;
+	int y0 = (int)ceilf(y-radius);
+	int y1 = (int)floorf(y+radius);
+	if (y0<0) y0 = 0;
+	if (y1>cfg->cam_height-1) y1 = cfg->cam_height-1;
+
+	for (int py=y0;py<=y1;py++) {
+		float dy = py-y;
+		float dx = sqrtf(radius*radius-dy*dy);
+		int x0 = (int)ceilf(x-dx);
+		int x1 = (int)floorf(x+dx);
+		if (x0<0) x0 = 0;
+		if (x1>cfg->cam_width-1) x1 = cfg->cam_width-1;
+		if (x1>=x0) memset(buffer+py*cfg->cam_width+x0,value,x1-x0+1);
+	}
+}
+
+void SceneCamera::drawEllipse(float x, float y, float width, float height, float angle, unsigned char value) {
+
+	unsigned char *buffer = scene_buffer ? scene_buffer : cam_buffer;
+	float ca = cosf(angle);
+	float sa = sinf(angle);
+	float a2 = 4.0f/(width*width);
+	float b2 = 4.0f/(height*height);
+
+	// for each line the ellipse equation is a quadratic equation in x
+	float qa = ca*ca*a2 + sa*sa*b2;
+	float extent = sqrtf(width*width*ca*ca + height*height*sa*sa)/2.0f;
+	float y_extent = sqrtf(width*width*sa*sa + height*height*ca*ca)/2.0f;
+	int y0 = (int)ceilf(y-y_extent);
+	int y1 = (int)floorf(y+y_extent);
+	if (y0<0) y0 = 0;
+	if (y1>cfg->cam_height-1) y1 = cfg->cam_height-1;
+
+	for (int py=y0;py<=y1;py++) {
+		float dy = py-y;
+		float qb = 2.0f*dy*sa*ca*(a2-b2);
+		float qc = dy*dy*(sa*sa*a2 + ca*ca*b2) - 1.0f;
+		float d = qb*qb - 4.0f*qa*qc;
+		if (d<0) continue;
+		d = sqrtf(d);
+		int x0 = (int)ceilf(x + (-qb-d)/(2.0f*qa));
+		int x1 = (int)floorf(x + (-qb+d)/(2.0f*qa));
+		if (x0<(int)floorf(x-extent)) x0 = (int)floorf(x-extent);
+		if (x0<0) x0 = 0;
+		if (x1>cfg->cam_width-1) x1 = cfg->cam_width-1;
+		if (x1>=x0) memset(buffer+py*cfg->cam_width+x0,value,x1-x0+1);
+	}
+}
+
+void SceneCamera::renderFrame() {
+
+	unsigned char *buffer = scene_buffer ? scene_buffer : cam_buffer;
+	int size = cfg->cam_width*cfg->cam_height;
+	float time = frame_count/cfg->cam_fps;
+	memset(buffer,SCENE_DARK,size);
+
+	for (unsigned int i=0;i<item_list.size();i++) {
+		SceneItem *item = &item_list[i];
+		float x = item->cell_x + item->orbit*cosf(item->phase + item->speed*time);
+		float y = item->cell_y + item->orbit*sinf(item->phase + item->speed*time);
+		float angle = fmodf(item->angle + item->spin*time, 2.0f*(float)M_PI);
+		if (angle<0) angle += 2.0f*(float)M_PI;
+
+		if ((item->type==SCENE_OBJECT) || (item->type==SCENE_PROBE)) {
+			SceneSymbol *symbol;
+			if (item->type==SCENE_PROBE) symbol = &symbol_list[probe_symbol];
+			else symbol = &symbol_list[item->symbol];
+			float scale = item->width/2.0f/symbol->radius;
+			float ca = cosf(angle)*scale;
+			float sa = sinf(angle)*scale;
+
+			// the ground truth follows the leaf center computation of the fiducial tracker
+			double all_x = 0, all_y = 0, all_w = 0;
+			double black_x = 0, black_y = 0, black_w = 0;
+			for (unsigned int j=0;j<symbol->disks.size();j++) {
+				SceneDisk *disk = &symbol->disks[j];
+				float dx = x + disk->x*ca - disk->y*sa;
+				float dy = y + disk->x*sa + disk->y*ca;
+				drawDisk(dx, dy, disk->radius*scale, disk->colour ? SCENE_BRIGHT : SCENE_DARK);
+
+				if (disk->leaf) {
+					double w = (0.5+disk->depth)*(0.5+disk->depth);
+					all_x += dx*w; all_y += dy*w; all_w += w;
+					if (disk->colour==0) { black_x += dx*w; black_y += dy*w; black_w += w; }
+				}
+			}
+
+			if ((truth) && (all_w>0) && (black_w>0)) {
+				all_x /= all_w; all_y /= all_w;
+				black_x /= black_w; black_y /= black_w;
+				fprintf(truth,"%ld %f obj %d %f %f %f %f %f\n",frame_count,time,symbol->id,all_x/cfg->cam_width,all_y/cfg->cam_height,leafAngle(all_x-black_x,all_y-black_y),item->width/cfg->cam_width,item->height/cfg->cam_height);
+			}
+		} else if (item->type==SCENE_CURSOR) {
+			drawEllipse(x, y, item->width, item->height, angle, SCENE_BRIGHT);
+			if (truth) fprintf(truth,"%ld %f cur %d %f %f %f %f %f\n",frame_count,time,item->id,x/cfg->cam_width,y/cfg->cam_height,angle,item->width/cfg->cam_width,item->height/cfg->cam_height);
+		} else {
+			drawEllipse(x, y, item->width, item->height, angle, SCENE_BRIGHT);
+			if (truth) fprintf(truth,"%ld %f blb %d %f %f %f %f %f\n",frame_count,time,item->id,x/cfg->cam_width,y/cfg->cam_height,angle,item->width/cfg->cam_width,item->height/cfg->cam_height);
+		}
+	}
+
+	if (noise_buffer) {
+		signed char *noise_pixel = noise_buffer + random()%NOISE_RANGE;
+		for (int i=0;i<size;i++) {
+			int value = buffer[i] + noise_pixel[i];
+			buffer[i] = (unsigned char)(value<0 ? 0 : (value>255 ? 255 : value));
+		}
+	}
+
+	if (scene_buffer) gray2rgb(cfg->cam_width, cfg->cam_height, scene_buffer, cam_buffer);
+}
+
+unsigned char* SceneCamera::getFrame()
+{
+	renderFrame();
+	int code = (int)(frame_count%PROBE_CODES);
+	frame_count++;
+
+	// the frames are delivered at the configured frame rate
+	frame_time += std::chrono::microseconds((long)(1000000/cfg->cam_fps));
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (frame_time>now) std::this_thread::sleep_until(frame_time);
+	else frame_time = now;
+
+	if (probe) probe_time[code] = getProbeClock();
+	return cam_buffer;
+}
+
+bool SceneCamera::startCamera()
+{
+	frame_time = std::chrono::steady_clock::now();
+	running = true;
+	return true;
+}
+
+bool SceneCamera::stopCamera()
+{
+	running = false;
+	return true;
+}
+
+bool SceneCamera::stillRunning() {
+	return running;
+}
+
+bool SceneCamera::resetCamera()
+{
+	return (stopCamera() && startCamera());
+}
+
+void SceneCamera::setItemCount(int fiducials, int fingers, int blobs) {
+	fiducial_count = fiducials;
+	finger_count = fingers;
+	blob_count = blobs;
+}
+
+long long SceneCamera::getProbeClock() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+long long SceneCamera::getProbeTime(int symbol_id, float angle) {
+	if ((probe_id<0) || (symbol_id!=probe_id)) return -1;
+	int code = (int)floorf(angle/(2.0f*(float)M_PI)*PROBE_CODES+0.5f);
+	code = ((code%PROBE_CODES)+PROBE_CODES)%PROBE_CODES;
+	return probe_time[code];
+}
+
+bool SceneCamera::closeCamera()
+{
+	if (probe) probe_id = -1;
+	if (truth!=NULL) {
+		fclose(truth);
+		truth = NULL;
+	}
+	return true;
+}
@@ -0,0 +1,156 @@
+/*  portVideo, a cross platform camera framework
+ Copyright (C) 2005-2016 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SCENECAMERA_H
+#define SCENECAMERA_H
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <atomic>
+#include "CameraEngine.h"
+
+#define SCENE_OBJECT 0
+#define SCENE_CURSOR 1
+#define SCENE_BLOB 2
+#define SCENE_PROBE 3
+#define PROBE_CODES 16
+
+// renders a synthetic scene of amoeba fiducials, fingers and blobs moving on a noisy surface
+// the scene is described in the xml file provided as camera source, the ground truth of each frame
+// is optionally written to a text file, which allows load tests without a physical setup
+class SceneCamera : public CameraEngine
+{
+public:
+	SceneCamera(CameraConfig *cam_cfg);
+	~SceneCamera();
+
+	static CameraEngine* getCamera(CameraConfig *cam_cfg);
+	bool initCamera();
+	bool startCamera();
+	unsigned char* getFrame();
+	bool stopCamera();
+	bool stillRunning();
+	bool resetCamera();
+	bool closeCamera();
+
+	int getCameraSettingStep(int /*mode*/) { return 0; }
+	bool setCameraSettingAuto(int /*mode*/, bool /*flag*/) { return false; }
+	bool getCameraSettingAuto(int /*mode*/) { return false; }
+	bool setCameraSetting(int /*mode*/, int /*value*/) { return false; }
+	int getCameraSetting(int /*mode*/) { return 0; }
+	int getMaxCameraSetting(int /*mode*/) { return 0; }
+	int getMinCameraSetting(int /*mode*/) { return 0; }
+	bool setDefaultCameraSetting(int /*mode*/) { return false; }
+	int getDefaultCameraSetting(int /*mode*/) { return 0; }
+	bool hasCameraSetting(int /*mode*/) { return false; }
+	bool hasCameraSettingAuto(int /*mode*/) { return false; }
+
+	bool showSettingsDialog(bool lock) { return lock; }
+	void control(unsigned char /*key*/) {};
+
+	// sets the item counts of the default scene, which is used without a scene file
+	void setItemCount(int fiducials, int fingers, int blobs);
+
+	// the probe fiducial shows the last symbol of the amoeba set, turned by one of the probe codes in each frame,
+	// these return the delivery time of the latest frame showing the reported orientation, and the current time of the same clock
+	static long long getProbeTime(int symbol_id, float angle);
+	static long long getProbeClock();
+
+private:
+
+	// a region of an amoeba symbol, in units of the leaf radius relative to its parent
+	struct SceneNode {
+		int parent;
+		int depth;
+		int colour;
+		float x, y;
+		float radius;
+		std::vector<int> children;
+	};
+
+	// a disk of an amoeba symbol, in units of the leaf radius relative to the symbol center
+	struct SceneDisk {
+		float x, y;
+		float radius;
+		int colour;
+		int depth;
+		bool leaf;
+	};
+
+	struct SceneSymbol {
+		int id;
+		float radius;
+		std::vector<SceneDisk> disks;
+	};
+
+	struct SceneItem {
+		int type;
+		int id;
+		int symbol;
+		float width, height;
+		float cell_x, cell_y;
+		float orbit, phase, speed;
+		float angle, spin;
+	};
+
+	bool readScene();
+	bool readTrees();
+	bool buildSymbol(const char *tree, int id, SceneSymbol *symbol);
+	float layoutNode(std::vector<SceneNode> &nodes, int n);
+	float symbolAngle(SceneSymbol *symbol);
+	void setupItems();
+	void renderFrame();
+	void drawDisk(float x, float y, float radius, unsigned char value);
+	void drawEllipse(float x, float y, float width, float height, float angle, unsigned char value);
+	unsigned int random();
+	float randomFloat() { return (random()&0xFFFFFF)/(float)0x1000000; };
+
+	char tree_set[256];
+	char truth_file[256];
+	int fiducial_count;
+	int finger_count;
+	int blob_count;
+	float symbol_size;
+	float finger_size;
+	float blob_size;
+	float speed;
+	int noise;
+	unsigned int seed;
+	unsigned int random_state;
+	bool probe;
+	int probe_symbol;
+
+	std::vector<std::string> tree_list;
+	std::vector<SceneSymbol> symbol_list;
+	std::vector<SceneItem> item_list;
+
+	unsigned char *scene_buffer;
+	signed char *noise_buffer;
+	int noise_offset;
+	FILE *truth;
+	long frame_count;
+	std::chrono::steady_clock::time_point frame_time;
+
+	static std::atomic<long long> probe_time[PROBE_CODES];
+	static std::atomic<int> probe_id;
+};
+
+#endif
@@ -39,6 +39,11 @@ static DWORD WINAPI getFrameFromCamera( LPVOID obj )
             cameraBuffer = engine->camera_->getFrame();
             if (cameraBuffer!=NULL) {
                 cameraWriteBuffer = engine->ringBuffer->getNextBufferToWrite();
+                // a limited frame sequence waits for the next free buffer instead of dropping the frame
+                while ((cameraWriteBuffer==NULL) && (engine->frame_limit_>0) && (engine->running_)) {
+                    pv_sleep();
+                    cameraWriteBuffer = engine->ringBuffer->getNextBufferToWrite();
+                }
                 if (cameraWriteBuffer!=NULL) {
                     memcpy(cameraWriteBuffer,cameraBuffer,engine->ringBuffer->size());
                     engine->framenumber_++;
@@ -193,6 +198,7 @@ void VisionEngine::stopThread() {
 void VisionEngine::mainLoop()
 {
     unsigned char* cameraReadBuffer = NULL;
+    long processed_frames = 0;
     
     while(running_) {
         
@@ -227,6 +233,9 @@ void VisionEngine::mainLoop()
             memcpy(sourceBuffer_,cameraReadBuffer,ringBuffer->size());
         ringBuffer->readFinished();
         
+        processed_frames++;
+        if ((frame_limit_>0) && (processed_frames>=frame_limit_)) stop();
+        
 #ifndef NDEBUG
         if (recording_) {
 			if (interface_->getDisplayMode()==SOURCE_DISPLAY)
@@ -410,6 +419,7 @@ VisionEngine::VisionEngine(const char* name, application_settings *config)
 , current_fps_( 0 )
 , camera_ (NULL)
 , framenumber_( 0 )
+, frame_limit_( 0 )
 #ifndef NDEBUG
 , recording_( false )
 #endif
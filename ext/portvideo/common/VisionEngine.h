@@ -79,7 +79,11 @@ public:
 	void addFrameProcessor(FrameProcessor *fp);
 	void removeFrameProcessor(FrameProcessor *fp);
 
+	// with a frame limit no camera frame is dropped and the engine stops after the given number of frames
+	void setFrameLimit(long frames) { frame_limit_ = frames; };
+
 	long framenumber_;
+	long frame_limit_;
 
     static long currentSeconds() {
         time_t currentTime;
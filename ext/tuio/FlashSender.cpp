@@ -639,12 +639,12 @@ bool FlashSender::isConnected() {
 	else return false;
 }
 
-bool FlashSender::sendOscPacket (osc::OutboundPacketStream *bundle) {
+bool FlashSender::sendOscData (const char *data, unsigned int size) {
 	if (lcConnection==NULL) return false;
 	if (!TFLCSConnectionHasConnectedClient(lcConnection)) return false; 
-	if ( bundle->Size() > buffer_size ) return false;
-	if ( bundle->Size() == 0 ) return false;
+	if ( size > buffer_size ) return false;
+	if ( size == 0 ) return false;
 
-	TFLCSSendByteArray(lcConnection, bundle->Data(), bundle->Size());
+	TFLCSSendByteArray(lcConnection, data, size);
 	return true;
 }
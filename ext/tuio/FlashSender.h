@@ -193,11 +193,12 @@ namespace TUIO {
 		/**
 		 * This method delivers the provided OSC data
 		 *
-		 * @param *bundle  the OSC stream to deliver
+		 * @param *data  the OSC packet data to deliver
+		 * @param size  the OSC packet size in bytes
 		 * @return true if the data was delivered successfully
 		 */
 		
-		bool sendOscPacket (osc::OutboundPacketStream *bundle);
+		bool sendOscData (const char *data, unsigned int size);
 
 		/**
 		 * This method returns the connection state
@@ -0,0 +1,45 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#include "OscMessageTemplate.h"
+#include <iostream>
+
+using namespace TUIO;
+
+OscMessageTemplate::OscMessageTemplate(const char *address, const char *command, const char *types) {
+
+	// compose the message once with the regular stream, so the layout is identical by definition
+	osc::OutboundPacketStream stream(message_data, MAX_TEMPLATE_SIZE);
+	stream << osc::BeginMessage(address) << command;
+
+	unsigned int count = (unsigned int)strlen(types);
+	for (unsigned int i=0;i<count;i++) {
+		switch (types[i]) {
+			case 'i': stream << (osc::int32)0; break;
+			case 'f': stream << 0.0f; break;
+			default:
+				std::cerr << "unsupported OSC template type: " << types[i] << std::endl;
+				throw std::exception();
+		}
+	}
+	stream << osc::EndMessage;
+
+	message_size = (unsigned int)stream.Size();
+	// all template arguments are four bytes and follow the command string
+	argument_data = message_data + message_size - 4*count;
+}
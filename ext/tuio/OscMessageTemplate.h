@@ -0,0 +1,117 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#ifndef INCLUDED_OSCMESSAGETEMPLATE_H
+#define INCLUDED_OSCMESSAGETEMPLATE_H
+
+#include "LibExport.h"
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscHostEndianness.h"
+#include <cstring>
+
+#define MAX_TEMPLATE_SIZE 128
+
+namespace TUIO {
+
+	/**
+	 * The OscMessageTemplate keeps a preformatted OSC message with a fixed address, command and argument layout.
+	 * Only the big-endian argument slots are patched for each message, before the message is appended
+	 * to an OSC bundle as a whole. The resulting data is identical to the message composed argument by argument.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL OscMessageTemplate {
+
+	public:
+
+		/**
+		 * This constructor preformats the OSC message
+		 *
+		 * @param  address  the OSC address pattern
+		 * @param  command  the leading string argument
+		 * @param  types  the type tags of the following arguments, either 'i' or 'f'
+		 */
+		OscMessageTemplate(const char *address, const char *command, const char *types);
+
+		/**
+		 * Sets the int32 argument at the provided index
+		 *
+		 * @param  index  the argument index following the command
+		 * @param  value  the argument value
+		 */
+		void setInt32(int index, osc::int32 value) {
+			writeSlot(index, (osc::uint32)value);
+		};
+
+		/**
+		 * Sets the float argument at the provided index
+		 *
+		 * @param  index  the argument index following the command
+		 * @param  value  the argument value
+		 */
+		void setFloat(int index, float value) {
+			osc::uint32 bits;
+			memcpy(&bits, &value, 4);
+			writeSlot(index, bits);
+		};
+
+		/**
+		 * Appends the current message to the provided OSC packet
+		 *
+		 * @param  packet  the OSC packet with an open bundle
+		 */
+		void appendTo(osc::OutboundPacketStream *packet) {
+			packet->AppendMessage(message_data, message_size);
+		};
+
+		/**
+		 * Returns the size of the preformatted message in bytes
+		 *
+		 * @return the size of the preformatted message in bytes
+		 */
+		unsigned int getSize() { return message_size; };
+
+		/**
+		 * Returns the preformatted message data
+		 *
+		 * @return the preformatted message data
+		 */
+		const char* getData() { return message_data; };
+
+	private:
+
+		void writeSlot(int index, osc::uint32 value) {
+			char *slot = argument_data + 4*index;
+#ifdef OSC_HOST_LITTLE_ENDIAN
+			slot[0] = (char)(value >> 24);
+			slot[1] = (char)(value >> 16);
+			slot[2] = (char)(value >> 8);
+			slot[3] = (char)(value);
+#else
+			memcpy(slot, &value, 4);
+#endif
+		};
+
+		char message_data[MAX_TEMPLATE_SIZE];
+		char *argument_data;
+		unsigned int message_size;
+	};
+}
+
+#endif /* INCLUDED_OSCMESSAGETEMPLATE_H */
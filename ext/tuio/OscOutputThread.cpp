@@ -0,0 +1,233 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#include "OscOutputThread.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace TUIO;
+
+// the packet slots are filled by the queueing thread only and emptied by the output thread only,
+// head and tail are free running counters, which are published with release/acquire semantics.
+// the output thread announces that it is waiting before checking the queue a last time,
+// so the queueing thread only needs to wake it up for a packet that arrives while it is waiting
+struct OscOutputThread::OscPacketQueue {
+	OscSender *sender;
+	char *packet_data;
+	unsigned int *packet_size;
+	unsigned int slot_size;
+	unsigned int slot_count;
+	std::atomic<unsigned int> head;
+	std::atomic<unsigned int> tail;
+	std::atomic<unsigned long> dropped;
+	std::atomic<bool> waiting;
+
+	bool running;
+#ifdef WIN32
+	HANDLE output_thread;
+	HANDLE output_event;
+#else
+	pthread_t output_thread;
+	pthread_mutex_t output_mutex;
+	pthread_cond_t output_cond;
+#endif
+};
+
+static void deliverQueuedPackets(OscOutputThread::OscPacketQueue *queue) {
+
+	unsigned int tail = queue->tail.load(std::memory_order_relaxed);
+	while (tail!=queue->head.load(std::memory_order_acquire)) {
+		unsigned int slot = tail%queue->slot_count;
+		queue->sender->sendOscData(&queue->packet_data[slot*queue->slot_size], queue->packet_size[slot]);
+		queue->tail.store(++tail,std::memory_order_release);
+	}
+}
+
+#ifdef  WIN32
+static DWORD WINAPI OutputThreadFunc( LPVOID obj )
+#else
+static void* OutputThreadFunc( void* obj )
+#endif
+{
+	OscOutputThread::OscPacketQueue *queue = static_cast<OscOutputThread::OscPacketQueue*>(obj);
+
+	bool active = true;
+	while (active) {
+#ifdef WIN32
+		queue->waiting.store(true);
+		if (queue->running && (queue->tail.load(std::memory_order_relaxed)==queue->head.load())) WaitForSingleObject(queue->output_event,INFINITE);
+		queue->waiting.store(false,std::memory_order_relaxed);
+		active = queue->running;
+#else
+		pthread_mutex_lock(&queue->output_mutex);
+		queue->waiting.store(true);
+		while (queue->running && (queue->tail.load(std::memory_order_relaxed)==queue->head.load())) pthread_cond_wait(&queue->output_cond,&queue->output_mutex);
+		queue->waiting.store(false,std::memory_order_relaxed);
+		active = queue->running;
+		pthread_mutex_unlock(&queue->output_mutex);
+#endif
+		// also delivers the remaining packets before leaving
+		deliverQueuedPackets(queue);
+	}
+
+	return 0;
+};
+
+static void signalOutputThread(OscOutputThread::OscPacketQueue *queue) {
+#ifdef WIN32
+	SetEvent(queue->output_event);
+#else
+	pthread_mutex_lock(&queue->output_mutex);
+	pthread_cond_signal(&queue->output_cond);
+	pthread_mutex_unlock(&queue->output_mutex);
+#endif
+}
+
+static void stopOutputThread(OscOutputThread::OscPacketQueue *queue) {
+#ifdef WIN32
+	queue->running = false;
+	SetEvent(queue->output_event);
+#else
+	pthread_mutex_lock(&queue->output_mutex);
+	queue->running = false;
+	pthread_cond_signal(&queue->output_cond);
+	pthread_mutex_unlock(&queue->output_mutex);
+#endif
+}
+
+OscOutputThread::OscOutputThread(unsigned int size)
+	:queue_count	(0)
+	,queue_size		(size)
+{
+	if (queue_size<1) queue_size = 1;
+}
+
+OscOutputThread::~OscOutputThread() {
+
+	unsigned int count = queue_count.load();
+	for (unsigned int i=0;i<count;i++) {
+		OscPacketQueue *queue = queue_list[i];
+		stopOutputThread(queue);
+#ifdef WIN32
+		WaitForSingleObject(queue->output_thread,INFINITE);
+		CloseHandle(queue->output_thread);
+		CloseHandle(queue->output_event);
+#else
+		pthread_join(queue->output_thread,NULL);
+		pthread_cond_destroy(&queue->output_cond);
+		pthread_mutex_destroy(&queue->output_mutex);
+#endif
+		delete[] queue->packet_data;
+		delete[] queue->packet_size;
+		delete queue;
+	}
+}
+
+bool OscOutputThread::addOscSender(OscSender *sender) {
+
+	unsigned int count = queue_count.load(std::memory_order_relaxed);
+	if (count==MAX_OSC_SENDERS) return false;
+
+	OscPacketQueue *queue = new OscPacketQueue();
+	queue->sender = sender;
+	queue->slot_size = sender->getMaxPacketSize();
+	queue->slot_count = queue_size;
+	queue->packet_data = new char[queue->slot_count*queue->slot_size];
+	queue->packet_size = new unsigned int[queue->slot_count];
+	queue->head.store(0);
+	queue->tail.store(0);
+	queue->dropped.store(0);
+	queue->waiting.store(false);
+	queue->running = true;
+
+#ifdef WIN32
+	queue->output_event = CreateEvent(NULL,FALSE,FALSE,NULL);
+	DWORD threadId;
+	queue->output_thread = CreateThread( 0, 0, OutputThreadFunc, queue, 0, &threadId );
+	bool started = (queue->output_thread!=NULL);
+	if (!started) CloseHandle(queue->output_event);
+#else
+	pthread_mutex_init(&queue->output_mutex,NULL);
+	pthread_cond_init(&queue->output_cond,NULL);
+	bool started = (pthread_create(&queue->output_thread, NULL, OutputThreadFunc, queue)==0);
+	if (!started) {
+		pthread_cond_destroy(&queue->output_cond);
+		pthread_mutex_destroy(&queue->output_mutex);
+	}
+#endif
+
+	if (!started) {
+		std::cerr << "could not start " << sender->tuio_type() << " output thread" << std::endl;
+		delete[] queue->packet_data;
+		delete[] queue->packet_size;
+		delete queue;
+		return false;
+	}
+
+	queue_list[count] = queue;
+	queue_count.store(count+1,std::memory_order_release);
+	return true;
+}
+
+void OscOutputThread::queueOscPacket(osc::OutboundPacketStream *packet, OscSender *sender) {
+
+	unsigned int size = (unsigned int)packet->Size();
+	if (size==0) return;
+
+	unsigned int count = queue_count.load(std::memory_order_relaxed);
+	for (unsigned int i=0;i<count;i++) {
+		OscPacketQueue *queue = queue_list[i];
+		if ((sender) && (queue->sender!=sender)) continue;
+		if (size>queue->slot_size) continue;
+
+		unsigned int head = queue->head.load(std::memory_order_relaxed);
+		if (head-queue->tail.load(std::memory_order_acquire)>=queue->slot_count) {
+			queue->dropped.fetch_add(1,std::memory_order_relaxed);
+			continue;
+		}
+
+		unsigned int slot = head%queue->slot_count;
+		memcpy(&queue->packet_data[slot*queue->slot_size], packet->Data(), size);
+		queue->packet_size[slot] = size;
+		queue->head.store(head+1);
+		if (queue->waiting.load()) signalOutputThread(queue);
+	}
+}
+
+unsigned long OscOutputThread::getDroppedPackets(OscSender *sender) {
+
+	unsigned int count = queue_count.load(std::memory_order_acquire);
+	for (unsigned int i=0;i<count;i++) {
+		if (queue_list[i]->sender==sender) return queue_list[i]->dropped.load(std::memory_order_relaxed);
+	}
+	return 0;
+}
+
+unsigned long OscOutputThread::getDroppedPackets() {
+
+	unsigned long dropped = 0;
+	unsigned int count = queue_count.load(std::memory_order_acquire);
+	for (unsigned int i=0;i<count;i++) {
+		dropped += queue_list[i]->dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
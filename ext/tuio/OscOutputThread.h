@@ -0,0 +1,108 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#ifndef INCLUDED_OSCOUTPUTTHREAD_H
+#define INCLUDED_OSCOUTPUTTHREAD_H
+
+#include "OscSender.h"
+#include <atomic>
+
+#define MAX_OSC_SENDERS 32
+#define DEFAULT_OSC_QUEUE_SIZE 32
+
+namespace TUIO {
+
+	/**
+	 * The OscOutputThread delivers OSC packets to the attached OscSenders from dedicated output threads.
+	 * Each OscSender is fed by its own output thread through a bounded single producer / single consumer
+	 * packet queue, so a slow or stalled connection only causes packets to be dropped for that OscSender,
+	 * while the thread queueing the packets never has to wait for the network.
+	 * Queueing a packet only takes the lock of an output thread to wake it up when it is waiting for packets.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL OscOutputThread {
+
+	public:
+
+		/**
+		 * This constructor creates an output thread without any attached OscSender
+		 *
+		 * @param  queue_size  the maximum number of pending packets per OscSender
+		 */
+		OscOutputThread(unsigned int queue_size=DEFAULT_OSC_QUEUE_SIZE);
+
+		/**
+		 * The destructor delivers all pending packets and stops the output threads.
+		 * The attached OscSenders are not deleted.
+		 */
+		~OscOutputThread();
+
+		/**
+		 * Attaches an OscSender and starts its output thread.
+		 * This method and queueOscPacket need to be called from the same thread.
+		 *
+		 * @param  sender  the OscSender to attach
+		 * @return true if the OscSender could be attached
+		 */
+		bool addOscSender(OscSender *sender);
+
+		/**
+		 * Copies the provided OSC packet into the queue of each attached OscSender,
+		 * or only into the queue of the provided OscSender.
+		 * The packet is dropped for all OscSenders with a full queue.
+		 *
+		 * @param  packet  the OSC packet to deliver
+		 * @param  sender  the only receiving OscSender, or NULL for all attached OscSenders
+		 */
+		void queueOscPacket(osc::OutboundPacketStream *packet, OscSender *sender=NULL);
+
+		/**
+		 * Returns the number of packets dropped for the provided OscSender
+		 *
+		 * @param  sender  the attached OscSender
+		 * @return the number of packets dropped for the provided OscSender
+		 */
+		unsigned long getDroppedPackets(OscSender *sender);
+
+		/**
+		 * Returns the number of packets dropped for all attached OscSenders
+		 *
+		 * @return the number of packets dropped for all attached OscSenders
+		 */
+		unsigned long getDroppedPackets();
+
+		/**
+		 * Returns the maximum number of pending packets per OscSender
+		 *
+		 * @return the maximum number of pending packets per OscSender
+		 */
+		unsigned int getQueueSize() { return queue_size; };
+
+		struct OscPacketQueue;
+
+	private:
+
+		OscPacketQueue *queue_list[MAX_OSC_SENDERS];
+		std::atomic<unsigned int> queue_count;
+		unsigned int queue_size;
+	};
+}
+
+#endif /* INCLUDED_OSCOUTPUTTHREAD_H */
@@ -54,8 +54,19 @@ namespace TUIO {
 		 * @param *bundle  the OSC stream to deliver
 		 * @return true if the data was delivered successfully
 		 */
-		virtual bool sendOscPacket (osc::OutboundPacketStream *bundle) = 0;
-		
+		virtual bool sendOscPacket (osc::OutboundPacketStream *bundle) {
+			return sendOscData(bundle->Data(), (unsigned int)bundle->Size());
+		}
+
+		/**
+		 * This method delivers the provided raw OSC packet data
+		 *
+		 * @param *data  the OSC packet data to deliver
+		 * @param size  the OSC packet size in bytes
+		 * @return true if the data was delivered successfully
+		 */
+		virtual bool sendOscData (const char *data, unsigned int size) = 0;
+
 		/**
 		 * This method returns the connection state
 		 *
@@ -63,6 +74,14 @@ namespace TUIO {
 		 */
 		virtual bool isConnected () = 0;
 
+		/**
+		 * This method returns true once after a new client has connected,
+		 * which then needs to receive the complete current state
+		 *
+		 * @return true if a new client has connected since the last call
+		 */
+		virtual bool hasNewClient () { return false; };
+
 		/**
 		 * This method returns if this OscSender delivers locally
 		 *
@@ -76,6 +95,14 @@ namespace TUIO {
 		 * @return the maximum bundle size in bytes
 		 */
 		int getBufferSize () { return buffer_size; };
+
+		/**
+		 * This method returns the largest packet size in bytes this OscSender is able to deliver,
+		 * which is only used for complete frames that do not fit into the regular bundle size
+		 *
+		 * @return the largest deliverable packet size in bytes
+		 */
+		virtual int getMaxPacketSize () { return buffer_size; };
 	
 		virtual const char* tuio_type() = 0;
 		
@@ -0,0 +1,85 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#ifndef INCLUDED_OSCSOURCE_H
+#define INCLUDED_OSCSOURCE_H
+
+#include "LibExport.h"
+#include "ip/PacketListener.h"
+#include "ip/NetworkingUtils.h"
+#include <iostream>
+#include <cstring>
+
+namespace TUIO {
+
+	/**
+	 * The OscSource class is the base class for the various OSC transport methods such as UDP, TCP ...
+	 * It receives the OSC packets in its own thread and passes them to its PacketListener.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL OscSource {
+
+	public:
+
+		/**
+		 * The constructor is doing nothing in particular.
+		 */
+		OscSource (): listener(NULL) {};
+
+		/**
+		 * The destructor is doing nothing in particular.
+		 */
+		virtual ~OscSource() {};
+
+		/**
+		 * This method sets the PacketListener receiving all OSC packets,
+		 * it needs to be called before the receiver is connected
+		 *
+		 * @param  listener  the PacketListener receiving all OSC packets
+		 */
+		void setPacketListener(PacketListener *listener) { this->listener = listener; };
+
+		/**
+		 * This method starts the receiver thread
+		 *
+		 * @return true if the receiver thread has been started
+		 */
+		virtual bool connect() = 0;
+
+		/**
+		 * This method stops the receiver thread
+		 */
+		virtual void disconnect() = 0;
+
+		/**
+		 * This method returns the connection state
+		 *
+		 * @return true if the receiver is connected to its source
+		 */
+		virtual bool isConnected() = 0;
+
+		virtual const char* tuio_type() = 0;
+
+	protected:
+		PacketListener *listener;
+	};
+}
+#endif /* INCLUDED_OSCSOURCE_H */
@@ -17,35 +17,53 @@
 */
 
 #include "TcpSender.h"
-using namespace TUIO;
+#include <errno.h>
+#ifdef LINUX
+#include <sys/epoll.h>
+#endif
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/select.h>
+#endif
+#include <vector>
 
-#ifdef  WIN32
-static DWORD WINAPI ClientThreadFunc( LPVOID obj )
-#else
-static void* ClientThreadFunc( void* obj )
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
 #endif
-{
-	TcpSender *sender = static_cast<TcpSender*>(obj);
-	char buf[16];
-			
+#define MAX_TCP_EVENTS 64
+
+using namespace TUIO;
+
 #ifdef WIN32
-	SOCKET client = sender->tcp_client_list.back();
+static void setNonBlocking( SOCKET socket ) {
+	u_long mode = 1;
+	ioctlsocket(socket, FIONBIO, &mode);
+}
+
+static void closeSocket( SOCKET socket ) {
+	closesocket(socket);
+}
+
+static bool wouldBlock() {
+	return (WSAGetLastError()==WSAEWOULDBLOCK);
+}
 #else
-	int client = sender->tcp_client_list.back();
+static void setNonBlocking( int socket ) {
+	fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK);
+#ifdef __APPLE__
+	int optval = 1;
+	setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, (void *)&optval, sizeof(int));
 #endif
-	
-	size_t connected = 1;
-	while (connected) {
-		connected = recv(client, buf, sizeof(buf),0);
-	}
-		
-	sender->tcp_client_list.remove(client);
-	std::cout << sender->tuio_type() << " connection closed"<< std::endl;
-	if (sender->tcp_client_list.size()==0) sender->connected=false;
-	//std::cout << sender->tcp_client_list.size() << " clients left"<< std::endl;	
+}
 
-	return 0;
-};
+static void closeSocket( int socket ) {
+	close(socket);
+}
+
+static bool wouldBlock() {
+	return ((errno==EAGAIN) || (errno==EWOULDBLOCK) || (errno==EINTR));
+}
+#endif
 
 #ifdef  WIN32
 static DWORD WINAPI ServerThreadFunc( LPVOID obj )
@@ -53,49 +71,34 @@ static DWORD WINAPI ServerThreadFunc( LPVOID obj )
 static void* ServerThreadFunc( void* obj )
 #endif
 {
-	TcpSender *sender = static_cast<TcpSender*>(obj);
-	struct sockaddr_in client_addr;
-	socklen_t len = sizeof(client_addr);
-	
-	std::cout << sender->tuio_type() << " socket created on port " << sender->port_no << std::endl;
-	while (sender->tcp_socket) {
-#ifdef WIN32
-		SOCKET tcp_client = -1;
-#else
-		int tcp_client = -1;
-#endif
-		
-		tcp_client = accept(sender->tcp_socket, (struct sockaddr*)&client_addr, &len);
-#ifdef WIN32
-		 //win32 workaround on exit
-		if (!client_addr.sin_addr.S_un.S_addr && !client_addr.sin_port) return 0;
-		if ((client_addr.sin_addr.S_un.S_addr==3435973836) && (client_addr.sin_port==52428)) return 0;
+	static_cast<TcpSender*>(obj)->run();
+	return 0;
+};
+
+void TcpSender::initialize() {
+
+	tcp_server = false;
+	client_queue_size = MAX_TCP_QUEUE;
+	dropped_packets = 0;
+	sent_bytes = 0;
+	running = false;
+	new_client = false;
+	buffer_size = MAX_TCP_SIZE;
+#ifdef LINUX
+	epoll_fd = -1;
 #endif
 
-		if (tcp_client>0) { 
-			std::cout << sender->tuio_type() << " client connected from " << inet_ntoa(client_addr.sin_addr) << "@" << client_addr.sin_port << std::endl;
-			sender->tcp_client_list.push_back(tcp_client);
-			sender->connected=true;
-			sender->newClient(tcp_client);
-			//std::cout << sender->tcp_client_list.size() << " clients connected"<< std::endl;	
 #ifdef WIN32
-			DWORD ClientThreadId;
-			HANDLE client_thread = CreateThread( 0, 0, ClientThreadFunc, obj, 0, &ClientThreadId );
+	clientMutex = CreateMutex(NULL,FALSE,NULL);
 #else
-			pthread_t client_thread;
-			pthread_create(&client_thread , NULL, ClientThreadFunc,obj);
+	pthread_mutex_init(&clientMutex,NULL);
 #endif
-		} else break;
-	}
-	
-	return 0;
-};
+}
 
 TcpSender::TcpSender()
-	:connected (false)
 {
+	initialize();
 	local = true;
-	buffer_size = MAX_TCP_SIZE;
 	
 	tcp_socket = socket( AF_INET, SOCK_STREAM, IPPROTO_TCP );
 	if (tcp_socket < 0) {
@@ -103,41 +106,30 @@ TcpSender::TcpSender()
 		return;
 	}
 	
-	struct sockaddr_in tcp_server;
-	memset( &tcp_server, 0, sizeof (tcp_server));
-	//unsigned long addr = inet_addr("127.0.0.1");
-	//memcpy( (char *)&tcp_server.sin_addr, &addr, sizeof(addr));
+	struct sockaddr_in tcp_server_addr;
+	memset( &tcp_server_addr, 0, sizeof (tcp_server_addr));
 	
-	tcp_server.sin_family = AF_INET;
-	tcp_server.sin_port = htons(3333);
-	tcp_server.sin_addr.s_addr = inet_addr("127.0.0.1");
+	tcp_server_addr.sin_family = AF_INET;
+	tcp_server_addr.sin_port = htons(3333);
+	tcp_server_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
 	
-	int ret = connect(tcp_socket,(struct sockaddr*)&tcp_server,sizeof(tcp_server));
+	int ret = connect(tcp_socket,(struct sockaddr*)&tcp_server_addr,sizeof(tcp_server_addr));
 	if (ret<0) {
 		std::cerr << "could not open " << tuio_type() << " connection to 127.0.0.1:3333" << std::endl;
 		return;
 	} else {
 		std::cout << tuio_type() << " connection opened to 127.0.0.1:3333" << std::endl;
-		tcp_client_list.push_back(tcp_socket);
-		connected = true;
-		
-#ifdef WIN32
-		HANDLE server_thread = CreateThread( 0, 0, ClientThreadFunc, this, 0, &ServerThreadId );
-#else
-		pthread_create(&server_thread , NULL, ClientThreadFunc,this);
-#endif
-
+		startEventLoop();
+		addClient(tcp_socket,"127.0.0.1:3333");
 	}
-
 }
 
 TcpSender::TcpSender(const char *host, int port) 
-	:connected (false)
 {	
+	initialize();
 	if ((strcmp(host,"127.0.0.1")==0) || (strcmp(host,"localhost")==0)) {
 		local = true;
 	} else local = false;
-	buffer_size = MAX_TCP_SIZE;
 	
 	tcp_socket = socket( AF_INET, SOCK_STREAM, IPPROTO_TCP );
 	if (tcp_socket < 0) {
@@ -145,51 +137,54 @@ TcpSender::TcpSender(const char *host, int port)
 		return;
 	}
 
-	struct sockaddr_in tcp_server;
-	memset( &tcp_server, 0, sizeof (tcp_server));
+	struct sockaddr_in tcp_server_addr;
+	memset( &tcp_server_addr, 0, sizeof (tcp_server_addr));
 	unsigned long addr = inet_addr(host);
 	if (addr != INADDR_NONE) {
-		memcpy( (char *)&tcp_server.sin_addr, &addr, sizeof(addr));
+		memcpy( (char *)&tcp_server_addr.sin_addr, &addr, sizeof(addr));
 	} else {
 		struct hostent *host_info = gethostbyname(host);
 		if (host_info == NULL) {
 			std::cerr << "unknown host name: " << host << std::endl;
 			throw std::exception();
 		}
-		memcpy( (char *)&tcp_server.sin_addr, host_info->h_addr, host_info->h_length );
+		memcpy( (char *)&tcp_server_addr.sin_addr, host_info->h_addr, host_info->h_length );
 	}
 
-	tcp_server.sin_family = AF_INET;
-	tcp_server.sin_port = htons(port);
+	tcp_server_addr.sin_family = AF_INET;
+	tcp_server_addr.sin_port = htons(port);
 
-	int ret = connect(tcp_socket,(struct sockaddr*)&tcp_server,sizeof(tcp_server));
+	int ret = connect(tcp_socket,(struct sockaddr*)&tcp_server_addr,sizeof(tcp_server_addr));
 	if (ret<0) {
-#ifdef WIN32
-		closesocket(tcp_socket);
-#else
-		close(tcp_socket);
-#endif	
+		closeSocket(tcp_socket);
 		std::cerr << "could not open " << tuio_type() << " connection to " << host << ":"<< port << std::endl;
 		throw std::exception();
 	} else {
 		std::cout << tuio_type() << " connection opened to " << host << ":"<< port << std::endl;
-		tcp_client_list.push_back(tcp_socket);
-		connected = true;
-		
-#ifdef WIN32
-		HANDLE server_thread = CreateThread( 0, 0, ClientThreadFunc, this, 0, &ServerThreadId );
-#else
-		pthread_create(&server_thread , NULL, ClientThreadFunc,this);
-#endif
-
+		char address[256];
+		sprintf(address,"%s:%d",host,port);
+		startEventLoop();
+		addClient(tcp_socket,address);
 	}
 }
 
 TcpSender::TcpSender(int port)
-	:connected (false)
 {
+	initialize();
+	openServer(port);
+	startEventLoop();
+}
+
+TcpSender::TcpSender(int port, bool start)
+{
+	initialize();
+	openServer(port);
+	if (start) startEventLoop();
+}
+
+void TcpSender::openServer(int port) {
+
 	local = false;
-	buffer_size = MAX_TCP_SIZE;
 	port_no = port;
 	
 	tcp_socket = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
@@ -209,95 +204,388 @@ TcpSender::TcpSender(int port)
 		throw std::exception();
 	}
 	
-	struct sockaddr_in tcp_server;
-	memset( &tcp_server, 0, sizeof (tcp_server));
+	struct sockaddr_in tcp_server_addr;
+	memset( &tcp_server_addr, 0, sizeof (tcp_server_addr));
 
-	tcp_server.sin_family = AF_INET;
-	tcp_server.sin_addr.s_addr = htonl(INADDR_ANY);
-	tcp_server.sin_port = htons(port);
+	tcp_server_addr.sin_family = AF_INET;
+	tcp_server_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	tcp_server_addr.sin_port = htons(port);
 
-	socklen_t len = sizeof(tcp_server);
-	ret = bind(tcp_socket,(struct sockaddr*)&tcp_server,len);
+	socklen_t len = sizeof(tcp_server_addr);
+	ret = bind(tcp_socket,(struct sockaddr*)&tcp_server_addr,len);
 	if (ret < 0) {
 		std::cerr << "could not bind to TUIO/TCP socket on port " << port << std::endl;
 		throw std::exception();
 	}
 	
-	ret =  listen(tcp_socket, 1);
+	ret =  listen(tcp_socket, SOMAXCONN);
 	if (ret < 0) {
 		std::cerr << "could not start listening to TUIO/TCP socket" << std::endl;
+		closeSocket(tcp_socket);
+		throw std::exception();
+	}
+
+	setNonBlocking(tcp_socket);
+	tcp_server = true;
+}
+
+TcpSender::~TcpSender() {
+
+	stopEventLoop();
+
+	for (std::list<TcpClient*>::iterator client = tcp_client_list.begin(); client!=tcp_client_list.end(); client++) {
+		closeSocket((*client)->socket);
+		delete (*client);
+	}
+	tcp_client_list.clear();
+	if (tcp_server) closeSocket(tcp_socket);
+
+#ifdef LINUX
+	if (epoll_fd>=0) close(epoll_fd);
+#endif
 #ifdef WIN32
-		closesocket(tcp_socket);
+	CloseHandle(clientMutex);
 #else
-		close(tcp_socket);
+	pthread_mutex_destroy(&clientMutex);
 #endif
+}
+
+void TcpSender::startEventLoop() {
+
+#ifdef LINUX
+	epoll_fd = epoll_create1(0);
+	if (epoll_fd<0) {
+		std::cerr << "could not create " << tuio_type() << " event loop" << std::endl;
 		throw std::exception();
 	}
-				
+
+	if (tcp_server) {
+		struct epoll_event event;
+		event.events = EPOLLIN;
+		event.data.ptr = NULL;
+		epoll_ctl(epoll_fd, EPOLL_CTL_ADD, tcp_socket, &event);
+	}
+#endif
+
+	running = true;
 #ifdef WIN32
-	DWORD ServerThreadId;
 	server_thread = CreateThread( 0, 0, ServerThreadFunc, this, 0, &ServerThreadId );
 #else
 	pthread_create(&server_thread , NULL, ServerThreadFunc, this);
 #endif
-	
 }
 
-bool TcpSender::isConnected() {
-	return connected;
+void TcpSender::stopEventLoop() {
+
+	if (!running) return;
+	running = false;
+#ifdef WIN32
+	WaitForSingleObject(server_thread,INFINITE);
+	CloseHandle(server_thread);
+#else
+	pthread_join(server_thread,NULL);
+#endif
 }
 
+void TcpSender::lockClients() {
+#ifdef WIN32
+	WaitForSingleObject(clientMutex, INFINITE);
+#else
+	pthread_mutex_lock(&clientMutex);
+#endif
+}
 
-TcpSender::~TcpSender() {
+void TcpSender::unlockClients() {
 #ifdef WIN32
+	ReleaseMutex(clientMutex);
+#else
+	pthread_mutex_unlock(&clientMutex);
+#endif
+}
 
-	for (std::list<SOCKET>::iterator client = tcp_client_list.begin(); client!=tcp_client_list.end(); client++) {
-		closesocket((*client));
-	}
-	closesocket(tcp_socket);
+#ifdef WIN32
+void TcpSender::addClient( SOCKET socket, const char *address ) {
+#else
+void TcpSender::addClient( int socket, const char *address ) {
+#endif
+
+	setNonBlocking(socket);
 
-	if( server_thread ) CloseHandle( server_thread );
+	TcpClient *client = new TcpClient();
+	client->socket = socket;
+	client->ready = false;
+	client->address = address;
+	client->output_offset = 0;
+	client->sent_packets = 0;
+	client->dropped_packets = 0;
+	client->sent_bytes = 0;
+
+	lockClients();
+	tcp_client_list.push_back(client);
+	newClient(client);
+	if (client->ready) new_client = true;
+	unlockClients();
+
+#ifdef LINUX
+	struct epoll_event event;
+	event.events = EPOLLIN;
+	event.data.ptr = client;
+	epoll_ctl(epoll_fd, EPOLL_CTL_ADD, socket, &event);
+#endif
+}
+
+void TcpSender::removeClient( TcpClient *client ) {
+
+	lockClients();
+	tcp_client_list.remove(client);
+	unlockClients();
+
+#ifdef LINUX
+	epoll_ctl(epoll_fd, EPOLL_CTL_DEL, client->socket, NULL);
+#endif
+	closeSocket(client->socket);
+
+	std::cout << tuio_type() << " connection closed to " << client->address << " (" << client->sent_packets << " packets sent, " << client->dropped_packets << " dropped)" << std::endl;
+	delete client;
+}
+
+void TcpSender::acceptClient() {
+
+	struct sockaddr_in client_addr;
+	socklen_t len = sizeof(client_addr);
 
+	for (;;) {
+#ifdef WIN32
+		SOCKET client = accept(tcp_socket, (struct sockaddr*)&client_addr, &len);
+		if (client==INVALID_SOCKET) break;
 #else
-		for (std::list<int>::iterator client = tcp_client_list.begin(); client!=tcp_client_list.end(); client++) {
-		close((*client));
+		int client = accept(tcp_socket, (struct sockaddr*)&client_addr, &len);
+		if (client<0) break;
+#endif
+		char address[256];
+		sprintf(address,"%s:%d",inet_ntoa(client_addr.sin_addr),ntohs(client_addr.sin_port));
+		std::cout << tuio_type() << " client connected from " << address << std::endl;
+		addClient(client,address);
 	}
-	close(tcp_socket);
-	tcp_socket = 0;
-	server_thread = 0;
-#endif		
 }
 
+bool TcpSender::readClient( TcpClient *client ) {
 
-bool TcpSender::sendOscPacket (osc::OutboundPacketStream *bundle) {
-	if (!connected) return false; 
-	if ( bundle->Size() > buffer_size ) return false;
-	if ( bundle->Size() == 0 ) return false;
-	
-#ifdef OSC_HOST_LITTLE_ENDIAN             
-	data_size[0] =  bundle->Size()>>24;
-	data_size[1] = (bundle->Size()>>16) & 255;
-	data_size[2] = (bundle->Size()>>8) & 255;
-	data_size[3] = (bundle->Size()) & 255;
-#else
-	*((int32_t*)data_size) = bundle->Size();
+	char buffer[1024];
+	int size = recv(client->socket, buffer, sizeof(buffer), 0);
+	if (size==0) return false;
+	if (size<0) return wouldBlock();
+
+	lockClients();
+	bool ready = client->ready;
+	bool alive = receiveClientData(client, buffer, size);
+	if (client->ready && !ready) new_client = true;
+	unlockClients();
+	return alive;
+}
+
+bool TcpSender::flushClient( TcpClient *client ) {
+
+	while (!client->output.empty()) {
+		const std::string &packet = *client->output.front();
+		int size = (int)(packet.size()-client->output_offset);
+		int ret = send(client->socket, packet.data()+client->output_offset, size, MSG_NOSIGNAL);
+		if (ret<0) return wouldBlock();
+
+		client->output_offset += ret;
+		client->sent_bytes += ret;
+		sent_bytes += ret;
+		if (client->output_offset<packet.size()) break;
+
+		client->output.pop_front();
+		client->output_offset = 0;
+		client->sent_packets++;
+	}
+	return true;
+}
+
+void TcpSender::updateClientEvents( TcpClient *client ) {
+#ifdef LINUX
+	struct epoll_event event;
+	event.events = EPOLLIN;
+	if (!client->output.empty()) event.events |= EPOLLOUT;
+	event.data.ptr = client;
+	epoll_ctl(epoll_fd, EPOLL_CTL_MOD, client->socket, &event);
 #endif
+}
 
-#ifdef WIN32
-	std::list<SOCKET>::iterator client;
+void TcpSender::queuePacket( TcpClient *client, TcpPacket packet ) {
+
+	bool idle = client->output.empty();
+	client->output.push_back(packet);
+
+	// drop the oldest pending packets, except the one already partially sent
+	while (client->output.size()>client_queue_size) {
+		std::deque<TcpPacket>::iterator oldest = client->output.begin();
+		if (client->output_offset>0) oldest++;
+		client->output.erase(oldest);
+		client->dropped_packets++;
+		dropped_packets++;
+	}
+
+	// try to send immediately, the event loop takes care of the remaining data
+	if (idle) {
+		flushClient(client);
+		if (!client->output.empty()) updateClientEvents(client);
+	}
+}
+
+void TcpSender::run() {
+
+	if (tcp_server) std::cout << tuio_type() << " socket created on port " << port_no << std::endl;
+
+#ifdef LINUX
+	struct epoll_event events[MAX_TCP_EVENTS];
+	while (running) {
+		int count = epoll_wait(epoll_fd, events, MAX_TCP_EVENTS, 100);
+		for (int i=0;i<count;i++) {
+			TcpClient *client = (TcpClient*)events[i].data.ptr;
+			if (client==NULL) {
+				acceptClient();
+				continue;
+			}
+
+			bool alive = true;
+			if (events[i].events & (EPOLLIN|EPOLLHUP|EPOLLERR)) alive = readClient(client);
+			if (alive && (events[i].events & EPOLLOUT)) {
+				lockClients();
+				alive = flushClient(client);
+				if (alive) updateClientEvents(client);
+				unlockClients();
+			}
+			if (!alive) removeClient(client);
+		}
+	}
 #else
-	std::list<int>::iterator client;
+	std::vector<TcpClient*> clients;
+	while (running) {
+		fd_set read_set, write_set;
+		FD_ZERO(&read_set);
+		FD_ZERO(&write_set);
+		int max_socket = 0;
+
+		if (tcp_server) {
+			FD_SET(tcp_socket, &read_set);
+			max_socket = (int)tcp_socket;
+		}
+
+		lockClients();
+		clients.assign(tcp_client_list.begin(),tcp_client_list.end());
+		for (std::list<TcpClient*>::iterator client = tcp_client_list.begin(); client!=tcp_client_list.end(); client++) {
+			FD_SET((*client)->socket, &read_set);
+			if (!(*client)->output.empty()) FD_SET((*client)->socket, &write_set);
+			if ((int)(*client)->socket>max_socket) max_socket = (int)(*client)->socket;
+		}
+		unlockClients();
+
+		// packets are usually sent right away, so a short timeout only delays queued data
+		struct timeval timeout;
+		timeout.tv_sec = 0;
+		timeout.tv_usec = 10000;
+		int count = select(max_socket+1, &read_set, &write_set, NULL, &timeout);
+		if (count<=0) continue;
+
+		if (tcp_server && FD_ISSET(tcp_socket, &read_set)) acceptClient();
+		for (std::vector<TcpClient*>::iterator client = clients.begin(); client!=clients.end(); client++) {
+			bool alive = true;
+			if (FD_ISSET((*client)->socket, &read_set)) alive = readClient(*client);
+			if (alive && FD_ISSET((*client)->socket, &write_set)) {
+				lockClients();
+				alive = flushClient(*client);
+				unlockClients();
+			}
+			if (!alive) removeClient(*client);
+		}
+	}
 #endif
+}
+
+bool TcpSender::hasNewClient() {
+	return new_client.exchange(false);
+}
+
+bool TcpSender::isConnected() {
+
+	lockClients();
+	bool connected = !tcp_client_list.empty();
+	unlockClients();
+	return connected;
+}
+
+void TcpSender::setClientQueueSize(unsigned int size) {
 	
-	for (client = tcp_client_list.begin(); client!=tcp_client_list.end(); client++) {
-		//send((*client), data_size, 4,0);
-		//send((*client), bundle->Data(), bundle->Size(),0);
-		memcpy(&data_buffer[0], &data_size, 4);
-		memcpy(&data_buffer[4], bundle->Data(), bundle->Size());
-		send((*client),data_buffer, 4+bundle->Size(),0);
+	// at least one partially sent and one new packet need to fit
+	if (size<2) size = 2;
+	lockClients();
+	client_queue_size = size;
+	unlockClients();
+}
+
+unsigned int TcpSender::getClientCount() {
+
+	lockClients();
+	unsigned int count = (unsigned int)tcp_client_list.size();
+	unlockClients();
+	return count;
+}
+
+unsigned long TcpSender::getDroppedPackets() {
+
+	lockClients();
+	unsigned long dropped = dropped_packets;
+	unlockClients();
+	return dropped;
+}
+
+unsigned long long TcpSender::getSentBytes() {
+
+	lockClients();
+	unsigned long long sent = sent_bytes;
+	unlockClients();
+	return sent;
+}
+
+TcpPacket TcpSender::framePacket( const char *data, unsigned int size ) {
+
+	// the packet size is prepended in network byte order
+	std::shared_ptr<std::string> packet = std::make_shared<std::string>();
+	packet->reserve(size+4);
+	packet->push_back((char)((size>>24) & 255));
+	packet->push_back((char)((size>>16) & 255));
+	packet->push_back((char)((size>>8) & 255));
+	packet->push_back((char)(size & 255));
+	packet->append(data,size);
+	return packet;
+}
+
+bool TcpSender::sendOscData (const char *data, unsigned int size) {
+	if ( size > buffer_size ) return false;
+	if ( size == 0 ) return false;
+
+	bool delivered = false;
+	TcpPacket packet;
+
+	lockClients();
+	for (std::list<TcpClient*>::iterator client = tcp_client_list.begin(); client!=tcp_client_list.end(); client++) {
+		if (!(*client)->ready) continue;
+		if (!packet) packet = framePacket(data,size);
+		queuePacket(*client,packet);
+		delivered = true;
 	}
+	unlockClients();
 
-	return true;
+	return delivered;
+}
+
+void TcpSender::newClient( TcpClient *client ) {
+	client->ready = true;
 }
 
-void TcpSender::newClient( int tcp_client ) { }
+bool TcpSender::receiveClientData( TcpClient* /*client*/, const char* /*data*/, int /*size*/ ) {
+	return true;
+}
@@ -33,15 +33,48 @@ typedef int socklen_t;
 #include <netdb.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <pthread.h>
 #endif
 
 #include <list>
+#include <deque>
+#include <string>
+#include <memory>
+#include <atomic>
 #define MAX_TCP_SIZE 65536
+#define MAX_TCP_QUEUE 32
 
 namespace TUIO {
-	
+
+	/**
+	 * A shared OSC packet including its transport framing, which is queued for several TcpClients
+	 */
+	typedef std::shared_ptr<const std::string> TcpPacket;
+
+	/**
+	 * The TcpClient holds the connection state of a single TCP client
+	 */
+	struct TcpClient {
+#ifdef WIN32
+		SOCKET socket;
+#else
+		int socket;
+#endif
+		bool ready;							// the client has completed its handshake and receives OSC data
+		std::string address;				// the remote address and port
+		std::string input;					// received handshake data
+		std::deque<TcpPacket> output;		// pending outgoing packets
+		size_t output_offset;				// bytes of the first pending packet already sent
+		unsigned long sent_packets;
+		unsigned long dropped_packets;
+		unsigned long long sent_bytes;
+	};
+
 	/**
-	 * The TcpSender implements the TCP transport method for OSC
+	 * The TcpSender implements the TCP transport method for OSC.
+	 * All client sockets are non-blocking and served by a single event loop thread,
+	 * each client has its own bounded queue of pending packets. When a slow client
+	 * falls behind, its oldest pending packets are dropped in favour of the latest ones.
 	 *
 	 * @author Martin Kaltenbrunner
 	 * @version 1.1.6
@@ -71,18 +104,19 @@ namespace TUIO {
 		TcpSender(int port);	
 		
 		/**
-		 * The destructor closes the socket. 
+		 * The destructor stops the event loop and closes all sockets. 
 		 */
 		virtual ~TcpSender();
 		
 		/**
-		 * This method delivers the provided OSC data
+		 * This method queues the provided OSC data for all connected clients
 		 *
-		 * @param *bundle  the OSC stream to deliver
+		 * @param *data  the OSC packet data to deliver
+		 * @param size  the OSC packet size in bytes
 		 * @return true if the data was delivered successfully
 		 */
 		
-		bool sendOscPacket (osc::OutboundPacketStream *bundle);
+		bool sendOscData (const char *data, unsigned int size);
 
 		/**
 		 * This method returns the connection state
@@ -92,34 +126,147 @@ namespace TUIO {
 		bool isConnected ();
 
 		/**
-		 * This method is called whenever a new client connects
+		 * This method returns true once after a new client has completed its handshake
 		 *
-		 * @param tcp_client the socket handle of the new client
+		 * @return true if a new client has connected since the last call
 		 */
-		virtual void newClient( int tcp_client );
+		bool hasNewClient ();
+
+		/**
+		 * Defines the maximum number of pending packets per client
+		 *
+		 * @param size  the maximum number of pending packets per client
+		 */
+		void setClientQueueSize(unsigned int size);
+
+		/**
+		 * This method returns the number of currently connected clients
+		 *
+		 * @return the number of currently connected clients
+		 */
+		unsigned int getClientCount();
+
+		/**
+		 * This method returns the number of packets dropped for slow clients
+		 *
+		 * @return the number of packets dropped for slow clients
+		 */
+		unsigned long getDroppedPackets();
+
+		/**
+		 * This method returns the number of bytes sent to all clients
+		 *
+		 * @return the number of bytes sent to all clients
+		 */
+		unsigned long long getSentBytes();
+
+		/**
+		 * The main loop of the event thread, which accepts new clients,
+		 * reads their handshakes and sends their pending packets.
+		 */
+		void run();
 
 		int port_no;
-		
+		const char* tuio_type() { return "TUIO/TCP"; }
+
+	protected:
+
+		/**
+		 * This constructor creates a TcpSender that listens to the provided port,
+		 * derived classes start the event loop at the end of their own constructor.
+		 *
+		 * @param  port	the incoming TCP port number
+		 * @param  start	starts the event loop immediately
+		 */
+		TcpSender(int port, bool start);
+
+		/**
+		 * This method starts the event loop thread
+		 */
+		void startEventLoop();
+
+		/**
+		 * This method stops the event loop thread,
+		 * derived classes stop it at the beginning of their own destructor.
+		 */
+		void stopEventLoop();
+
+		/**
+		 * This method is called whenever a new client connects.
+		 * TCP clients are ready to receive OSC data immediately.
+		 *
+		 * @param client the new client
+		 */
+		virtual void newClient( TcpClient *client );
+
+		/**
+		 * This method is called whenever a client sends data
+		 *
+		 * @param client the sending client
+		 * @return false if the client should be disconnected
+		 */
+		virtual bool receiveClientData( TcpClient *client, const char *data, int size );
+
+		/**
+		 * This method adds the transport framing to the provided OSC data
+		 *
+		 * @param *data  the OSC packet data to frame
+		 * @param size  the OSC packet size in bytes
+		 * @return the framed packet
+		 */
+		virtual TcpPacket framePacket( const char *data, unsigned int size );
+
+		/**
+		 * This method queues a packet for the provided client and sends as much of it as possible.
+		 * It must be called with the client lock held.
+		 *
+		 * @param client the receiving client
+		 * @param packet the packet to queue
+		 */
+		void queuePacket( TcpClient *client, TcpPacket packet );
+
+		void lockClients();
+		void unlockClients();
+
 #ifdef WIN32
 		SOCKET tcp_socket;
-		std::list<SOCKET> tcp_client_list;
 #else
 		int tcp_socket;
-		std::list<int> tcp_client_list;
 #endif
-		bool connected;
-		const char* tuio_type() { return "TUIO/TCP"; }
+		bool tcp_server;
+		std::list<TcpClient*> tcp_client_list;
+		unsigned int client_queue_size;
+		unsigned long dropped_packets;
+		unsigned long long sent_bytes;
+		std::atomic<bool> running;
+		std::atomic<bool> new_client;
 
-	protected:
-		char data_size[4];
-		char data_buffer[MAX_TCP_SIZE+4];
-		
+	private:
+
+		void initialize();
+		void openServer(int port);
+#ifdef WIN32
+		void addClient( SOCKET socket, const char *address );
+#else
+		void addClient( int socket, const char *address );
+#endif
+		bool flushClient( TcpClient *client );
+		void removeClient( TcpClient *client );
+		void acceptClient();
+		bool readClient( TcpClient *client );
+		void updateClientEvents( TcpClient *client );
+
+#ifdef LINUX
+		int epoll_fd;
+#endif
 
 #ifdef WIN32
 		HANDLE server_thread;
 		DWORD ServerThreadId;
+		HANDLE clientMutex;
 #else
 		pthread_t server_thread;
+		pthread_mutex_t clientMutex;
 #endif
 		
 	};
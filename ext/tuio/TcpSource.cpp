@@ -0,0 +1,201 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#include "TcpSource.h"
+#include <errno.h>
+#ifndef WIN32
+#include <sys/select.h>
+#endif
+
+#define TCP_SELECT_TIMEOUT 100000
+#define TCP_RECONNECT_DELAY 1000
+
+using namespace TUIO;
+
+#ifdef WIN32
+static void closeSocket( SOCKET socket ) {
+	closesocket(socket);
+}
+
+static void sleepMillis( int ms ) {
+	Sleep(ms);
+}
+#define INVALID_TCP_SOCKET INVALID_SOCKET
+#else
+static void closeSocket( int socket ) {
+	close(socket);
+}
+
+static void sleepMillis( int ms ) {
+	usleep(ms*1000);
+}
+#define INVALID_TCP_SOCKET -1
+#endif
+
+#ifdef WIN32
+static DWORD WINAPI ReceiverThreadFunc( LPVOID obj )
+#else
+static void* ReceiverThreadFunc( void* obj )
+#endif
+{
+	static_cast<TcpSource*>(obj)->run();
+	return 0;
+};
+
+TcpSource::TcpSource(const char *host, int port)
+: host_name (host)
+, port_no (port)
+, tcp_socket (INVALID_TCP_SOCKET)
+, running (false)
+, connected (false)
+{
+	unsigned long addr = GetHostByName(host);
+	if (addr==0) {
+		std::cerr << "unknown host name: " << host << std::endl;
+		throw std::exception();
+	}
+	endpoint = IpEndpointName(addr, port);
+}
+
+TcpSource::~TcpSource() {
+	disconnect();
+}
+
+bool TcpSource::connect() {
+
+	if (running) return true;
+	running = true;
+#ifdef WIN32
+	DWORD threadId;
+	thread = CreateThread( 0, 0, ReceiverThreadFunc, this, 0, &threadId );
+	if (thread==NULL) running = false;
+#else
+	if (pthread_create(&thread , NULL, ReceiverThreadFunc, this)!=0) running = false;
+#endif
+	return running;
+}
+
+void TcpSource::disconnect() {
+
+	if (!running) return;
+	running = false;
+#ifdef WIN32
+	WaitForSingleObject(thread,INFINITE);
+	CloseHandle(thread);
+#else
+	pthread_join(thread,NULL);
+#endif
+	closeConnection();
+}
+
+bool TcpSource::openConnection() {
+
+	tcp_socket = socket( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+	if (tcp_socket == INVALID_TCP_SOCKET) return false;
+
+	struct sockaddr_in tcp_host_addr;
+	memset( &tcp_host_addr, 0, sizeof (tcp_host_addr));
+	tcp_host_addr.sin_family = AF_INET;
+	tcp_host_addr.sin_port = htons(port_no);
+	tcp_host_addr.sin_addr.s_addr = htonl(endpoint.address);
+
+	if (::connect(tcp_socket,(struct sockaddr*)&tcp_host_addr,sizeof(tcp_host_addr))<0) {
+		closeSocket(tcp_socket);
+		tcp_socket = INVALID_TCP_SOCKET;
+		return false;
+	}
+
+	input.clear();
+	if (!startSession()) {
+		closeSocket(tcp_socket);
+		tcp_socket = INVALID_TCP_SOCKET;
+		return false;
+	}
+
+	connected = true;
+	std::cout << tuio_type() << " connection opened to " << host_name << ":" << port_no << std::endl;
+	return true;
+}
+
+void TcpSource::closeConnection() {
+
+	if (tcp_socket == INVALID_TCP_SOCKET) return;
+	closeSocket(tcp_socket);
+	tcp_socket = INVALID_TCP_SOCKET;
+	if (connected) std::cout << tuio_type() << " connection closed to " << host_name << ":" << port_no << std::endl;
+	connected = false;
+}
+
+bool TcpSource::receiveData() {
+
+	char buffer[MAX_TCP_SIZE];
+	int size = recv(tcp_socket, buffer, sizeof(buffer), 0);
+	if (size<=0) return false;
+	input.append(buffer,size);
+	return processInput();
+}
+
+bool TcpSource::processInput() {
+
+	// each packet is preceded by its size in network byte order
+	size_t offset = 0;
+	while (input.size()-offset>=4) {
+		const unsigned char *header = (const unsigned char*)input.data()+offset;
+		unsigned int packet_size = ((unsigned int)header[0]<<24) | ((unsigned int)header[1]<<16) | ((unsigned int)header[2]<<8) | (unsigned int)header[3];
+		if ((packet_size==0) || (packet_size>MAX_TCP_SIZE)) return false;
+		if (input.size()-offset-4<packet_size) break;
+
+		if (listener) {
+			try { listener->ProcessPacket(input.data()+offset+4, (int)packet_size, endpoint); }
+			catch (std::exception &e) { std::cerr << "malformed " << tuio_type() << " packet from " << host_name << std::endl; }
+		}
+		offset += 4+packet_size;
+	}
+	input.erase(0,offset);
+	return true;
+}
+
+void TcpSource::run() {
+
+	while (running) {
+
+		if (tcp_socket == INVALID_TCP_SOCKET) {
+			if (!openConnection()) {
+				sleepMillis(TCP_RECONNECT_DELAY);
+				continue;
+			}
+		}
+
+		// the timeout allows the thread to notice when it has been stopped
+		fd_set read_set;
+		FD_ZERO(&read_set);
+		FD_SET(tcp_socket, &read_set);
+		struct timeval timeout;
+		timeout.tv_sec = 0;
+		timeout.tv_usec = TCP_SELECT_TIMEOUT;
+
+		int ret = select((int)tcp_socket+1, &read_set, NULL, NULL, &timeout);
+		if (ret<0) {
+			if (errno==EINTR) continue;
+			closeConnection();
+		} else if (ret>0) {
+			if (!receiveData()) closeConnection();
+		}
+	}
+}
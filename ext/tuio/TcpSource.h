@@ -0,0 +1,132 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#ifndef INCLUDED_TCPSOURCE_H
+#define INCLUDED_TCPSOURCE_H
+
+#include "OscSource.h"
+#include "ip/IpEndpointName.h"
+
+#ifdef WIN32
+#include <winsock.h>
+#include <io.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <pthread.h>
+#endif
+
+#include <string>
+#include <atomic>
+#define MAX_TCP_SIZE 65536
+
+namespace TUIO {
+
+	/**
+	 * The TcpSource receives OSC packets from a TCP host, such as a TcpSender listening to a port.
+	 * Each OSC packet is preceded by its size in network byte order.
+	 * The receiver thread reconnects to the host whenever the connection has been lost.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL TcpSource : public OscSource {
+
+	public:
+
+		/**
+		 * This constructor creates a TcpSource that connects to the provided port on the given host
+		 *
+		 * @param  host  the sending host name
+		 * @param  port  the TUIO TCP port number of the host
+		 */
+		TcpSource(const char *host, int port);
+
+		/**
+		 * The destructor stops the receiver thread and closes the socket.
+		 */
+		virtual ~TcpSource();
+
+		/**
+		 * This method starts the receiver thread
+		 *
+		 * @return true if the receiver thread has been started
+		 */
+		bool connect();
+
+		/**
+		 * This method stops the receiver thread
+		 */
+		void disconnect();
+
+		/**
+		 * This method returns the connection state
+		 *
+		 * @return true if the connection to the host is alive
+		 */
+		bool isConnected() { return connected; };
+
+		/**
+		 * The main loop of the receiver thread, which (re)connects to the host
+		 * and passes the received OSC packets to the PacketListener
+		 */
+		void run();
+
+		virtual const char* tuio_type() { return "TUIO/TCP"; }
+
+	protected:
+		/**
+		 * Starts the session after the connection has been opened, which requires no handshake for plain TCP
+		 *
+		 * @return true if the session has been started
+		 */
+		virtual bool startSession() { return true; };
+
+		/**
+		 * Passes all complete OSC packets of the received input to the PacketListener and removes them from the input
+		 *
+		 * @return false if the input is invalid and the connection needs to be closed
+		 */
+		virtual bool processInput();
+
+		bool openConnection();
+		void closeConnection();
+		bool receiveData();
+
+		NetworkInitializer network;
+		std::string host_name;
+		int port_no;
+		IpEndpointName endpoint;
+#ifdef WIN32
+		SOCKET tcp_socket;
+		HANDLE thread;
+#else
+		int tcp_socket;
+		pthread_t thread;
+#endif
+		std::string input;
+		std::atomic<bool> running;
+		std::atomic<bool> connected;
+	};
+}
+#endif /* INCLUDED_TCPSOURCE_H */
@@ -194,6 +194,10 @@ float TuioBlob::getRotationAccel() const{
 	return rotation_accel;
 }
 
+float TuioBlob::getPredictedAngle(float dt) const{
+	return predictAngle(angle, rotation_speed, rotation_accel, dt);
+}
+
 bool TuioBlob::isMoving() const{ 
 	if ((state==TUIO_ACCELERATING) || (state==TUIO_DECELERATING) || (state==TUIO_ROTATING)) return true;
 	else return false;
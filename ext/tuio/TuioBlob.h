@@ -251,6 +251,14 @@ namespace TUIO {
 		 */
 		float getRotationAccel() const;
 
+		/**
+		 * Returns the rotation angle of this TuioBlob extrapolated by the provided time interval,
+		 * using its current rotation speed and acceleration without reversing the rotation direction.
+		 * @param	dt	the extrapolation interval in seconds
+		 * @return	the extrapolated rotation angle in radians
+		 */
+		float getPredictedAngle(float dt) const;
+
 		/**
 		 * Returns true of this TuioBlob is moving.
 		 * @return	true of this TuioBlob is moving
@@ -32,9 +32,8 @@ TuioContainer::TuioContainer (TuioTime ttime, long si, float xp, float yp):TuioP
 	motion_accel = 0.0f;
 	x_accel = 0.0f;
 	y_accel = 0.0f;
-	TuioPoint p(currentTime,xpos,ypos);
-	path.push_back(p);
-	lastPoint = &path.back();
+	path.push_back(currentTime,xpos,ypos);
+	lastTime = currentTime;
 }
 
 TuioContainer::TuioContainer (long si, float xp, float yp):TuioPoint(xp,yp)
@@ -50,9 +49,8 @@ TuioContainer::TuioContainer (long si, float xp, float yp):TuioPoint(xp,yp)
 	motion_accel = 0.0f;
 	x_accel = 0.0f;
 	y_accel = 0.0f;
-	TuioPoint p(currentTime,xpos,ypos);
-	path.push_back(p);
-	lastPoint = &path.back();
+	path.push_back(currentTime,xpos,ypos);
+	lastTime = currentTime;
 }
 
 TuioContainer::TuioContainer (TuioContainer *tcon):TuioPoint(tcon)
@@ -69,9 +67,8 @@ TuioContainer::TuioContainer (TuioContainer *tcon):TuioPoint(tcon)
 	x_accel = 0.0f;
 	y_accel = 0.0f;
 	
-	TuioPoint p(currentTime,xpos,ypos);
-	path.push_back(p);
-	lastPoint = &path.back();
+	path.push_back(currentTime,xpos,ypos);
+	lastTime = currentTime;
 }
 
 void TuioContainer::setTuioSource(int src_id, const char *src_name, const char *src_addr) {
@@ -93,13 +90,14 @@ int TuioContainer::getTuioSourceID() const{
 }
 
 void TuioContainer::update (TuioTime ttime, float xp, float yp) {
-	lastPoint = &path.back();
+	TuioPoint lastPoint = path.back();
+	lastTime = lastPoint.getTuioTime();
 	TuioPoint::update(ttime,xp, yp);
 
-	TuioTime diffTime = currentTime - lastPoint->getTuioTime();
+	TuioTime diffTime = currentTime - lastTime;
 	float dt = diffTime.getTotalMilliseconds()/1000.0f;
-	float dx = xpos - lastPoint->getX();
-	float dy = ypos - lastPoint->getY();
+	float dx = xpos - lastPoint.getX();
+	float dy = ypos - lastPoint.getY();
 	float dist = sqrt(dx*dx+dy*dy);
 	float last_motion_speed = motion_speed;
 	float last_x_speed = x_speed;
@@ -112,9 +110,7 @@ void TuioContainer::update (TuioTime ttime, float xp, float yp) {
 	x_accel = (x_speed - last_x_speed)/dt;
 	y_accel = (y_speed - last_y_speed)/dt;
 
-	TuioPoint p(currentTime,xpos,ypos);
-	path.push_back(p);
-    if (path.size()>MAX_PATH_SIZE) path.pop_front();
+	path.push_back(currentTime,xpos,ypos);
 
 	if (motion_accel>0) state = TUIO_ACCELERATING;
 	else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -135,10 +131,8 @@ void TuioContainer::update (TuioTime ttime, float xp, float yp, float xs, float
 	x_accel = ma;
 	y_accel = ma;
 
-	lastPoint = &path.back();
-	TuioPoint p(currentTime,xpos,ypos);
-	path.push_back(p);
-    if (path.size()>MAX_PATH_SIZE) path.pop_front();
+	lastTime = path.back().getTuioTime();
+	path.push_back(currentTime,xpos,ypos);
 
 	if (motion_accel>0) state = TUIO_ACCELERATING;
 	else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -154,10 +148,8 @@ void TuioContainer::update (float xp, float yp, float xs, float ys, float ma) {
 	x_accel = ma;
 	y_accel = ma;
 
-	lastPoint = &path.back();
-	TuioPoint p(currentTime,xpos,ypos);
-	path.push_back(p);
-    if (path.size()>MAX_PATH_SIZE) path.pop_front();
+	lastTime = path.back().getTuioTime();
+	path.push_back(currentTime,xpos,ypos);
 
 	if (motion_accel>0) state = TUIO_ACCELERATING;
 	else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -173,10 +165,8 @@ void TuioContainer::update (TuioContainer *tcon) {
 	x_accel = motion_accel;
 	y_accel = motion_accel;
 
-	lastPoint = &path.back();
-	TuioPoint p(tcon->getTuioTime(),xpos,ypos);
-	path.push_back(p);
-    if (path.size()>MAX_PATH_SIZE) path.pop_front();
+	lastTime = path.back().getTuioTime();
+	path.push_back(tcon->getTuioTime(),xpos,ypos);
 
 	if (motion_accel>0) state = TUIO_ACCELERATING;
 	else if (motion_accel<0) state = TUIO_DECELERATING;
@@ -210,7 +200,7 @@ TuioPoint TuioContainer::getPosition() const{
 }
 
 std::list<TuioPoint> TuioContainer::getPath() const{
-	return path;
+	return path.getList();
 }
 
 float TuioContainer::getMotionSpeed() const{
@@ -254,7 +244,7 @@ TuioPoint TuioContainer::predictPosition() {
 		return TuioPoint(nx,ny);
 	} else return TuioPoint(xpos,ypos);*/
 	
-	TuioTime diffTime = currentTime - lastPoint->getTuioTime();
+	TuioTime diffTime = currentTime - lastTime;
 	float dt = diffTime.getTotalMilliseconds()/1000.0f;
 	
 	float tx = x_speed * dt;
@@ -275,3 +265,37 @@ TuioPoint TuioContainer::predictPosition() {
 	
 }
 
+float TuioContainer::predictAngle(float angle, float rotation_speed, float rotation_accel, float dt) {
+	if ((dt<=0) || (rotation_speed==0)) return angle;
+
+	// the rotation speed is measured in full rotations per second
+	float rotation = rotation_speed*dt + 0.5f*rotation_accel*dt*dt;
+	if ((rotation<0) != (rotation_speed<0)) rotation = 0;
+	else if ((rotation_accel!=0) && ((rotation_accel<0) != (rotation_speed<0))) {
+		float rest = -0.5f*rotation_speed*rotation_speed/rotation_accel;
+		if (fabs(rotation)>fabs(rest)) rotation = rest;
+	}
+
+	float a = angle + rotation*2.0f*(float)M_PI;
+	if (a >= 2*M_PI) a -= 2.0f*(float)M_PI;
+	else if (a < 0) a += 2.0f*(float)M_PI;
+	return a;
+}
+
+TuioPoint TuioContainer::getPredictedPosition(float dt) const{
+	if ((dt<=0) || (motion_speed<=0)) return TuioPoint(xpos,ypos);
+
+	float distance = motion_speed*dt + 0.5f*motion_accel*dt*dt;
+	if (distance<0) distance = 0;
+	else if (motion_accel<0) {
+		float rest = -0.5f*motion_speed*motion_speed/motion_accel;
+		if (distance>rest) distance = rest;
+	}
+
+	float nx = xpos + x_speed/motion_speed*distance;
+	float ny = ypos + y_speed/motion_speed*distance;
+	if (nx<0) nx = 0; else if (nx>1) nx = 1;
+	if (ny<0) ny = 0; else if (ny>1) ny = 1;
+	return TuioPoint(nx,ny);
+}
+
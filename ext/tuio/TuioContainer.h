@@ -20,6 +20,7 @@
 #define INCLUDED_TUIOCONTAINER_H
 
 #include "TuioPoint.h"
+#include "TuioPath.h"
 #include <list>
 #include <string>
 
@@ -31,8 +32,6 @@
 #define TUIO_STOPPED 5
 #define TUIO_REMOVED 6
 
-#define MAX_PATH_SIZE 128
-
 namespace TUIO {
 	
 	/**
@@ -46,7 +45,7 @@ namespace TUIO {
 		
 	private:
 		
-		TuioPoint *lastPoint;
+		TuioTime lastTime;
 		
 	protected:
 		/**
@@ -72,9 +71,9 @@ namespace TUIO {
 		float x_accel;
 		float y_accel;
 		/**
-		 * A List of TuioPoints containing all the previous positions of the TUIO component.
+		 * A TuioPath containing the previous positions of the TUIO component.
 		 */ 
-		std::list<TuioPoint> path;
+		TuioPath path;
 		/**
 		 * Reflects the current state of the TuioComponent
 		 */ 
@@ -91,6 +90,17 @@ namespace TUIO {
 		 * The address of the TUIO source
 		 */ 
 		std::string source_addr;
+
+		/**
+		 * Extrapolates a rotation angle by the provided time interval, using the rotation speed
+		 * and acceleration without reversing the rotation direction.
+		 * @param	angle	the current rotation angle in radians
+		 * @param	rotation_speed	the rotation speed in full rotations per second
+		 * @param	rotation_accel	the rotation acceleration
+		 * @param	dt	the extrapolation interval in seconds
+		 * @return	the extrapolated rotation angle in radians
+		 */
+		static float predictAngle(float angle, float rotation_speed, float rotation_accel, float dt);
 	
 	public:
 		using TuioPoint::update;
@@ -248,6 +258,19 @@ namespace TUIO {
 		 * @return	the path of this TuioContainer
 		 */
 		virtual std::list<TuioPoint> getPath() const;
+
+		/**
+		 * Returns the path of this TuioContainer without copying it.
+		 * @return	the path of this TuioContainer
+		 */
+		const TuioPath& getTuioPath() const { return path; };
+
+		/**
+		 * Limits the number of previous positions kept in the path of this TuioContainer.
+		 * A path size of one only keeps the current position.
+		 * @param	size	the maximum number of positions, up to MAX_PATH_SIZE
+		 */
+		void setPathSize(unsigned int size) { path.setCapacity(size); };
 		
 		/**
 		 * Returns the motion speed of this TuioContainer.
@@ -274,6 +297,15 @@ namespace TUIO {
 		virtual bool isMoving() const;
 
 		virtual TuioPoint predictPosition();
+
+		/**
+		 * Returns the position of this TuioContainer extrapolated by the provided time interval,
+		 * using its current motion speed and acceleration. A decelerating TuioContainer
+		 * stops at its predicted resting position and does not reverse its direction.
+		 * @param	dt	the extrapolation interval in seconds
+		 * @return	the extrapolated position clamped to the normalized range
+		 */
+		virtual TuioPoint getPredictedPosition(float dt) const;
 	};
 }
 #endif
@@ -113,38 +113,29 @@ void TuioDispatcher::removeAllTuioListeners() {
 
 TuioObject* TuioDispatcher::getTuioObject(long s_id) {
 	lockObjectList();
-	for (std::list<TuioObject*>::iterator iter=objectList.begin(); iter != objectList.end(); iter++) {
-		if((*iter)->getSessionID()==s_id) {
-			unlockObjectList();
-			return (*iter);
-		}
-	}	
+	TuioObject *tobj = NULL;
+	std::unordered_map<long, std::list<TuioObject*>::iterator>::iterator entry = objectIndex.find(s_id);
+	if (entry!=objectIndex.end()) tobj = *(entry->second);
 	unlockObjectList();
-	return NULL;
+	return tobj;
 }
 
 TuioCursor* TuioDispatcher::getTuioCursor(long s_id) {
 	lockCursorList();
-	for (std::list<TuioCursor*>::iterator iter=cursorList.begin(); iter != cursorList.end(); iter++) {
-		if((*iter)->getSessionID()==s_id) {
-			unlockCursorList();
-			return (*iter);
-		}
-	}	
+	TuioCursor *tcur = NULL;
+	std::unordered_map<long, std::list<TuioCursor*>::iterator>::iterator entry = cursorIndex.find(s_id);
+	if (entry!=cursorIndex.end()) tcur = *(entry->second);
 	unlockCursorList();
-	return NULL;
+	return tcur;
 }
 
 TuioBlob* TuioDispatcher::getTuioBlob(long s_id) {
 	lockBlobList();
-	for (std::list<TuioBlob*>::iterator iter=blobList.begin(); iter != blobList.end(); iter++) {
-		if((*iter)->getSessionID()==s_id) {
-			unlockBlobList();
-			return (*iter);
-		}
-	}	
+	TuioBlob *tblb = NULL;
+	std::unordered_map<long, std::list<TuioBlob*>::iterator>::iterator entry = blobIndex.find(s_id);
+	if (entry!=blobIndex.end()) tblb = *(entry->second);
 	unlockBlobList();
-	return NULL;
+	return tblb;
 }
 
 std::list<TuioObject*> TuioDispatcher::getTuioObjects() {
@@ -220,5 +211,56 @@ std::list<TuioBlob> TuioDispatcher::copyTuioBlobs() {
 	return listBuffer;
 }
 
+void TuioDispatcher::addObjectEntry(TuioObject *tobj) {
+	objectList.push_back(tobj);
+	objectIndex[tobj->getSessionID()] = --objectList.end();
+}
+
+bool TuioDispatcher::removeObjectEntry(TuioObject *tobj) {
+	std::unordered_map<long, std::list<TuioObject*>::iterator>::iterator entry = objectIndex.find(tobj->getSessionID());
+	if ((entry==objectIndex.end()) || (*(entry->second)!=tobj)) {
+		// the Session ID has been changed since the entry was added
+		for (entry=objectIndex.begin(); entry!=objectIndex.end(); entry++)
+			if (*(entry->second)==tobj) break;
+		if (entry==objectIndex.end()) return false;
+	}
+	objectList.erase(entry->second);
+	objectIndex.erase(entry);
+	return true;
+}
+
+void TuioDispatcher::addCursorEntry(TuioCursor *tcur) {
+	cursorList.push_back(tcur);
+	cursorIndex[tcur->getSessionID()] = --cursorList.end();
+}
 
+bool TuioDispatcher::removeCursorEntry(TuioCursor *tcur) {
+	std::unordered_map<long, std::list<TuioCursor*>::iterator>::iterator entry = cursorIndex.find(tcur->getSessionID());
+	if ((entry==cursorIndex.end()) || (*(entry->second)!=tcur)) {
+		// the Session ID has been changed since the entry was added
+		for (entry=cursorIndex.begin(); entry!=cursorIndex.end(); entry++)
+			if (*(entry->second)==tcur) break;
+		if (entry==cursorIndex.end()) return false;
+	}
+	cursorList.erase(entry->second);
+	cursorIndex.erase(entry);
+	return true;
+}
 
+void TuioDispatcher::addBlobEntry(TuioBlob *tblb) {
+	blobList.push_back(tblb);
+	blobIndex[tblb->getSessionID()] = --blobList.end();
+}
+
+bool TuioDispatcher::removeBlobEntry(TuioBlob *tblb) {
+	std::unordered_map<long, std::list<TuioBlob*>::iterator>::iterator entry = blobIndex.find(tblb->getSessionID());
+	if ((entry==blobIndex.end()) || (*(entry->second)!=tblb)) {
+		// the Session ID has been changed since the entry was added
+		for (entry=blobIndex.begin(); entry!=blobIndex.end(); entry++)
+			if (*(entry->second)==tblb) break;
+		if (entry==blobIndex.end()) return false;
+	}
+	blobList.erase(entry->second);
+	blobIndex.erase(entry);
+	return true;
+}
@@ -20,6 +20,8 @@
 #define INCLUDED_TUIODISPATCHER_H
 
 #include "TuioListener.h"
+#include <list>
+#include <unordered_map>
 
 #ifdef WIN32
 #include <windows.h>
@@ -155,6 +157,31 @@ namespace TUIO {
 		 * @return  an active TuioBlob corresponding to the provided Session ID or NULL
 		 */
 		TuioBlob* getTuioBlob(long s_id);
+
+		/**
+		 * Returns the internal List of all currently active TuioObjects without copying it.
+		 * The List must only be accessed from the thread updating the session,
+		 * and is not valid for iteration while TuioObjects are being added or removed.
+		 *
+		 * @return  the internal List of all currently active TuioObjects
+		 */
+		const std::list<TuioObject*>& getTuioObjectList() const { return objectList; };
+
+		/**
+		 * Returns the internal List of all currently active TuioCursors without copying it.
+		 * The same access restrictions as for getTuioObjectList apply.
+		 *
+		 * @return  the internal List of all currently active TuioCursors
+		 */
+		const std::list<TuioCursor*>& getTuioCursorList() const { return cursorList; };
+
+		/**
+		 * Returns the internal List of all currently active TuioBlobs without copying it.
+		 * The same access restrictions as for getTuioObjectList apply.
+		 *
+		 * @return  the internal List of all currently active TuioBlobs
+		 */
+		const std::list<TuioBlob*>& getTuioBlobList() const { return blobList; };
 		
 		/**
 		 * Locks the TuioObject list in order to avoid updates during access
@@ -192,6 +219,18 @@ namespace TUIO {
 		std::list<TuioObject*> objectList;
 		std::list<TuioCursor*> cursorList;
 		std::list<TuioBlob*> blobList;
+
+		// the session ID indices refer to the list entries, which allows constant time lookup and removal
+		std::unordered_map<long, std::list<TuioObject*>::iterator> objectIndex;
+		std::unordered_map<long, std::list<TuioCursor*>::iterator> cursorIndex;
+		std::unordered_map<long, std::list<TuioBlob*>::iterator> blobIndex;
+
+		void addObjectEntry(TuioObject *tobj);
+		bool removeObjectEntry(TuioObject *tobj);
+		void addCursorEntry(TuioCursor *tcur);
+		bool removeCursorEntry(TuioCursor *tcur);
+		void addBlobEntry(TuioBlob *tblb);
+		bool removeBlobEntry(TuioBlob *tblb);
 		
 #ifdef WIN32
 		HANDLE objectMutex;
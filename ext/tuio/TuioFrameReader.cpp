@@ -0,0 +1,195 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#include "TuioFrameReader.h"
+#include "TuioContainer.h"
+#include <algorithm>
+
+#define MAX_FRAME_REORDER 100
+
+using namespace TUIO;
+
+TuioFrameReader::TuioFrameReader(OscSource *receiver)
+: receiver (receiver)
+, frame_update (false)
+{
+#ifdef WIN32
+	frameMutex = CreateMutex(NULL,FALSE,NULL);
+#else
+	pthread_mutex_init(&frameMutex,NULL);
+#endif
+	receiver->setPacketListener(this);
+}
+
+TuioFrameReader::~TuioFrameReader() {
+	receiver->disconnect();
+	receiver->setPacketListener(NULL);
+#ifdef WIN32
+	CloseHandle(frameMutex);
+#else
+	pthread_mutex_destroy(&frameMutex);
+#endif
+}
+
+void TuioFrameReader::lockFrame() {
+#ifdef WIN32
+	WaitForSingleObject(frameMutex, INFINITE);
+#else
+	pthread_mutex_lock(&frameMutex);
+#endif
+}
+
+void TuioFrameReader::unlockFrame() {
+#ifdef WIN32
+	ReleaseMutex(frameMutex);
+#else
+	pthread_mutex_unlock(&frameMutex);
+#endif
+}
+
+bool TuioFrameReader::getFrame(std::vector<tuio_shm_object> &objects, std::vector<tuio_shm_cursor> &cursors, std::vector<tuio_shm_blob> &blobs) {
+
+	lockFrame();
+	bool update = frame_update;
+	if (update) {
+		objects.assign(objectFrame.begin(),objectFrame.end());
+		cursors.assign(cursorFrame.begin(),cursorFrame.end());
+		blobs.assign(blobFrame.begin(),blobFrame.end());
+		frame_update = false;
+	}
+	unlockFrame();
+	return update;
+}
+
+void TuioFrameReader::reset() {
+
+	lockFrame();
+	objectFrame.clear();
+	cursorFrame.clear();
+	blobFrame.clear();
+	frame_update = true;
+	unlockFrame();
+}
+
+template <class T> bool TuioFrameReader::commitProfile(TuioProfile<T> &profile, long fseq, std::vector<T> &frame) {
+
+	// late UDP bundles are ignored, unless the server has been restarted meanwhile,
+	// while a large frame is delivered in several bundles with the same frame sequence
+	bool accept = (fseq==-1) || (fseq>=profile.frame) || (profile.frame-fseq>MAX_FRAME_REORDER);
+
+	if (accept) {
+		std::sort(profile.alive.begin(),profile.alive.end());
+		for (typename std::map<int32_t,T>::iterator component=profile.components.begin(); component!=profile.components.end();) {
+			if (std::binary_search(profile.alive.begin(),profile.alive.end(),component->first)) component++;
+			else profile.components.erase(component++);
+		}
+
+		for (typename std::vector<T>::iterator update=profile.updates.begin(); update!=profile.updates.end(); update++) {
+			if (std::binary_search(profile.alive.begin(),profile.alive.end(),update->session_id)) profile.components[update->session_id] = *update;
+		}
+
+		if (fseq!=-1) profile.frame = fseq;
+	}
+
+	profile.alive.clear();
+	profile.updates.clear();
+	if (!accept) return false;
+
+	lockFrame();
+	frame.clear();
+	for (typename std::map<int32_t,T>::iterator component=profile.components.begin(); component!=profile.components.end(); component++)
+		frame.push_back(component->second);
+	frame_update = true;
+	unlockFrame();
+	return true;
+}
+
+void TuioFrameReader::ProcessMessage( const osc::ReceivedMessage& message, const IpEndpointName& /*remoteEndpoint*/ ) {
+
+	osc::ReceivedMessageArgumentStream args = message.ArgumentStream();
+	const char *cmd;
+	args >> cmd;
+
+	if (strcmp(message.AddressPattern(), "/tuio/2Dobj") == 0) {
+
+		if (strcmp(cmd, "set") == 0) {
+			tuio_shm_object obj;
+			osc::int32 session_id, symbol_id;
+			args >> session_id >> symbol_id >> obj.x >> obj.y >> obj.angle >> obj.x_speed >> obj.y_speed >> obj.rotation_speed >> obj.motion_accel >> obj.rotation_accel;
+			obj.session_id = session_id;
+			obj.symbol_id = symbol_id;
+			obj.state = TUIO_IDLE;
+			objectProfile.updates.push_back(obj);
+		} else if (strcmp(cmd, "alive") == 0) {
+			osc::int32 session_id;
+			while (!args.Eos()) {
+				args >> session_id;
+				objectProfile.alive.push_back(session_id);
+			}
+		} else if (strcmp(cmd, "fseq") == 0) {
+			osc::int32 fseq;
+			args >> fseq;
+			commitProfile(objectProfile, fseq, objectFrame);
+		}
+
+	} else if (strcmp(message.AddressPattern(), "/tuio/2Dcur") == 0) {
+
+		if (strcmp(cmd, "set") == 0) {
+			tuio_shm_cursor cur;
+			osc::int32 session_id;
+			args >> session_id >> cur.x >> cur.y >> cur.x_speed >> cur.y_speed >> cur.motion_accel;
+			cur.session_id = session_id;
+			cur.cursor_id = -1;
+			cur.state = TUIO_IDLE;
+			cursorProfile.updates.push_back(cur);
+		} else if (strcmp(cmd, "alive") == 0) {
+			osc::int32 session_id;
+			while (!args.Eos()) {
+				args >> session_id;
+				cursorProfile.alive.push_back(session_id);
+			}
+		} else if (strcmp(cmd, "fseq") == 0) {
+			osc::int32 fseq;
+			args >> fseq;
+			commitProfile(cursorProfile, fseq, cursorFrame);
+		}
+
+	} else if (strcmp(message.AddressPattern(), "/tuio/2Dblb") == 0) {
+
+		if (strcmp(cmd, "set") == 0) {
+			tuio_shm_blob blb;
+			osc::int32 session_id;
+			args >> session_id >> blb.x >> blb.y >> blb.angle >> blb.width >> blb.height >> blb.area >> blb.x_speed >> blb.y_speed >> blb.rotation_speed >> blb.motion_accel >> blb.rotation_accel;
+			blb.session_id = session_id;
+			blb.blob_id = -1;
+			blb.state = TUIO_IDLE;
+			blobProfile.updates.push_back(blb);
+		} else if (strcmp(cmd, "alive") == 0) {
+			osc::int32 session_id;
+			while (!args.Eos()) {
+				args >> session_id;
+				blobProfile.alive.push_back(session_id);
+			}
+		} else if (strcmp(cmd, "fseq") == 0) {
+			osc::int32 fseq;
+			args >> fseq;
+			commitProfile(blobProfile, fseq, blobFrame);
+		}
+	}
+}
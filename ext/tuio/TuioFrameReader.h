@@ -0,0 +1,141 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#ifndef INCLUDED_TUIOFRAMEREADER_H
+#define INCLUDED_TUIOFRAMEREADER_H
+
+#include "OscSource.h"
+#include "osc/OscReceivedElements.h"
+#include "osc/OscPacketListener.h"
+#include "tuioshm.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <map>
+#include <vector>
+
+namespace TUIO {
+
+	/**
+	 * The TuioFrameReader receives the TUIO 1.1 /tuio/2Dobj, /tuio/2Dcur and /tuio/2Dblb profiles
+	 * of a remote TuioServer through the provided OscSource. It keeps the latest complete frame
+	 * as TuioSnapshot records, which can be polled from another thread, for example by a TuioMerger.
+	 * The components are kept until they are missing from an alive message, therefore also
+	 * the delta updates of a TuioServer can be received.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL TuioFrameReader : public osc::OscPacketListener {
+
+	public:
+
+		/**
+		 * This constructor creates a TuioFrameReader receiving from the provided OscSource
+		 *
+		 * @param  receiver  the OscSource delivering the TUIO packets
+		 */
+		TuioFrameReader(OscSource *receiver);
+
+		/**
+		 * The destructor disconnects the OscSource, which is not deleted though.
+		 */
+		~TuioFrameReader();
+
+		/**
+		 * This method starts receiving TUIO packets
+		 *
+		 * @return true if the OscSource has been started
+		 */
+		bool connect() { return receiver->connect(); };
+
+		/**
+		 * This method stops receiving TUIO packets
+		 */
+		void disconnect() { receiver->disconnect(); };
+
+		/**
+		 * This method returns the connection state of the OscSource
+		 *
+		 * @return true if the OscSource is connected to its source
+		 */
+		bool isConnected() { return receiver->isConnected(); };
+
+		/**
+		 * Copies the components of the latest complete frame, if a new frame has been received since the last call
+		 *
+		 * @param  objects  receives the current TuioObject records
+		 * @param  cursors  receives the current TuioCursor records
+		 * @param  blobs  receives the current TuioBlob records
+		 * @return true if a new frame has been copied
+		 */
+		bool getFrame(std::vector<tuio_shm_object> &objects, std::vector<tuio_shm_cursor> &cursors, std::vector<tuio_shm_blob> &blobs);
+
+		/**
+		 * Removes all received components, for example after the connection has been lost
+		 */
+		void reset();
+
+	protected:
+
+		/**
+		 * This method parses the TUIO messages of the received packets
+		 */
+		void ProcessMessage( const osc::ReceivedMessage& message, const IpEndpointName& remoteEndpoint );
+
+	private:
+
+		/**
+		 * The received state of a single TUIO profile
+		 */
+		template <class T> struct TuioProfile {
+			TuioProfile() : frame(-1) {};
+			std::map<int32_t,T> components;		// the components of the latest frame
+			std::vector<int32_t> alive;			// the alive session IDs of the current bundle
+			std::vector<T> updates;				// the set messages of the current bundle
+			long frame;							// the latest frame sequence number
+		};
+
+		template <class T> bool commitProfile(TuioProfile<T> &profile, long fseq, std::vector<T> &frame);
+		void lockFrame();
+		void unlockFrame();
+
+		OscSource *receiver;
+
+		TuioProfile<tuio_shm_object> objectProfile;
+		TuioProfile<tuio_shm_cursor> cursorProfile;
+		TuioProfile<tuio_shm_blob> blobProfile;
+
+		std::vector<tuio_shm_object> objectFrame;
+		std::vector<tuio_shm_cursor> cursorFrame;
+		std::vector<tuio_shm_blob> blobFrame;
+		bool frame_update;
+
+#ifdef WIN32
+		HANDLE frameMutex;
+#else
+		pthread_mutex_t frameMutex;
+#endif
+	};
+}
+#endif /* INCLUDED_TUIOFRAMEREADER_H */
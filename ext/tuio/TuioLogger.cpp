@@ -0,0 +1,187 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#include "TuioLogger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <set>
+
+using namespace TUIO;
+
+// the kind of each attribute following the IDs, which determines its tolerance:
+// p for positions and sizes, a for angles and s for velocities and accelerations
+static const char *objectFields = "ppasssss";
+static const char *cursorFields = "ppsss";
+static const char *blobFields = "ppapppsssss";
+
+TuioLogger::TuioLogger(TuioManager *tm, const char *file)
+	:manager	(tm)
+	,frameCount	(0)
+{
+	log = fopen(file,"w");
+	if (log==NULL) {
+		std::cerr << "could not create TUIO log: " << file << std::endl;
+		throw std::exception();
+	}
+	fprintf(log,"# frame event type session_id id attributes\n");
+	manager->addTuioListener(this);
+}
+
+TuioLogger::~TuioLogger() {
+
+	manager->removeTuioListener(this);
+	fclose(log);
+}
+
+void TuioLogger::refresh(TuioTime /*ftime*/) {
+	frameCount++;
+}
+
+void TuioLogger::logTuioObject(const char *event, TuioObject *tobj) {
+	fprintf(log,"%ld %s obj %ld %d %f %f %f %f %f %f %f %f\n",frameCount,event,tobj->getSessionID(),tobj->getSymbolID(),
+			tobj->getX(),tobj->getY(),tobj->getAngle(),tobj->getXSpeed(),tobj->getYSpeed(),tobj->getRotationSpeed(),tobj->getMotionAccel(),tobj->getRotationAccel());
+}
+
+void TuioLogger::logTuioCursor(const char *event, TuioCursor *tcur) {
+	fprintf(log,"%ld %s cur %ld %d %f %f %f %f %f\n",frameCount,event,tcur->getSessionID(),tcur->getCursorID(),
+			tcur->getX(),tcur->getY(),tcur->getXSpeed(),tcur->getYSpeed(),tcur->getMotionAccel());
+}
+
+void TuioLogger::logTuioBlob(const char *event, TuioBlob *tblb) {
+	fprintf(log,"%ld %s blb %ld %d %f %f %f %f %f %f %f %f %f %f %f\n",frameCount,event,tblb->getSessionID(),tblb->getBlobID(),
+			tblb->getX(),tblb->getY(),tblb->getAngle(),tblb->getWidth(),tblb->getHeight(),tblb->getArea(),
+			tblb->getXSpeed(),tblb->getYSpeed(),tblb->getRotationSpeed(),tblb->getMotionAccel(),tblb->getRotationAccel());
+}
+
+bool TuioLogger::compareLines(const char *golden, const char *line) {
+
+	std::istringstream golden_stream(golden);
+	std::istringstream line_stream(line);
+	std::string golden_token, line_token;
+
+	// the frame number, event, type, session ID and component ID need to be identical
+	std::string type;
+	for (int i=0;i<5;i++) {
+		golden_stream >> golden_token;
+		line_stream >> line_token;
+		if (golden_token!=line_token) return false;
+		if (i==2) type = golden_token;
+	}
+
+	const char *fields = NULL;
+	if (type=="obj") fields = objectFields;
+	else if (type=="cur") fields = cursorFields;
+	else if (type=="blb") fields = blobFields;
+	else return false;
+
+	for (const char *kind=fields; *kind; kind++) {
+		double golden_value, value;
+		if (!(golden_stream >> golden_value) || !(line_stream >> value)) return false;
+		double diff = fabs(golden_value-value);
+
+		switch (*kind) {
+			case 'p':
+				if (diff>LOG_POSITION_TOLERANCE) return false;
+				break;
+			case 'a':
+				if (diff>M_PI) diff = 2*M_PI-diff;
+				if (diff>LOG_ANGLE_TOLERANCE) return false;
+				break;
+			case 's':
+				if (diff>LOG_SPEED_TOLERANCE*(fabs(golden_value)>1.0 ? fabs(golden_value) : 1.0)) return false;
+				break;
+		}
+	}
+
+	return !(line_stream >> line_token);
+}
+
+// collects the lines of each frame, comments are kept as frame -1
+static void readFrames(std::ifstream &stream, std::map<long, std::vector<std::string> > &frames) {
+
+	std::string line;
+	while (std::getline(stream,line)) {
+		if (line.empty()) continue;
+		long frame = (line[0]=='#') ? -1 : atol(line.c_str());
+		frames[frame].push_back(line);
+	}
+}
+
+bool TuioLogger::compareFrames(const std::vector<std::string> &golden, const std::vector<std::string> &lines) {
+
+	if (golden.size()!=lines.size()) return false;
+	for (unsigned int i=0;i<golden.size();i++) {
+		// comments are only compared literally
+		if (golden[i][0]=='#') {
+			if (golden[i]!=lines[i]) return false;
+		} else if (!compareLines(golden[i].c_str(),lines[i].c_str())) return false;
+	}
+	return true;
+}
+
+int TuioLogger::compareLogs(const char *golden, const char *file) {
+
+	std::ifstream golden_stream(golden);
+	if (!golden_stream.good()) {
+		std::cerr << "could not read TUIO log: " << golden << std::endl;
+		return -1;
+	}
+
+	std::ifstream log_stream(file);
+	if (!log_stream.good()) {
+		std::cerr << "could not read TUIO log: " << file << std::endl;
+		return -1;
+	}
+
+	std::map<long, std::vector<std::string> > golden_frames, log_frames;
+	readFrames(golden_stream,golden_frames);
+	readFrames(log_stream,log_frames);
+
+	std::set<long> frames;
+	for (std::map<long, std::vector<std::string> >::iterator iter=golden_frames.begin(); iter!=golden_frames.end(); iter++) frames.insert(iter->first);
+	for (std::map<long, std::vector<std::string> >::iterator iter=log_frames.begin(); iter!=log_frames.end(); iter++) frames.insert(iter->first);
+
+	// a missing or additional event only affects its own frame
+	int differences = 0;
+	std::vector<std::string> empty;
+	for (std::set<long>::iterator frame=frames.begin(); frame!=frames.end(); frame++) {
+		std::map<long, std::vector<std::string> >::iterator golden_frame = golden_frames.find(*frame);
+		std::map<long, std::vector<std::string> >::iterator log_frame = log_frames.find(*frame);
+		const std::vector<std::string> &golden_lines = (golden_frame==golden_frames.end()) ? empty : golden_frame->second;
+		const std::vector<std::string> &lines = (log_frame==log_frames.end()) ? empty : log_frame->second;
+		if (compareFrames(golden_lines,lines)) continue;
+
+		differences++;
+		if (differences==1) {
+			std::cout << "first differing frame " << *frame << ":" << std::endl;
+			if (golden_lines.empty()) std::cout << "< (no events)" << std::endl;
+			for (unsigned int i=0;i<golden_lines.size();i++) std::cout << "< " << golden_lines[i] << std::endl;
+			if (lines.empty()) std::cout << "> (no events)" << std::endl;
+			for (unsigned int i=0;i<lines.size();i++) std::cout << "> " << lines[i] << std::endl;
+		}
+	}
+
+	return differences;
+}
@@ -0,0 +1,112 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#ifndef INCLUDED_TUIOLOGGER_H
+#define INCLUDED_TUIOLOGGER_H
+
+#include "TuioListener.h"
+#include "TuioManager.h"
+#include <stdio.h>
+#include <vector>
+#include <string>
+
+#define LOG_POSITION_TOLERANCE 0.0005f
+#define LOG_ANGLE_TOLERANCE 0.005f
+#define LOG_SPEED_TOLERANCE 0.01f
+
+namespace TUIO {
+
+	/**
+	 * The TuioLogger writes all component events of a TuioManager into a canonical text log,
+	 * which contains one line per added, updated or removed TuioObject, TuioCursor or TuioBlob.
+	 * Each line starts with the frame number, the event (add, set or del), the component type (obj, cur or blb),
+	 * the session ID and the symbol, cursor or blob ID, followed by all component attributes in the order of the TUIO messages.
+	 * Together with a fixed TuioTime a replayed frame sequence always produces the same log,
+	 * which then can be compared to a previously recorded golden log.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL TuioLogger : public TuioListener {
+
+	public:
+
+		/**
+		 * This constructor creates the log file and attaches to the provided TuioManager
+		 *
+		 * @param  manager  the TuioManager providing the logged events
+		 * @param  file  the path of the created log file
+		 */
+		TuioLogger(TuioManager *manager, const char *file);
+
+		/**
+		 * The destructor detaches from the TuioManager and closes the log file
+		 */
+		virtual ~TuioLogger();
+
+		void addTuioObject(TuioObject *tobj) { logTuioObject("add",tobj); };
+		void updateTuioObject(TuioObject *tobj) { logTuioObject("set",tobj); };
+		void removeTuioObject(TuioObject *tobj) { logTuioObject("del",tobj); };
+		void addTuioCursor(TuioCursor *tcur) { logTuioCursor("add",tcur); };
+		void updateTuioCursor(TuioCursor *tcur) { logTuioCursor("set",tcur); };
+		void removeTuioCursor(TuioCursor *tcur) { logTuioCursor("del",tcur); };
+		void addTuioBlob(TuioBlob *tblb) { logTuioBlob("add",tblb); };
+		void updateTuioBlob(TuioBlob *tblb) { logTuioBlob("set",tblb); };
+		void removeTuioBlob(TuioBlob *tblb) { logTuioBlob("del",tblb); };
+
+		/**
+		 * Advances the frame number of the following events
+		 *
+		 * @param  ftime  the TuioTime of the committed frame
+		 */
+		void refresh(TuioTime ftime);
+
+		/**
+		 * Returns the number of committed frames
+		 *
+		 * @return the number of committed frames
+		 */
+		long getFrameCount() { return frameCount; };
+
+		/**
+		 * Compares a log to a golden log frame by frame. The events of each frame, their types and IDs need to be identical,
+		 * while positions, sizes and angles may differ by an absolute tolerance and velocities and accelerations by a relative tolerance.
+		 * The events of the first differing frame are reported on the standard output.
+		 *
+		 * @param  golden  the path of the golden log
+		 * @param  file  the path of the compared log
+		 * @return the number of differing frames, or -1 if one of the logs could not be read
+		 */
+		static int compareLogs(const char *golden, const char *file);
+
+	private:
+		void logTuioObject(const char *event, TuioObject *tobj);
+		void logTuioCursor(const char *event, TuioCursor *tcur);
+		void logTuioBlob(const char *event, TuioBlob *tblb);
+
+		static bool compareLines(const char *golden, const char *line);
+		static bool compareFrames(const std::vector<std::string> &golden, const std::vector<std::string> &lines);
+
+		TuioManager *manager;
+		FILE *log;
+		long frameCount;
+	};
+}
+
+#endif /* INCLUDED_TUIOLOGGER_H */
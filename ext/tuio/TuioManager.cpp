@@ -22,10 +22,12 @@ using namespace TUIO;
 
 TuioManager::TuioManager() 
 	: currentFrameTime(TuioTime::getSystemTime())
+	, frameStartTime(TuioTime::getSystemTime())
 	, currentFrame(-1)
 	, maxCursorID(-1)
 	, maxBlobID(-1)
 	, sessionID(-1)
+	, path_size(MAX_PATH_SIZE)
 	, updateObject(false)
 	, updateCursor(false)
 	, updateBlob(false)
@@ -44,7 +46,8 @@ TuioManager::~TuioManager() {
 TuioObject* TuioManager::addTuioObject(int f_id, float x, float y, float a) {
 	sessionID++;
 	TuioObject *tobj = new TuioObject(currentFrameTime, sessionID, f_id, x, y, a);
-	objectList.push_back(tobj);
+	tobj->setPathSize(path_size);
+	addObjectEntry(tobj);
 	updateObject = true;
 
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
@@ -59,7 +62,7 @@ TuioObject* TuioManager::addTuioObject(int f_id, float x, float y, float a) {
 void TuioManager::addExternalTuioObject(TuioObject *tobj) {
 	if (tobj==NULL) return;
 	tobj->setSessionID(++sessionID);
-	objectList.push_back(tobj);
+	addObjectEntry(tobj);
 	updateObject = true;
 
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
@@ -108,14 +111,14 @@ void TuioManager::removeTuioObject(TuioObject *tobj) {
 	if (verbose)
 		std::cout << "del obj " << tobj->getSymbolID() << " (" << tobj->getSessionID() << ")" << std::endl;
     
-    objectList.remove(tobj);
+    removeObjectEntry(tobj);
     delete tobj;
     updateObject = true;
 }
 
 void TuioManager::removeExternalTuioObject(TuioObject *tobj) {
 	if (tobj==NULL) return;
-	objectList.remove(tobj);
+	removeObjectEntry(tobj);
 	updateObject = true;
 
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
@@ -143,7 +146,8 @@ TuioCursor* TuioManager::addTuioCursor(float x, float y) {
 	} else maxCursorID = cursorID;	
 	
 	TuioCursor *tcur = new TuioCursor(currentFrameTime, sessionID, cursorID, x, y);
-	cursorList.push_back(tcur);
+	tcur->setPathSize(path_size);
+	addCursorEntry(tcur);
 	updateCursor = true;
 
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
@@ -158,7 +162,7 @@ TuioCursor* TuioManager::addTuioCursor(float x, float y) {
 void TuioManager::addExternalTuioCursor(TuioCursor *tcur) {
 	if (tcur==NULL) return;
 	tcur->setSessionID(++sessionID);
-	cursorList.push_back(tcur);
+	addCursorEntry(tcur);
 	updateCursor = true;
 
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
@@ -204,7 +208,7 @@ void TuioManager::removeTuioCursor(TuioCursor *tcur) {
 	if (verbose && tcur->getTuioState()!=TUIO_ADDED)
 		std::cout << "del cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ")" << std::endl;
 	
-	cursorList.remove(tcur);
+	removeCursorEntry(tcur);
 	tcur->remove(currentFrameTime);
 	updateCursor = true;
 
@@ -249,7 +253,7 @@ void TuioManager::removeExternalTuioCursor(TuioCursor *tcur) {
 	if (verbose && tcur->getTuioState()!=TUIO_ADDED)
 		std::cout << "del cur " << tcur->getCursorID() << " (" <<  tcur->getSessionID() << ")" << std::endl;
 	
-	cursorList.remove(tcur);
+	removeCursorEntry(tcur);
 	updateCursor = true;
 
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
@@ -258,6 +262,10 @@ void TuioManager::removeExternalTuioCursor(TuioCursor *tcur) {
 
 TuioBlob* TuioManager::addTuioBlob(float x, float y, float a, float w, float h, float f) {
 	sessionID++;
+	return addTuioBlob(sessionID, x, y, a, w, h, f);
+}
+
+TuioBlob* TuioManager::addTuioBlob(long s_id, float x, float y, float a, float w, float h, float f) {
 	
 	int blobID = (int)blobList.size();
 	if ((int)(blobList.size())<=maxBlobID) {
@@ -273,8 +281,9 @@ TuioBlob* TuioManager::addTuioBlob(float x, float y, float a, float w, float h,
 		delete freeBlob;
 	} else maxBlobID = blobID;	
 	
-	TuioBlob *tblb = new TuioBlob(currentFrameTime, sessionID, blobID, x, y, a, w, h, f);
-	blobList.push_back(tblb);
+	TuioBlob *tblb = new TuioBlob(currentFrameTime, s_id, blobID, x, y, a, w, h, f);
+	tblb->setPathSize(path_size);
+	addBlobEntry(tblb);
 	updateBlob = true;
 	
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
@@ -306,7 +315,7 @@ void TuioManager::addExternalTuioBlob(TuioBlob *tblb) {
 	tblb->setSessionID(++sessionID);
 	tblb->setBlobID(blobID);
 	
-	blobList.push_back(tblb);
+	addBlobEntry(tblb);
 	updateBlob = true;
 	
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
@@ -352,7 +361,7 @@ void TuioManager::removeTuioBlob(TuioBlob *tblb) {
 	if (verbose && tblb->getTuioState()!=TUIO_ADDED)
 		std::cout << "del blb " << tblb->getBlobID() << " (" <<  tblb->getSessionID() << ")" << std::endl;
 	
-	blobList.remove(tblb);
+	removeBlobEntry(tblb);
 	tblb->remove(currentFrameTime);
 	updateBlob = true;
 
@@ -398,7 +407,7 @@ void TuioManager::removeExternalTuioBlob(TuioBlob *tblb) {
 	if (verbose && tblb->getTuioState()!=TUIO_ADDED)
 		std::cout << "del blb " << tblb->getBlobID() << " (" <<  tblb->getSessionID() << ")" << std::endl;
 	
-	blobList.remove(tblb);
+	removeBlobEntry(tblb);
 	updateBlob = true;
 	
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
@@ -419,10 +428,37 @@ TuioTime TuioManager::getFrameTime() {
 }
 
 void TuioManager::initFrame(TuioTime ttime) {
+	// the provided frame time may be a session time, so the processing latency is measured separately
+	initFrame(ttime, TuioTime::getSystemTime());
+}
+
+void TuioManager::initFrame(TuioTime ttime, TuioTime stime) {
 	currentFrameTime = TuioTime(ttime);
+	frameStartTime = TuioTime(stime);
 	currentFrame++;
 }
 
+void TuioManager::setBlobSessionID(TuioBlob *tblb, long s_id) {
+	if (tblb==NULL) return;
+	std::unordered_map<long, std::list<TuioBlob*>::iterator>::iterator entry = blobIndex.find(tblb->getSessionID());
+	if ((entry!=blobIndex.end()) && (*(entry->second)==tblb)) {
+		std::list<TuioBlob*>::iterator item = entry->second;
+		blobIndex.erase(entry);
+		blobIndex[s_id] = item;
+	}
+	tblb->setSessionID(s_id);
+}
+
+void TuioManager::enablePathHistory(bool flag) {
+	path_size = flag ? MAX_PATH_SIZE : 1;
+	for (std::list<TuioObject*>::iterator iter=objectList.begin(); iter != objectList.end(); iter++)
+		(*iter)->setPathSize(path_size);
+	for (std::list<TuioCursor*>::iterator iter=cursorList.begin(); iter != cursorList.end(); iter++)
+		(*iter)->setPathSize(path_size);
+	for (std::list<TuioBlob*>::iterator iter=blobList.begin(); iter != blobList.end(); iter++)
+		(*iter)->setPathSize(path_size);
+}
+
 void TuioManager::commitFrame() {
 	for (std::list<TuioListener*>::iterator listener=listenerList.begin(); listener != listenerList.end(); listener++)
 		(*listener)->refresh(currentFrameTime);
@@ -504,13 +540,11 @@ void TuioManager::stopUntouchedMovingObjects() {
 
 void TuioManager::removeUntouchedStoppedObjects() {
 	
+	// removing a TuioObject only invalidates its own list entry
 	std::list<TuioObject*>::iterator tuioObject = objectList.begin();
 	while (tuioObject!=objectList.end()) {
-		TuioObject *tobj = (*tuioObject);
-		if ((tobj->getTuioTime()!=currentFrameTime) && (!tobj->isMoving())) {
-			removeTuioObject(tobj);
-			tuioObject = objectList.begin();
-		} else tuioObject++;
+		TuioObject *tobj = (*tuioObject++);
+		if ((tobj->getTuioTime()!=currentFrameTime) && (!tobj->isMoving())) removeTuioObject(tobj);
 	}
 }
 
@@ -553,11 +587,8 @@ void TuioManager::removeUntouchedStoppedCursors() {
 	if (cursorList.size()==0) return;
 	std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin();
 	while (tuioCursor!=cursorList.end()) {
-		TuioCursor *tcur = (*tuioCursor);
-		if ((tcur->getTuioTime()!=currentFrameTime) && (!tcur->isMoving())) {
-			removeTuioCursor(tcur);
-			tuioCursor = cursorList.begin();
-		} else tuioCursor++;
+		TuioCursor *tcur = (*tuioCursor++);
+		if ((tcur->getTuioTime()!=currentFrameTime) && (!tcur->isMoving())) removeTuioCursor(tcur);
 	}	
 }
 
@@ -599,11 +630,8 @@ void TuioManager::removeUntouchedStoppedBlobs() {
 	
 	std::list<TuioBlob*>::iterator tuioBlob = blobList.begin();
 	while (tuioBlob!=blobList.end()) {
-		TuioBlob *tblb = (*tuioBlob);
-		if ((tblb->getTuioTime()!=currentFrameTime) && (!tblb->isMoving())) {
-			removeTuioBlob(tblb);
-			tuioBlob = blobList.begin();
-		} else tuioBlob++;
+		TuioBlob *tblb = (*tuioBlob++);
+		if ((tblb->getTuioTime()!=currentFrameTime) && (!tblb->isMoving())) removeTuioBlob(tblb);
 	}	
 }
 
@@ -71,7 +71,7 @@ namespace TUIO {
 		/**
 		 * The destructor is doing nothing in particular. 
 		 */
-		~TuioManager();
+		virtual ~TuioManager();
 		
 		/**
 		 * Creates a new TuioObject based on the given arguments.
@@ -190,6 +190,23 @@ namespace TUIO {
 		 * @return	reference to the created TuioBlob
 		 */
 		TuioBlob* addTuioBlob(float xp, float yp, float angle, float width, float height, float area);
+
+		/**
+		 * Creates a new TuioBlob with the given Session ID, which associates the TuioBlob
+		 * with the TuioObject or TuioCursor using the same Session ID.
+		 * The new TuioBlob is added to the TuioServer's internal list of active TuioBlobs
+		 * and a reference is returned to the caller.
+		 *
+		 * @param	s_id	the Session ID to assign
+		 * @param	xp	the X coordinate to assign
+		 * @param	yp	the Y coordinate to assign
+		 * @param	angle	the angle to assign
+		 * @param	width	the width to assign
+		 * @param	height	the height to assign
+		 * @param	area	the area to assign
+		 * @return	reference to the created TuioBlob
+		 */
+		TuioBlob* addTuioBlob(long s_id, float xp, float yp, float angle, float width, float height, float area);
 		
 		/**
 		 * Updates the referenced TuioBlob based on the given arguments.
@@ -240,12 +257,21 @@ namespace TUIO {
 		 * @param	ttime	the frame time
 		 */
 		void initFrame(TuioTime ttime);
+
+		/**
+		 * Initializes a new frame with the given TuioTime and the system time
+		 * at which the processing of this frame has started
+		 *
+		 * @param	ttime	the frame time
+		 * @param	stime	the system time at the start of the frame processing
+		 */
+		void initFrame(TuioTime ttime, TuioTime stime);
 		
 		/**
 		 * Commits the current frame.
 		 * Generates and sends TUIO messages of all currently active and updated TuioObjects and TuioCursors.
 		 */
-		void commitFrame();
+		virtual void commitFrame();
 
 		/**
 		 * Returns the next available Session ID for external use.
@@ -359,6 +385,23 @@ namespace TUIO {
 		bool getInvertXpos() { return invert_x; };
 		bool getInvertYpos() { return invert_y; };
 		bool getInvertAngle() { return invert_a; };
+
+		/**
+		 * Assigns another Session ID to an active TuioBlob, which associates the TuioBlob
+		 * with the TuioObject or TuioCursor using the same Session ID
+		 * @param	tblb	the active TuioBlob
+		 * @param	s_id	the Session ID to assign
+		 */
+		void setBlobSessionID(TuioBlob *tblb, long s_id);
+
+		/**
+		 * Enables or disables the path history of all current and future TUIO components.
+		 * Without path history only the current position of each component is kept.
+		 * @param	flag	keep up to MAX_PATH_SIZE previous positions if set to true
+		 */
+		void enablePathHistory(bool flag);
+		bool pathHistoryEnabled() { return (path_size>1); };
+
 		void resetTuioObjects();
 		void resetTuioCursors();		
 		void resetTuioBlobs();		
@@ -371,10 +414,12 @@ namespace TUIO {
 		std::list<TuioBlob*> freeBlobBuffer;
 
 		TuioTime currentFrameTime;
+		TuioTime frameStartTime;
 		long currentFrame;
 		int maxCursorID;
 		int maxBlobID;
 		long sessionID;
+		unsigned int path_size;
 
 		bool updateObject;
 		bool updateCursor;
@@ -0,0 +1,334 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#include "TuioMerger.h"
+#include <climits>
+
+using namespace TUIO;
+
+TuioMerger::TuioMerger(TuioManager *tm, float distance)
+	:manager		(tm)
+	,merge_distance	(distance)
+	,source_timeout	(0.0f)
+{
+}
+
+TuioMerger::~TuioMerger() {
+
+	manager->initFrame(TuioTime::getSystemTime());
+	for (std::list<MergeEntry*>::iterator entry=objectEntries.begin(); entry!=objectEntries.end(); entry++) {
+		manager->removeTuioObject((TuioObject*)(*entry)->container);
+		delete *entry;
+	}
+	for (std::list<MergeEntry*>::iterator entry=cursorEntries.begin(); entry!=cursorEntries.end(); entry++) {
+		manager->removeTuioCursor((TuioCursor*)(*entry)->container);
+		delete *entry;
+	}
+	for (std::list<MergeEntry*>::iterator entry=blobEntries.begin(); entry!=blobEntries.end(); entry++) {
+		manager->removeTuioBlob((TuioBlob*)(*entry)->container);
+		delete *entry;
+	}
+	manager->commitFrame();
+
+	for (unsigned int i=0;i<sourceList.size();i++) delete sourceList[i];
+}
+
+int TuioMerger::addSource(float x, float y, float width, float height, float angle) {
+
+	MergeSource *src = new MergeSource();
+	src->x = x;
+	src->y = y;
+	src->width = width;
+	src->height = height;
+	src->angle = angle;
+	src->cos_a = cosf(angle);
+	src->sin_a = sinf(angle);
+	src->active = false;
+
+	sourceList.push_back(src);
+	return (int)sourceList.size()-1;
+}
+
+void TuioMerger::updateSource(int source, const std::vector<tuio_shm_object> &objects, const std::vector<tuio_shm_cursor> &cursors, const std::vector<tuio_shm_blob> &blobs) {
+
+	if ((source<0) || (source>=(int)sourceList.size())) return;
+	MergeSource *src = sourceList[source];
+
+	src->objects.assign(objects.begin(),objects.end());
+	src->cursors.assign(cursors.begin(),cursors.end());
+	src->blobs.assign(blobs.begin(),blobs.end());
+	src->updateTime = TuioTime::getSystemTime();
+	src->active = true;
+}
+
+void TuioMerger::clearSource(int source) {
+
+	if ((source<0) || (source>=(int)sourceList.size())) return;
+	MergeSource *src = sourceList[source];
+
+	src->objects.clear();
+	src->cursors.clear();
+	src->blobs.clear();
+	src->active = false;
+}
+
+void TuioMerger::mapRecord(MergeSource *src, float xp, float yp, float a, MergeRecord *record) {
+
+	// the source coordinates are scaled to the region and rotated around its center
+	float dx = (xp-0.5f)*src->width;
+	float dy = (yp-0.5f)*src->height;
+	float gx = src->x + src->width/2.0f + dx*src->cos_a - dy*src->sin_a;
+	float gy = src->y + src->height/2.0f + dx*src->sin_a + dy*src->cos_a;
+
+	if (gx<0) gx = 0; else if (gx>1) gx = 1;
+	if (gy<0) gy = 0; else if (gy>1) gy = 1;
+	record->x = gx;
+	record->y = gy;
+
+	float ga = a + src->angle;
+	while (ga >= 2*M_PI) ga -= 2.0f*(float)M_PI;
+	while (ga < 0) ga += 2.0f*(float)M_PI;
+	record->angle = ga;
+}
+
+void TuioMerger::mergeRecords(std::list<MergeEntry*> &entries, MergeIndex &index, std::vector<MergeRecord> &records, bool match_symbol, std::vector<MergeEntry*> &removed) {
+
+	for (std::list<MergeEntry*>::iterator entry=entries.begin(); entry!=entries.end(); entry++)
+		(*entry)->state_link = UINT_MAX;
+
+	// first assign the records of already linked source components,
+	// where the oldest link of each merged component provides its state
+	std::vector<MergeRecord*> unmatched;
+	for (std::vector<MergeRecord>::iterator record=records.begin(); record!=records.end(); record++) {
+		MergeIndex::iterator link = index.find(std::make_pair(record->source,record->session_id));
+		if (link==index.end()) {
+			unmatched.push_back(&(*record));
+			continue;
+		}
+
+		MergeEntry *entry = link->second;
+		for (unsigned int i=0;i<entry->links.size();i++) {
+			if ((entry->links[i].source!=record->source) || (entry->links[i].session_id!=record->session_id)) continue;
+			entry->links[i].seen = true;
+			if (i<entry->state_link) {
+				entry->state_link = i;
+				entry->x = record->x;
+				entry->y = record->y;
+				entry->angle = record->angle;
+				entry->width = record->width;
+				entry->height = record->height;
+				entry->area = record->area;
+			}
+			break;
+		}
+	}
+
+	// new source components are linked to the closest merged component within the merge distance,
+	// which is not yet reported by the same source, otherwise they create a new merged component
+	float max_distance = merge_distance*merge_distance;
+	for (std::vector<MergeRecord*>::iterator iter=unmatched.begin(); iter!=unmatched.end(); iter++) {
+		MergeRecord *record = *iter;
+
+		MergeEntry *closest = NULL;
+		float closest_distance = max_distance;
+		for (std::list<MergeEntry*>::iterator entry=entries.begin(); entry!=entries.end(); entry++) {
+			if (match_symbol && ((*entry)->symbol_id!=record->symbol_id)) continue;
+			float dx = (*entry)->x - record->x;
+			float dy = (*entry)->y - record->y;
+			float distance = dx*dx+dy*dy;
+			if (distance>=closest_distance) continue;
+
+			bool linked = false;
+			for (unsigned int i=0;i<(*entry)->links.size();i++) {
+				if ((*entry)->links[i].source==record->source) { linked = true; break; }
+			}
+			if (linked) continue;
+
+			closest = *entry;
+			closest_distance = distance;
+		}
+
+		if (closest==NULL) {
+			closest = new MergeEntry();
+			closest->container = NULL;
+			closest->symbol_id = record->symbol_id;
+			closest->state_link = UINT_MAX;
+			entries.push_back(closest);
+		}
+
+		MergeLink link = { record->source, record->session_id, true };
+		closest->links.push_back(link);
+		index[std::make_pair(record->source,record->session_id)] = closest;
+
+		if (closest->state_link==UINT_MAX) {
+			closest->state_link = (unsigned int)closest->links.size()-1;
+			closest->x = record->x;
+			closest->y = record->y;
+			closest->angle = record->angle;
+			closest->width = record->width;
+			closest->height = record->height;
+			closest->area = record->area;
+		}
+	}
+
+	// drop the links of vanished source components and the merged components without any link
+	for (std::list<MergeEntry*>::iterator iter=entries.begin(); iter!=entries.end(); ) {
+		MergeEntry *entry = *iter;
+		for (std::vector<MergeLink>::iterator link=entry->links.begin(); link!=entry->links.end(); ) {
+			if (link->seen) {
+				link->seen = false;
+				link++;
+			} else {
+				index.erase(std::make_pair(link->source,link->session_id));
+				link = entry->links.erase(link);
+			}
+		}
+
+		if (entry->links.empty()) {
+			removed.push_back(entry);
+			iter = entries.erase(iter);
+		} else iter++;
+	}
+}
+
+long TuioMerger::linkedSessionID(const MergeLink &link) {
+
+	// the source session IDs are unique for the objects and cursors of each source
+	MergeIndex::iterator owner = objectIndex.find(std::make_pair(link.source,link.session_id));
+	if ((owner==objectIndex.end()) || (owner->second->container==NULL)) {
+		owner = cursorIndex.find(std::make_pair(link.source,link.session_id));
+		if ((owner==cursorIndex.end()) || (owner->second->container==NULL)) return -1;
+	}
+	return owner->second->container->getSessionID();
+}
+
+void TuioMerger::commitFrame(TuioTime ftime) {
+
+	TuioTime currentTime = TuioTime::getSystemTime();
+	for (unsigned int i=0;i<sourceList.size();i++) {
+		MergeSource *src = sourceList[i];
+		if ((!src->active) || (source_timeout<=0)) continue;
+		TuioTime diffTime = currentTime - src->updateTime;
+		if (diffTime.getSeconds() + diffTime.getMicroseconds()/1000000.0f > source_timeout) clearSource((int)i);
+	}
+
+	manager->initFrame(ftime);
+
+	records.clear();
+	for (unsigned int i=0;i<sourceList.size();i++) {
+		MergeSource *src = sourceList[i];
+		for (std::vector<tuio_shm_object>::iterator obj=src->objects.begin(); obj!=src->objects.end(); obj++) {
+			MergeRecord record;
+			record.source = (int)i;
+			record.session_id = obj->session_id;
+			record.symbol_id = obj->symbol_id;
+			record.width = record.height = record.area = 0.0f;
+			mapRecord(src, obj->x, obj->y, obj->angle, &record);
+			records.push_back(record);
+		}
+	}
+
+	removed.clear();
+	mergeRecords(objectEntries, objectIndex, records, true, removed);
+	for (std::vector<MergeEntry*>::iterator entry=removed.begin(); entry!=removed.end(); entry++) {
+		if ((*entry)->container) manager->removeTuioObject((TuioObject*)(*entry)->container);
+		delete *entry;
+	}
+	for (std::list<MergeEntry*>::iterator iter=objectEntries.begin(); iter!=objectEntries.end(); iter++) {
+		MergeEntry *entry = *iter;
+		TuioObject *tobj = (TuioObject*)entry->container;
+		if (tobj==NULL) entry->container = manager->addTuioObject(entry->symbol_id, entry->x, entry->y, entry->angle);
+		else if ((tobj->getX()!=entry->x) || (tobj->getY()!=entry->y) || (tobj->getAngle()!=entry->angle))
+			manager->updateTuioObject(tobj, entry->x, entry->y, entry->angle);
+	}
+
+	records.clear();
+	for (unsigned int i=0;i<sourceList.size();i++) {
+		MergeSource *src = sourceList[i];
+		for (std::vector<tuio_shm_cursor>::iterator cur=src->cursors.begin(); cur!=src->cursors.end(); cur++) {
+			MergeRecord record;
+			record.source = (int)i;
+			record.session_id = cur->session_id;
+			record.symbol_id = 0;
+			record.width = record.height = record.area = 0.0f;
+			mapRecord(src, cur->x, cur->y, 0.0f, &record);
+			records.push_back(record);
+		}
+	}
+
+	removed.clear();
+	mergeRecords(cursorEntries, cursorIndex, records, false, removed);
+	for (std::vector<MergeEntry*>::iterator entry=removed.begin(); entry!=removed.end(); entry++) {
+		if ((*entry)->container) manager->removeTuioCursor((TuioCursor*)(*entry)->container);
+		delete *entry;
+	}
+	for (std::list<MergeEntry*>::iterator iter=cursorEntries.begin(); iter!=cursorEntries.end(); iter++) {
+		MergeEntry *entry = *iter;
+		TuioCursor *tcur = (TuioCursor*)entry->container;
+		if (tcur==NULL) entry->container = manager->addTuioCursor(entry->x, entry->y);
+		else if ((tcur->getTuioState()==TUIO_ADDED) || (tcur->getX()!=entry->x) || (tcur->getY()!=entry->y))
+			manager->updateTuioCursor(tcur, entry->x, entry->y);
+	}
+
+	records.clear();
+	for (unsigned int i=0;i<sourceList.size();i++) {
+		MergeSource *src = sourceList[i];
+		for (std::vector<tuio_shm_blob>::iterator blb=src->blobs.begin(); blb!=src->blobs.end(); blb++) {
+			MergeRecord record;
+			record.source = (int)i;
+			record.session_id = blb->session_id;
+			record.symbol_id = 0;
+			record.width = blb->width*src->width;
+			record.height = blb->height*src->height;
+			record.area = blb->area*src->width*src->height;
+			mapRecord(src, blb->x, blb->y, blb->angle, &record);
+			records.push_back(record);
+		}
+	}
+
+	removed.clear();
+	mergeRecords(blobEntries, blobIndex, records, false, removed);
+	for (std::vector<MergeEntry*>::iterator entry=removed.begin(); entry!=removed.end(); entry++) {
+		if ((*entry)->container) manager->removeTuioBlob((TuioBlob*)(*entry)->container);
+		delete *entry;
+	}
+	for (std::list<MergeEntry*>::iterator iter=blobEntries.begin(); iter!=blobEntries.end(); iter++) {
+		MergeEntry *entry = *iter;
+		TuioBlob *tblb = (TuioBlob*)entry->container;
+
+		// the first remaining link provides the state, a blob of a source object or cursor is sent with its merged session ID
+		long linked_id = linkedSessionID(entry->links.front());
+		if ((tblb!=NULL) && (linked_id>=0) && (tblb->getSessionID()!=linked_id)) {
+			manager->removeTuioBlob(tblb);
+			tblb = NULL;
+		}
+
+		if (tblb==NULL) {
+			if (linked_id>=0) entry->container = manager->addTuioBlob(linked_id, entry->x, entry->y, entry->angle, entry->width, entry->height, entry->area);
+			else entry->container = manager->addTuioBlob(entry->x, entry->y, entry->angle, entry->width, entry->height, entry->area);
+		} else if ((tblb->getTuioState()==TUIO_ADDED) || (tblb->getX()!=entry->x) || (tblb->getY()!=entry->y) || (tblb->getAngle()!=entry->angle)
+				|| (tblb->getWidth()!=entry->width) || (tblb->getHeight()!=entry->height))
+			manager->updateTuioBlob(tblb, entry->x, entry->y, entry->angle, entry->width, entry->height, entry->area);
+	}
+
+	manager->stopUntouchedMovingObjects();
+	manager->stopUntouchedMovingCursors();
+	manager->stopUntouchedMovingBlobs();
+	manager->commitFrame();
+}
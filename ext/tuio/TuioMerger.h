@@ -0,0 +1,192 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#ifndef INCLUDED_TUIOMERGER_H
+#define INCLUDED_TUIOMERGER_H
+
+#include "TuioManager.h"
+#include "TuioSnapshot.h"
+#include <vector>
+#include <list>
+#include <map>
+
+#define DEFAULT_MERGE_DISTANCE 0.02f
+
+namespace TUIO {
+
+	/**
+	 * The TuioMerger combines the TuioObjects, TuioCursors and TuioBlobs reported by several sources,
+	 * such as several cameras or several tracker hosts, into a single TuioManager session.
+	 * Each source covers a rectangular region of the common normalized surface, which may be rotated.
+	 * Components of different sources which are closer than the merge distance in an overlap zone,
+	 * and which also share the same symbol ID in case of TuioObjects, are merged into one component.
+	 * A merged component keeps its session ID while it is handed over from one source to another,
+	 * and its state is always taken from the source which reported it first.
+	 * A TuioBlob which shares the Session ID of a TuioObject or TuioCursor of its source
+	 * keeps this association with the Session ID of the merged component.
+	 * All methods need to be called from the same thread.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL TuioMerger {
+
+	public:
+
+		/**
+		 * This constructor creates a TuioMerger without any sources
+		 *
+		 * @param  manager  the TuioManager receiving the merged components
+		 * @param  distance  the merge distance in normalized surface units
+		 */
+		TuioMerger(TuioManager *manager, float distance=DEFAULT_MERGE_DISTANCE);
+
+		/**
+		 * The destructor removes all merged components from the TuioManager
+		 */
+		~TuioMerger();
+
+		/**
+		 * Adds a source covering the provided region of the common surface
+		 *
+		 * @param  x  the left edge of the region before the rotation
+		 * @param  y  the top edge of the region before the rotation
+		 * @param  width  the width of the region
+		 * @param  height  the height of the region
+		 * @param  angle  the rotation of the region around its center in radians
+		 * @return the index of the new source
+		 */
+		int addSource(float x=0.0f, float y=0.0f, float width=1.0f, float height=1.0f, float angle=0.0f);
+
+		/**
+		 * Provides the current components reported by the source,
+		 * which replace its previously provided components until the next update
+		 *
+		 * @param  source  the source index
+		 * @param  objects  the current TuioObject records in source coordinates
+		 * @param  cursors  the current TuioCursor records in source coordinates
+		 * @param  blobs  the current TuioBlob records in source coordinates
+		 */
+		void updateSource(int source, const std::vector<tuio_shm_object> &objects, const std::vector<tuio_shm_cursor> &cursors, const std::vector<tuio_shm_blob> &blobs);
+
+		/**
+		 * Provides the current components of the source from a TuioSnapshot
+		 *
+		 * @param  source  the source index
+		 * @param  snapshot  the latest TuioSnapshot of the source
+		 */
+		void updateSource(int source, const TuioSnapshot *snapshot) {
+			updateSource(source, snapshot->getTuioObjects(), snapshot->getTuioCursors(), snapshot->getTuioBlobs());
+		};
+
+		/**
+		 * Removes all components of the source, for example after the source has been disconnected
+		 *
+		 * @param  source  the source index
+		 */
+		void clearSource(int source);
+
+		/**
+		 * Merges the latest components of all sources into a new frame of the TuioManager and commits it
+		 *
+		 * @param  ftime  the TuioTime of the merged frame
+		 */
+		void commitFrame(TuioTime ftime);
+
+		/**
+		 * Sets the time after which the components of a source which has not been updated are removed
+		 *
+		 * @param  timeout  the source timeout in seconds, zero disables the timeout
+		 */
+		void setSourceTimeout(float timeout) { source_timeout = timeout; };
+
+		/**
+		 * Sets the merge distance
+		 *
+		 * @param  distance  the merge distance in normalized surface units
+		 */
+		void setMergeDistance(float distance) { merge_distance = distance; };
+
+		/**
+		 * Returns the merge distance
+		 *
+		 * @return the merge distance in normalized surface units
+		 */
+		float getMergeDistance() { return merge_distance; };
+
+		/**
+		 * Returns the number of sources
+		 *
+		 * @return the number of sources
+		 */
+		int getSourceCount() { return (int)sourceList.size(); };
+
+	private:
+
+		struct MergeSource {
+			float x, y, width, height, angle;
+			float cos_a, sin_a;
+			std::vector<tuio_shm_object> objects;
+			std::vector<tuio_shm_cursor> cursors;
+			std::vector<tuio_shm_blob> blobs;
+			TuioTime updateTime;
+			bool active;
+		};
+
+		struct MergeRecord {
+			int source;
+			long session_id;
+			int symbol_id;
+			float x, y, angle;
+			float width, height, area;
+		};
+
+		struct MergeLink {
+			int source;
+			long session_id;
+			bool seen;
+		};
+
+		struct MergeEntry {
+			TuioContainer *container;
+			int symbol_id;
+			float x, y, angle;
+			float width, height, area;
+			std::vector<MergeLink> links;
+			unsigned int state_link;
+		};
+
+		typedef std::map<std::pair<int,long>,MergeEntry*> MergeIndex;
+
+		void mapRecord(MergeSource *src, float xp, float yp, float a, MergeRecord *record);
+		void mergeRecords(std::list<MergeEntry*> &entries, MergeIndex &index, std::vector<MergeRecord> &records, bool match_symbol, std::vector<MergeEntry*> &removed);
+		long linkedSessionID(const MergeLink &link);
+
+		TuioManager *manager;
+		std::vector<MergeSource*> sourceList;
+		std::list<MergeEntry*> objectEntries, cursorEntries, blobEntries;
+		MergeIndex objectIndex, cursorIndex, blobIndex;
+		std::vector<MergeRecord> records;
+		std::vector<MergeEntry*> removed;
+		float merge_distance;
+		float source_timeout;
+	};
+}
+
+#endif /* INCLUDED_TUIOMERGER_H */
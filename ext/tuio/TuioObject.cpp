@@ -131,6 +131,10 @@ float TuioObject::getRotationAccel() const{
 	return rotation_accel;
 }
 
+float TuioObject::getPredictedAngle(float dt) const{
+	return predictAngle(angle, rotation_speed, rotation_accel, dt);
+}
+
 bool TuioObject::isMoving() const{ 
 	if ((state==TUIO_ACCELERATING) || (state==TUIO_DECELERATING) || (state==TUIO_ROTATING)) return true;
 	else return false;
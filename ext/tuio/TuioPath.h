@@ -0,0 +1,164 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#ifndef INCLUDED_TUIOPATH_H
+#define INCLUDED_TUIOPATH_H
+
+#include "TuioPoint.h"
+#include <list>
+
+#define MAX_PATH_SIZE 128
+
+namespace TUIO {
+
+	/**
+	 * The TuioPath class keeps the most recent positions of a TuioContainer in a fixed-capacity ring,
+	 * which is stored inline and therefore never allocates memory while the path is updated.
+	 * The positions are returned as TuioPoints in chronological order, starting with the oldest position.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL TuioPath {
+
+	public:
+
+		/**
+		 * The const_iterator traverses the path from the oldest to the most recent position
+		 */
+		class const_iterator {
+		public:
+			const_iterator(const TuioPath *p, unsigned int i):path(p),index(i) {};
+			TuioPoint operator*() const { return (*path)[index]; };
+			const_iterator& operator++() { index++; return *this; };
+			const_iterator operator++(int) { const_iterator it(*this); index++; return it; };
+			bool operator==(const const_iterator &it) const { return (index==it.index) && (path==it.path); };
+			bool operator!=(const const_iterator &it) const { return !(*this==it); };
+		private:
+			const TuioPath *path;
+			unsigned int index;
+		};
+
+		/**
+		 * This constructor creates an empty path with the maximum capacity
+		 */
+		TuioPath():first(0),count(0),capacity(MAX_PATH_SIZE) {};
+
+		/**
+		 * Appends the provided position and drops the oldest position once the capacity is reached
+		 *
+		 * @param	ttime	the TuioTime of the position
+		 * @param	xp	the X coordinate of the position
+		 * @param	yp	the Y coordinate of the position
+		 */
+		void push_back(TuioTime ttime, float xp, float yp) {
+			unsigned int slot = (first+count)%MAX_PATH_SIZE;
+			if (count<capacity) count++;
+			else first = (first+1)%MAX_PATH_SIZE;
+			points[slot].time = ttime;
+			points[slot].x = xp;
+			points[slot].y = yp;
+		};
+
+		/**
+		 * Appends the provided TuioPoint and drops the oldest position once the capacity is reached
+		 *
+		 * @param	p	the TuioPoint to append
+		 */
+		void push_back(const TuioPoint &p) { push_back(p.getTuioTime(),p.getX(),p.getY()); };
+
+		/**
+		 * Returns the position at the provided index, where zero is the oldest position
+		 *
+		 * @param	index	the index of the position
+		 * @return	the position at the provided index
+		 */
+		TuioPoint operator[](unsigned int index) const {
+			const PathPoint &p = points[(first+index)%MAX_PATH_SIZE];
+			return TuioPoint(p.time,p.x,p.y);
+		};
+
+		/**
+		 * Returns the oldest position, the path must not be empty
+		 *
+		 * @return	the oldest position
+		 */
+		TuioPoint front() const { return (*this)[0]; };
+
+		/**
+		 * Returns the most recent position, the path must not be empty
+		 *
+		 * @return	the most recent position
+		 */
+		TuioPoint back() const { return (*this)[count-1]; };
+
+		const_iterator begin() const { return const_iterator(this,0); };
+		const_iterator end() const { return const_iterator(this,count); };
+
+		unsigned int size() const { return count; };
+		bool empty() const { return (count==0); };
+		void clear() { first = 0; count = 0; };
+
+		/**
+		 * Returns the maximum number of positions kept in this path
+		 *
+		 * @return	the maximum number of positions
+		 */
+		unsigned int getCapacity() const { return capacity; };
+
+		/**
+		 * Limits the number of positions kept in this path, dropping the oldest positions if necessary.
+		 * The capacity is limited to the range from one to MAX_PATH_SIZE positions.
+		 *
+		 * @param	size	the maximum number of positions
+		 */
+		void setCapacity(unsigned int size) {
+			if (size<1) size = 1;
+			else if (size>MAX_PATH_SIZE) size = MAX_PATH_SIZE;
+			if (count>size) {
+				first = (first+count-size)%MAX_PATH_SIZE;
+				count = size;
+			}
+			capacity = size;
+		};
+
+		/**
+		 * Returns a copy of this path as a list of TuioPoints
+		 *
+		 * @return	a list of all positions starting with the oldest position
+		 */
+		std::list<TuioPoint> getList() const {
+			std::list<TuioPoint> pointList;
+			for (unsigned int i=0;i<count;i++) pointList.push_back((*this)[i]);
+			return pointList;
+		};
+
+	private:
+		struct PathPoint {
+			TuioTime time;
+			float x, y;
+		};
+
+		PathPoint points[MAX_PATH_SIZE];
+		unsigned int first;
+		unsigned int count;
+		unsigned int capacity;
+	};
+}
+
+#endif /* INCLUDED_TUIOPATH_H */
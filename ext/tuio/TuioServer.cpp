@@ -59,12 +59,28 @@ TuioServer::TuioServer(OscSender *oscsend)
 
 void TuioServer::initialize(OscSender *oscsend) {
 	
+	outputThread = NULL;
+	targetSender = NULL;
 	senderList.push_back(oscsend);
-	int size = oscsend->getBufferSize();
+	deltaList.push_back(new TuioDeltaState());
+	delta_update = false;
+	delta_threshold = 0.001f;
+	keyframe_interval = 1;
+	prediction = false;
+	object_horizon = cursor_horizon = blob_horizon = 0.0f;
+	object_prediction = cursor_prediction = blob_prediction = 0.0f;
+	processing_latency = -1.0f;
+	bundle_size = oscsend->getBufferSize();
+	bundle_start = 0;
+	int size = oscsend->getMaxPacketSize();
 	oscBuffer = new char[size];
 	oscPacket = new osc::OutboundPacketStream(oscBuffer,size);
 	fullBuffer = new char[size];
-	fullPacket = new osc::OutboundPacketStream(oscBuffer,size);
+	fullPacket = new osc::OutboundPacketStream(fullBuffer,size);
+	
+	objectTemplate = new OscMessageTemplate("/tuio/2Dobj","set","iiffffffff");
+	cursorTemplate = new OscMessageTemplate("/tuio/2Dcur","set","ifffff");
+	blobTemplate = new OscMessageTemplate("/tuio/2Dblb","set","ifffffffffff");
 	
 	objectUpdateTime = TuioTime(currentFrameTime);
 	cursorUpdateTime = TuioTime(currentFrameTime);
@@ -95,14 +111,22 @@ TuioServer::~TuioServer() {
 	if (objectProfileEnabled) sendEmptyObjectBundle();
 	if (blobProfileEnabled) sendEmptyBlobBundle();
 	
+	// deliver all pending packets before the senders are deleted
+	disableOutputThread();
+	
 	delete []oscBuffer;
 	delete oscPacket;
 	delete []fullBuffer;
 	delete fullPacket;
+	delete objectTemplate;
+	delete cursorTemplate;
+	delete blobTemplate;
 	
 	if (source_name) delete[] source_name;
 	for (unsigned int i=0;i<senderList.size();i++)
 		delete senderList[i];
+	for (unsigned int i=0;i<deltaList.size();i++)
+		delete deltaList[i];
 }
 
 
@@ -114,22 +138,76 @@ void TuioServer::addOscSender(OscSender *sender) {
 	}*/ 
 	
 	// resize packets to smallest transport method
-	unsigned int size = sender->getBufferSize();
+	if ((unsigned int)sender->getBufferSize()<bundle_size) bundle_size = sender->getBufferSize();
+	unsigned int size = sender->getMaxPacketSize();
 	if (size<oscPacket->Capacity()) {
 		osc::OutboundPacketStream *temp = oscPacket;
 		oscPacket = new osc::OutboundPacketStream(oscBuffer,size);
 		delete temp;
 		temp = fullPacket;
-		fullPacket = new osc::OutboundPacketStream(oscBuffer,size);
+		fullPacket = new osc::OutboundPacketStream(fullBuffer,size);
 		delete temp;
 		
 	}
 	
 	senderList.push_back(sender);
+	deltaList.push_back(new TuioDeltaState());
+	if (outputThread) outputThread->addOscSender(sender);
+}
+
+void TuioServer::enableOutputThread(unsigned int queue_size) {
+
+	disableOutputThread();
+	try {
+		outputThread = new OscOutputThread(queue_size);
+	} catch (std::exception e) {
+		outputThread = NULL;
+		return;
+	}
+
+	for (unsigned int i=0;i<senderList.size();i++)
+		outputThread->addOscSender(senderList[i]);
+}
+
+void TuioServer::disableOutputThread() {
+
+	if (outputThread==NULL) return;
+	delete outputThread;
+	outputThread = NULL;
+}
+
+unsigned long TuioServer::getDroppedPackets(OscSender *sender) {
+	if (outputThread) return outputThread->getDroppedPackets(sender);
+	return 0;
+}
+
+unsigned long TuioServer::getDroppedPackets() {
+	if (outputThread) return outputThread->getDroppedPackets();
+	return 0;
+}
+
+bool TuioServer::bundleFull(osc::OutboundPacketStream *packet, unsigned int message_size) {
+
+	// the next message needs to fit into the packet in any case
+	if ((packet->Capacity()-packet->Size())<message_size) return true;
+	// each bundle needs to carry the complete alive list of the frame, so a frame with
+	// a larger alive list is delivered in bundles that exceed the regular bundle size
+	if ((bundle_start+message_size)>bundle_size) return false;
+	return ((packet->Size()+message_size)>bundle_size);
 }
 
 void TuioServer::deliverOscPacket(osc::OutboundPacketStream  *packet) {
 
+	if (outputThread) {
+		outputThread->queueOscPacket(packet,targetSender);
+		return;
+	}
+
+	if (targetSender) {
+		targetSender->sendOscPacket(packet);
+		return;
+	}
+
 	for (unsigned int i=0;i<senderList.size();i++)
 		senderList[i]->sendOscPacket(packet);
 }
@@ -181,13 +259,19 @@ void TuioServer::setSourceName(const char *src) {
 
 void TuioServer::commitFrame() {
 	TuioManager::commitFrame();
+	if (prediction) updatePrediction();
+	
+	if (delta_update) {
+		commitDeltaFrame();
+		return;
+	}
 		
 	if(updateObject) {
 		startObjectBundle();
 		for (std::list<TuioObject*>::iterator  tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++) {
 			
 			// start a new packet if we exceed the packet capacity
-			if ((oscPacket->Capacity()-oscPacket->Size())<OBJ_MESSAGE_SIZE) {
+			if (bundleFull(oscPacket,OBJ_MESSAGE_SIZE)) {
 				sendObjectBundle(currentFrame);
 				startObjectBundle();
 			}
@@ -205,7 +289,7 @@ void TuioServer::commitFrame() {
 			if  (full_update) {
 				for (std::list<TuioObject*>::iterator  tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++) {
 					// start a new packet if we exceed the packet capacity
-					if ((oscPacket->Capacity()-oscPacket->Size())<OBJ_MESSAGE_SIZE) {
+					if (bundleFull(oscPacket,OBJ_MESSAGE_SIZE)) {
 						sendObjectBundle(currentFrame);
 						startObjectBundle();
 					}
@@ -222,7 +306,7 @@ void TuioServer::commitFrame() {
 		for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
 			
 			// start a new packet if we exceed the packet capacity
-			if ((oscPacket->Capacity()-oscPacket->Size())<CUR_MESSAGE_SIZE) {
+			if (bundleFull(oscPacket,CUR_MESSAGE_SIZE)) {
 				sendCursorBundle(currentFrame);
 				startCursorBundle();
 			}
@@ -239,7 +323,7 @@ void TuioServer::commitFrame() {
 			if (full_update) {
 				for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
 					// start a new packet if we exceed the packet capacity
-					if ((oscPacket->Capacity()-oscPacket->Size())<CUR_MESSAGE_SIZE) {
+					if (bundleFull(oscPacket,CUR_MESSAGE_SIZE)) {
 						sendCursorBundle(currentFrame);
 						startCursorBundle();
 					}
@@ -255,7 +339,7 @@ void TuioServer::commitFrame() {
 		startBlobBundle();
 		for (std::list<TuioBlob*>::iterator tuioBlob =blobList.begin(); tuioBlob!=blobList.end(); tuioBlob++) {
 			// start a new packet if we exceed the packet capacity
-			if ((oscPacket->Capacity()-oscPacket->Size())<BLB_MESSAGE_SIZE) {
+			if (bundleFull(oscPacket,BLB_MESSAGE_SIZE)) {
 				sendBlobBundle(currentFrame);
 				startBlobBundle();
 			}
@@ -273,7 +357,7 @@ void TuioServer::commitFrame() {
 				for (std::list<TuioBlob*>::iterator tuioBlob =blobList.begin(); tuioBlob!=blobList.end(); tuioBlob++) {
 				
 					// start a new packet if we exceed the packet capacity
-					if ((oscPacket->Capacity()-oscPacket->Size())<BLB_MESSAGE_SIZE) {
+					if (bundleFull(oscPacket,BLB_MESSAGE_SIZE)) {
 						sendBlobBundle(currentFrame);
 						startBlobBundle();
 					}
@@ -286,6 +370,176 @@ void TuioServer::commitFrame() {
 	updateBlob = false;
 }
 
+void TuioServer::enableDeltaUpdates(float threshold, int interval) {
+	delta_threshold = threshold;
+	keyframe_interval = interval;
+	for (unsigned int i=0;i<deltaList.size();i++)
+		deltaList[i]->keyframe = true;
+	delta_update = true;
+}
+
+void TuioServer::disableDeltaUpdates() {
+	delta_update = false;
+}
+
+void TuioServer::enablePrediction(float object_h, float cursor_h, float blob_h) {
+	object_horizon = object_h;
+	cursor_horizon = cursor_h;
+	blob_horizon = blob_h;
+	processing_latency = -1.0f;
+	prediction = true;
+}
+
+void TuioServer::disablePrediction() {
+	prediction = false;
+	object_prediction = cursor_prediction = blob_prediction = 0.0f;
+}
+
+void TuioServer::updatePrediction() {
+
+	TuioTime diffTime = TuioTime::getSystemTime() - frameStartTime;
+	float latency = diffTime.getSeconds() + diffTime.getMicroseconds()/1000000.0f;
+	if (latency<0) latency = 0;
+
+	// the latency is smoothed, so the extrapolation does not follow the jitter of individual frames
+	if (processing_latency<0) processing_latency = latency;
+	else processing_latency = 0.9f*processing_latency + 0.1f*latency;
+
+	object_prediction = (object_horizon<0) ? 0.0f : processing_latency + object_horizon;
+	cursor_prediction = (cursor_horizon<0) ? 0.0f : processing_latency + cursor_horizon;
+	blob_prediction = (blob_horizon<0) ? 0.0f : processing_latency + blob_horizon;
+}
+
+bool TuioServer::updateDeltaEntry(std::map<long,TuioDeltaEntry> &entries, long s_id, float xpos, float ypos, float angle, float width, float height) {
+
+	std::map<long,TuioDeltaEntry>::iterator entry = entries.find(s_id);
+	if (entry==entries.end()) {
+		TuioDeltaEntry new_entry = { xpos, ypos, angle, width, height, currentFrame };
+		entries[s_id] = new_entry;
+		return true;
+	}
+
+	TuioDeltaEntry *last = &(entry->second);
+	last->frame = currentFrame;
+
+	float da = fabs(angle - last->angle);
+	if (da>M_PI) da = 2.0f*(float)M_PI - da;
+	if ((fabs(xpos - last->xpos)<delta_threshold) && (fabs(ypos - last->ypos)<delta_threshold) &&
+		(fabs(width - last->width)<delta_threshold) && (fabs(height - last->height)<delta_threshold) &&
+		(da<delta_threshold*2.0f*(float)M_PI)) return false;
+
+	last->xpos = xpos;
+	last->ypos = ypos;
+	last->angle = angle;
+	last->width = width;
+	last->height = height;
+	return true;
+}
+
+bool TuioServer::removeDeltaEntries(std::map<long,TuioDeltaEntry> &entries) {
+
+	// entries which have not been seen in the current frame are not alive anymore
+	bool removed = false;
+	for (std::map<long,TuioDeltaEntry>::iterator entry = entries.begin(); entry!=entries.end();) {
+		if (entry->second.frame!=currentFrame) {
+			entries.erase(entry++);
+			removed = true;
+		} else entry++;
+	}
+	return removed;
+}
+
+void TuioServer::commitDeltaFrame() {
+
+	for (unsigned int i=0;i<senderList.size();i++) {
+		TuioDeltaState *state = deltaList[i];
+		targetSender = senderList[i];
+
+		if (targetSender->hasNewClient()) state->keyframe = true;
+		if (keyframe_interval>0) {
+			TuioTime timeCheck = currentFrameTime - state->keyframeTime;
+			if (timeCheck.getSeconds()>=keyframe_interval) state->keyframe = true;
+		}
+
+		// a keyframe delivers all set messages again
+		bool keyframe = state->keyframe;
+		if (keyframe) {
+			state->objectEntries.clear();
+			state->cursorEntries.clear();
+			state->blobEntries.clear();
+			state->keyframeTime = TuioTime(currentFrameTime);
+			state->keyframe = false;
+		}
+
+		if (objectProfileEnabled && (updateObject || keyframe)) {
+			bool changed = false;
+			startObjectBundle();
+			for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++) {
+				
+				// start a new packet if we exceed the packet capacity
+				if (bundleFull(oscPacket,OBJ_MESSAGE_SIZE)) {
+					sendObjectBundle(currentFrame);
+					startObjectBundle();
+				}
+				TuioObject *tobj = (*tuioObject);
+				if (updateDeltaEntry(state->objectEntries, tobj->getSessionID(), tobj->getX(), tobj->getY(), tobj->getAngle(), 0.0f, 0.0f)) {
+					addObjectMessage(tobj);
+					changed = true;
+				}
+			}
+			if (removeDeltaEntries(state->objectEntries)) changed = true;
+			if (changed || keyframe) sendObjectBundle(currentFrame);
+		}
+
+		if (cursorProfileEnabled && (updateCursor || keyframe)) {
+			bool changed = false;
+			startCursorBundle();
+			for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
+				
+				// start a new packet if we exceed the packet capacity
+				if (bundleFull(oscPacket,CUR_MESSAGE_SIZE)) {
+					sendCursorBundle(currentFrame);
+					startCursorBundle();
+				}
+				TuioCursor *tcur = (*tuioCursor);
+				if (tcur->getTuioState()==TUIO_ADDED) continue;
+				if (updateDeltaEntry(state->cursorEntries, tcur->getSessionID(), tcur->getX(), tcur->getY(), 0.0f, 0.0f, 0.0f)) {
+					addCursorMessage(tcur);
+					changed = true;
+				}
+			}
+			if (removeDeltaEntries(state->cursorEntries)) changed = true;
+			if (changed || keyframe) sendCursorBundle(currentFrame);
+		}
+
+		if (blobProfileEnabled && (updateBlob || keyframe)) {
+			bool changed = false;
+			startBlobBundle();
+			for (std::list<TuioBlob*>::iterator tuioBlob = blobList.begin(); tuioBlob!=blobList.end(); tuioBlob++) {
+				
+				// start a new packet if we exceed the packet capacity
+				if (bundleFull(oscPacket,BLB_MESSAGE_SIZE)) {
+					sendBlobBundle(currentFrame);
+					startBlobBundle();
+				}
+				TuioBlob *tblb = (*tuioBlob);
+				if (tblb->getTuioState()==TUIO_ADDED) continue;
+				if (updateDeltaEntry(state->blobEntries, tblb->getSessionID(), tblb->getX(), tblb->getY(), tblb->getAngle(), tblb->getWidth(), tblb->getHeight())) {
+					addBlobMessage(tblb);
+					changed = true;
+				}
+			}
+			if (removeDeltaEntries(state->blobEntries)) changed = true;
+			if (changed || keyframe) sendBlobBundle(currentFrame);
+		}
+	}
+
+	targetSender = NULL;
+	updateObject = false;
+	updateCursor = false;
+	updateBlob = false;
+}
+
 void TuioServer::sendEmptyCursorBundle() {
 	oscPacket->Clear();	
 	(*oscPacket) << osc::BeginBundleImmediate;
@@ -304,7 +558,8 @@ void TuioServer::startCursorBundle() {
 	for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
 		if ((*tuioCursor)->getTuioState()!=TUIO_ADDED) (*oscPacket) << (int32)((*tuioCursor)->getSessionID());
 	}
-	(*oscPacket) << osc::EndMessage;	
+	(*oscPacket) << osc::EndMessage;
+	bundle_start = (unsigned int)oscPacket->Size();
 }
 
 void TuioServer::addCursorMessage(TuioCursor *tcur) {
@@ -312,22 +567,31 @@ void TuioServer::addCursorMessage(TuioCursor *tcur) {
 	if (tcur->getTuioState()==TUIO_ADDED) return;
 
 	float xpos = tcur->getX();
+	float ypos = tcur->getY();
+	if (cursor_prediction>0) {
+		TuioPoint ppos = tcur->getPredictedPosition(cursor_prediction);
+		xpos = ppos.getX();
+		ypos = ppos.getY();
+	}
+
 	float xvel = tcur->getXSpeed();
 	if (invert_x) {
 		xpos = 1 - xpos;
 		xvel = -1 * xvel;
 	}
-	float ypos = tcur->getY();
 	float yvel = tcur->getYSpeed();
 	if (invert_y) {
 		ypos = 1 - ypos;
 		yvel = -1 * yvel;
 	}
 
-	(*oscPacket) << osc::BeginMessage( "/tuio/2Dcur") << "set";
-	(*oscPacket) << (int32)(tcur->getSessionID()) << xpos << ypos;
-	(*oscPacket) << xvel << yvel << tcur->getMotionAccel();	
-	(*oscPacket) << osc::EndMessage;
+	cursorTemplate->setInt32(0, (int32)(tcur->getSessionID()));
+	cursorTemplate->setFloat(1, xpos);
+	cursorTemplate->setFloat(2, ypos);
+	cursorTemplate->setFloat(3, xvel);
+	cursorTemplate->setFloat(4, yvel);
+	cursorTemplate->setFloat(5, tcur->getMotionAccel());
+	cursorTemplate->appendTo(oscPacket);
 }
 
 void TuioServer::sendCursorBundle(long fseq) {
@@ -355,33 +619,48 @@ void TuioServer::startObjectBundle() {
 		(*oscPacket) << (int32)((*tuioObject)->getSessionID());	
 	}
 	(*oscPacket) << osc::EndMessage;
+	bundle_start = (unsigned int)oscPacket->Size();
 }
 
 void TuioServer::addObjectMessage(TuioObject *tobj) {
 	
 	float xpos = tobj->getX();
+	float ypos = tobj->getY();
+	float angle = tobj->getAngle();
+	if (object_prediction>0) {
+		TuioPoint ppos = tobj->getPredictedPosition(object_prediction);
+		xpos = ppos.getX();
+		ypos = ppos.getY();
+		angle = tobj->getPredictedAngle(object_prediction);
+	}
+
 	float xvel = tobj->getXSpeed();
 	if (invert_x) {
 		xpos = 1 - xpos;
 		xvel = -1 * xvel;
 	}
-	float ypos = tobj->getY();
 	float yvel = tobj->getYSpeed();
 	if (invert_y) {
 		ypos = 1 - ypos;
 		yvel = -1 * yvel;
 	}
-	float angle = tobj->getAngle();
 	float rvel = tobj->getRotationSpeed();
 	if (invert_a) {
 		angle = 2.0f*(float)M_PI - angle;
 		rvel = -1 * rvel;
 	}
 	
-	(*oscPacket) << osc::BeginMessage( "/tuio/2Dobj") << "set";
-	(*oscPacket) << (int32)(tobj->getSessionID()) << tobj->getSymbolID() << xpos << ypos << angle;
-	(*oscPacket) << xvel << yvel << rvel << tobj->getMotionAccel() << tobj->getRotationAccel();	
-	(*oscPacket) << osc::EndMessage;
+	objectTemplate->setInt32(0, (int32)(tobj->getSessionID()));
+	objectTemplate->setInt32(1, tobj->getSymbolID());
+	objectTemplate->setFloat(2, xpos);
+	objectTemplate->setFloat(3, ypos);
+	objectTemplate->setFloat(4, angle);
+	objectTemplate->setFloat(5, xvel);
+	objectTemplate->setFloat(6, yvel);
+	objectTemplate->setFloat(7, rvel);
+	objectTemplate->setFloat(8, tobj->getMotionAccel());
+	objectTemplate->setFloat(9, tobj->getRotationAccel());
+	objectTemplate->appendTo(oscPacket);
 }
 
 void TuioServer::sendObjectBundle(long fseq) {
@@ -409,7 +688,8 @@ void TuioServer::startBlobBundle() {
 	for (std::list<TuioBlob*>::iterator tuioBlob = blobList.begin(); tuioBlob!=blobList.end(); tuioBlob++) {
 		if ((*tuioBlob)->getTuioState()!=TUIO_ADDED) (*oscPacket) << (int32)((*tuioBlob)->getSessionID());
 	}
-	(*oscPacket) << osc::EndMessage;	
+	(*oscPacket) << osc::EndMessage;
+	bundle_start = (unsigned int)oscPacket->Size();
 }
 
 void TuioServer::addBlobMessage(TuioBlob *tblb) {
@@ -417,28 +697,44 @@ void TuioServer::addBlobMessage(TuioBlob *tblb) {
 	if (tblb->getTuioState()==TUIO_ADDED) return;
 	
 	float xpos = tblb->getX();
+	float ypos = tblb->getY();
+	float angle = tblb->getAngle();
+	if (blob_prediction>0) {
+		TuioPoint ppos = tblb->getPredictedPosition(blob_prediction);
+		xpos = ppos.getX();
+		ypos = ppos.getY();
+		angle = tblb->getPredictedAngle(blob_prediction);
+	}
+
 	float xvel = tblb->getXSpeed();
 	if (invert_x) {
 		xpos = 1 - xpos;
 		xvel = -1 * xvel;
 	}
-	float ypos = tblb->getY();
 	float yvel = tblb->getYSpeed();
 	if (invert_y) {
 		ypos = 1 - ypos;
 		yvel = -1 * yvel;
 	}
-	float angle = tblb->getAngle();
 	float rvel = tblb->getRotationSpeed();
 	if (invert_a) {
 		angle = 2.0f*(float)M_PI - angle;
 		rvel = -1 * rvel;
 	}
 	
-	(*oscPacket) << osc::BeginMessage( "/tuio/2Dblb") << "set";
-	(*oscPacket) << (int32)(tblb->getSessionID()) << xpos << ypos << angle << tblb->getWidth() << tblb->getHeight() << tblb->getArea();
-	(*oscPacket) << xvel << yvel  << rvel << tblb->getMotionAccel()  << tblb->getRotationAccel();	
-	(*oscPacket) << osc::EndMessage;
+	blobTemplate->setInt32(0, (int32)(tblb->getSessionID()));
+	blobTemplate->setFloat(1, xpos);
+	blobTemplate->setFloat(2, ypos);
+	blobTemplate->setFloat(3, angle);
+	blobTemplate->setFloat(4, tblb->getWidth());
+	blobTemplate->setFloat(5, tblb->getHeight());
+	blobTemplate->setFloat(6, tblb->getArea());
+	blobTemplate->setFloat(7, xvel);
+	blobTemplate->setFloat(8, yvel);
+	blobTemplate->setFloat(9, rvel);
+	blobTemplate->setFloat(10, tblb->getMotionAccel());
+	blobTemplate->setFloat(11, tblb->getRotationAccel());
+	blobTemplate->appendTo(oscPacket);
 }
 
 void TuioServer::sendBlobBundle(long fseq) {
@@ -459,12 +755,13 @@ void TuioServer::sendFullMessages() {
 	for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++)
 		(*fullPacket) << (int32)((*tuioCursor)->getSessionID());	
 	(*fullPacket) << osc::EndMessage;	
+	bundle_start = (unsigned int)fullPacket->Size();
 	
 	// add all current cursor set messages
 	for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++) {
 		
 		// start a new packet if we exceed the packet capacity
-		if ((fullPacket->Capacity()-fullPacket->Size())<CUR_MESSAGE_SIZE) {
+		if (bundleFull(fullPacket,CUR_MESSAGE_SIZE)) {
 			
 			// add the immediate fseq message and send the cursor packet
 			(*fullPacket) << osc::BeginMessage( "/tuio/2Dcur") << "fseq" << -1 << osc::EndMessage;
@@ -480,6 +777,7 @@ void TuioServer::sendFullMessages() {
 			for (std::list<TuioCursor*>::iterator tuioCursor = cursorList.begin(); tuioCursor!=cursorList.end(); tuioCursor++)
 				(*fullPacket) << (int32)((*tuioCursor)->getSessionID());	
 			(*fullPacket) << osc::EndMessage;				
+			bundle_start = (unsigned int)fullPacket->Size();
 		}
 		
 		float xpos = (*tuioCursor)->getX();
@@ -496,10 +794,13 @@ void TuioServer::sendFullMessages() {
 		}
 		
 		// add the actual cursor set message
-		(*fullPacket) << osc::BeginMessage( "/tuio/2Dcur") << "set";
-		(*fullPacket) << (int32)((*tuioCursor)->getSessionID()) << xpos << ypos;
-		(*fullPacket) << xvel << yvel <<(*tuioCursor)->getMotionAccel();	
-		(*fullPacket) << osc::EndMessage;	
+		cursorTemplate->setInt32(0, (int32)((*tuioCursor)->getSessionID()));
+		cursorTemplate->setFloat(1, xpos);
+		cursorTemplate->setFloat(2, ypos);
+		cursorTemplate->setFloat(3, xvel);
+		cursorTemplate->setFloat(4, yvel);
+		cursorTemplate->setFloat(5, (*tuioCursor)->getMotionAccel());
+		cursorTemplate->appendTo(fullPacket);
 	}
 	
 	// add the immediate fseq message and send the cursor packet
@@ -516,11 +817,12 @@ void TuioServer::sendFullMessages() {
 	for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++)
 		(*fullPacket) << (int32)((*tuioObject)->getSessionID());	
 	(*fullPacket) << osc::EndMessage;	
+	bundle_start = (unsigned int)fullPacket->Size();
 	
 	for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++) {
 		
 		// start a new packet if we exceed the packet capacity
-		if ((fullPacket->Capacity()-fullPacket->Size())<OBJ_MESSAGE_SIZE) {
+		if (bundleFull(fullPacket,OBJ_MESSAGE_SIZE)) {
 			// add the immediate fseq message and send the object packet
 			(*fullPacket) << osc::BeginMessage( "/tuio/2Dobj") << "fseq" << -1 << osc::EndMessage;
 			(*fullPacket) << osc::EndBundle;
@@ -535,6 +837,7 @@ void TuioServer::sendFullMessages() {
 			for (std::list<TuioObject*>::iterator tuioObject = objectList.begin(); tuioObject!=objectList.end(); tuioObject++)
 				(*fullPacket) << (int32)((*tuioObject)->getSessionID());	
 			(*fullPacket) << osc::EndMessage;	
+			bundle_start = (unsigned int)fullPacket->Size();
 		}
 		
 		float xpos = (*tuioObject)->getX();
@@ -557,10 +860,17 @@ void TuioServer::sendFullMessages() {
 		}
 		
 		// add the actual object set message
-		(*fullPacket) << osc::BeginMessage( "/tuio/2Dobj") << "set";
-		(*fullPacket) << (int32)((*tuioObject)->getSessionID()) << (*tuioObject)->getSymbolID() << xpos << ypos << angle;
-		(*fullPacket) << xvel << yvel << rvel << (*tuioObject)->getMotionAccel() << (*tuioObject)->getRotationAccel();	
-		(*fullPacket) << osc::EndMessage;
+		objectTemplate->setInt32(0, (int32)((*tuioObject)->getSessionID()));
+		objectTemplate->setInt32(1, (*tuioObject)->getSymbolID());
+		objectTemplate->setFloat(2, xpos);
+		objectTemplate->setFloat(3, ypos);
+		objectTemplate->setFloat(4, angle);
+		objectTemplate->setFloat(5, xvel);
+		objectTemplate->setFloat(6, yvel);
+		objectTemplate->setFloat(7, rvel);
+		objectTemplate->setFloat(8, (*tuioObject)->getMotionAccel());
+		objectTemplate->setFloat(9, (*tuioObject)->getRotationAccel());
+		objectTemplate->appendTo(fullPacket);
 		
 	}
 	// add the immediate fseq message and send the object packet
@@ -577,11 +887,12 @@ void TuioServer::sendFullMessages() {
 	for (std::list<TuioBlob*>::iterator tuioBlob = blobList.begin(); tuioBlob!=blobList.end(); tuioBlob++)
 		(*fullPacket) << (int32)((*tuioBlob)->getSessionID());	
 	(*fullPacket) << osc::EndMessage;	
+	bundle_start = (unsigned int)fullPacket->Size();
 	
 	for (std::list<TuioBlob*>::iterator tuioBlob = blobList.begin(); tuioBlob!=blobList.end(); tuioBlob++) {
 		
 		// start a new packet if we exceed the packet capacity
-		if ((fullPacket->Capacity()-fullPacket->Size())<BLB_MESSAGE_SIZE) {
+		if (bundleFull(fullPacket,BLB_MESSAGE_SIZE)) {
 			// add the immediate fseq message and send the object packet
 			(*fullPacket) << osc::BeginMessage( "/tuio/2Dblb") << "fseq" << -1 << osc::EndMessage;
 			(*fullPacket) << osc::EndBundle;
@@ -596,6 +907,7 @@ void TuioServer::sendFullMessages() {
 			for (std::list<TuioBlob*>::iterator tuioBlob = blobList.begin(); tuioBlob!=blobList.end(); tuioBlob++)
 				(*fullPacket) << (int32)((*tuioBlob)->getSessionID());	
 			(*fullPacket) << osc::EndMessage;	
+			bundle_start = (unsigned int)fullPacket->Size();
 		}
 		
 		float xpos = (*tuioBlob)->getX();
@@ -618,10 +930,19 @@ void TuioServer::sendFullMessages() {
 		}		
 		
 		// add the actual blob set message
-		(*fullPacket) << osc::BeginMessage( "/tuio/2Dblb") << "set";
-		(*fullPacket) << (int32)((*tuioBlob)->getSessionID()) << xpos << ypos  << angle << (*tuioBlob)->getWidth() << (*tuioBlob)->getHeight() << (*tuioBlob)->getArea();
-		(*fullPacket) << xvel << yvel << rvel << (*tuioBlob)->getMotionAccel() << (*tuioBlob)->getRotationAccel();	
-		(*fullPacket) << osc::EndMessage;
+		blobTemplate->setInt32(0, (int32)((*tuioBlob)->getSessionID()));
+		blobTemplate->setFloat(1, xpos);
+		blobTemplate->setFloat(2, ypos);
+		blobTemplate->setFloat(3, angle);
+		blobTemplate->setFloat(4, (*tuioBlob)->getWidth());
+		blobTemplate->setFloat(5, (*tuioBlob)->getHeight());
+		blobTemplate->setFloat(6, (*tuioBlob)->getArea());
+		blobTemplate->setFloat(7, xvel);
+		blobTemplate->setFloat(8, yvel);
+		blobTemplate->setFloat(9, rvel);
+		blobTemplate->setFloat(10, (*tuioBlob)->getMotionAccel());
+		blobTemplate->setFloat(11, (*tuioBlob)->getRotationAccel());
+		blobTemplate->appendTo(fullPacket);
 		
 	}
 	// add the immediate fseq message and send the blob packet
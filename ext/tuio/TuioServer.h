@@ -21,11 +21,15 @@
 
 #include "TuioManager.h"
 #include "UdpSender.h"
+#include "UdpFanoutSender.h"
 #include "TcpSender.h"
 #include "WebSockSender.h"
 #include "FlashSender.h"
+#include "OscOutputThread.h"
+#include "OscMessageTemplate.h"
 #include <iostream>
 #include <vector>
+#include <map>
 #include <stdio.h>
 #ifndef WIN32
 #include <netdb.h>
@@ -164,6 +168,64 @@ namespace TUIO {
 		 */
 		void commitFrame();
 
+		/**
+		 * Enables the delta encoding, which tracks the last delivered state for each OscSender.
+		 * Each OscSender only receives the set messages of the TuioObjects, TuioCursors and TuioBlobs
+		 * which moved beyond the provided threshold since they were last delivered to this OscSender.
+		 * A keyframe with all set messages is delivered periodically and whenever a new client connects.
+		 *
+		 * @param	threshold	the position and size threshold in normalized units, angles use the same fraction of a full turn
+		 * @param	interval	the keyframe interval in seconds, zero disables periodic keyframes
+		 */
+		void enableDeltaUpdates(float threshold=0.001f, int interval=1);
+
+		/**
+		 * Disables the delta encoding
+		 */
+		void disableDeltaUpdates();
+
+		/**
+		 * Returns true if the delta encoding is enabled.
+		 * @return	true if the delta encoding is enabled
+		 */
+		bool deltaUpdatesEnabled() {
+			return delta_update;
+		}
+
+		/**
+		 * Enables the latency compensation, which extrapolates the delivered positions and angles
+		 * of the TuioObjects, TuioCursors and TuioBlobs by their current speed and acceleration.
+		 * Each profile is extrapolated by the measured processing latency of the current frame
+		 * plus its additional horizon, which accounts for the camera and delivery latency.
+		 *
+		 * @param	object_horizon	the additional TuioObject horizon in seconds, a negative horizon disables the extrapolation
+		 * @param	cursor_horizon	the additional TuioCursor horizon in seconds, a negative horizon disables the extrapolation
+		 * @param	blob_horizon	the additional TuioBlob horizon in seconds, a negative horizon disables the extrapolation
+		 */
+		void enablePrediction(float object_horizon=0.0f, float cursor_horizon=0.0f, float blob_horizon=0.0f);
+
+		/**
+		 * Disables the latency compensation
+		 */
+		void disablePrediction();
+
+		/**
+		 * Returns true if the latency compensation is enabled.
+		 * @return	true if the latency compensation is enabled
+		 */
+		bool predictionEnabled() {
+			return prediction;
+		}
+
+		/**
+		 * Returns the smoothed processing latency from the start of the frame processing provided to initFrame until commitFrame in seconds,
+		 * which is only measured while the latency compensation is enabled.
+		 * @return	the smoothed processing latency in seconds
+		 */
+		float getProcessingLatency() {
+			return (processing_latency<0) ? 0.0f : processing_latency;
+		}
+
 		/**
 		 * Commits the current frame.
 		 * Generates and sends TUIO messages of all currently active and updated TuioObjects, TuioCursors and TuioBlobs.
@@ -186,6 +248,40 @@ namespace TUIO {
 
 		void addOscSender(OscSender *sender);
 
+		/**
+		 * Enables the delivery of the OSC packets from a dedicated output thread,
+		 * which decouples the frame rate from slow or stalled network connections.
+		 *
+		 * @param	queue_size	the maximum number of pending packets per OscSender
+		 */
+		void enableOutputThread(unsigned int queue_size=DEFAULT_OSC_QUEUE_SIZE);
+
+		/**
+		 * Delivers all pending OSC packets and returns to the synchronous delivery from the calling thread
+		 */
+		void disableOutputThread();
+
+		/**
+		 * Returns true if the OSC packets are delivered from a dedicated output thread
+		 * @return	true if the OSC packets are delivered from a dedicated output thread
+		 */
+		bool outputThreadEnabled() { return (outputThread!=NULL); };
+
+		/**
+		 * Returns the number of OSC packets which have been dropped by the output thread
+		 * because the queue of the provided OscSender was full
+		 *
+		 * @param	sender	the OscSender to query
+		 * @return	the number of OSC packets dropped for the provided OscSender
+		 */
+		unsigned long getDroppedPackets(OscSender *sender);
+
+		/**
+		 * Returns the number of OSC packets which have been dropped by the output thread for all OscSenders
+		 * @return	the number of OSC packets dropped for all OscSenders
+		 */
+		unsigned long getDroppedPackets();
+
 		void enableObjectProfile(bool flag) { objectProfileEnabled = flag; };
 		void enableCursorProfile(bool flag) { cursorProfileEnabled = flag; };
 		void enableBlobProfile(bool flag) { blobProfileEnabled = flag; };
@@ -199,12 +295,48 @@ namespace TUIO {
 		void initialize(OscSender *oscsend);
 
 		std::vector<OscSender*> senderList;
+		OscOutputThread *outputThread;
+		OscSender *targetSender;
 		void deliverOscPacket(osc::OutboundPacketStream  *packet);
 
+		struct TuioDeltaEntry {
+			float xpos, ypos, angle, width, height;
+			long frame;
+		};
+
+		struct TuioDeltaState {
+			std::map<long,TuioDeltaEntry> objectEntries;
+			std::map<long,TuioDeltaEntry> cursorEntries;
+			std::map<long,TuioDeltaEntry> blobEntries;
+			TuioTime keyframeTime;
+			bool keyframe;
+		};
+
+		std::vector<TuioDeltaState*> deltaList;
+		bool delta_update;
+		float delta_threshold;
+		int keyframe_interval;
+
+		bool prediction;
+		float object_horizon, cursor_horizon, blob_horizon;
+		float object_prediction, cursor_prediction, blob_prediction;
+		float processing_latency;
+		void updatePrediction();
+
+		void commitDeltaFrame();
+		bool updateDeltaEntry(std::map<long,TuioDeltaEntry> &entries, long s_id, float xpos, float ypos, float angle, float width, float height);
+		bool removeDeltaEntries(std::map<long,TuioDeltaEntry> &entries);
+
 		osc::OutboundPacketStream  *oscPacket;
 		char *oscBuffer;
 		osc::OutboundPacketStream  *fullPacket;
 		char *fullBuffer;
+		unsigned int bundle_size;
+		unsigned int bundle_start;
+		OscMessageTemplate *objectTemplate;
+		OscMessageTemplate *cursorTemplate;
+		OscMessageTemplate *blobTemplate;
+		bool bundleFull(osc::OutboundPacketStream *packet, unsigned int message_size);
 
 		void startObjectBundle();
 		void addObjectMessage(TuioObject *tobj);
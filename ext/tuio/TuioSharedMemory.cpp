@@ -0,0 +1,148 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#include "TuioSharedMemory.h"
+#include <cstring>
+#include <cstddef>
+#include <cstdio>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace TUIO;
+
+TuioSharedMemory::TuioSharedMemory(TuioManager *tm, const char *name)
+	:manager	(tm)
+	,region		(NULL)
+	,frame_id	(0)
+	,overflow	(false)
+{
+	snprintf(shm_name,sizeof(shm_name),"%s%s",(name[0]=='/')?"":"/",name);
+
+#ifdef WIN32
+	mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, sizeof(tuio_shm_region), shm_name+1);
+	if (mapping!=NULL) region = (tuio_shm_region*)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(tuio_shm_region));
+	if (region==NULL) {
+		if (mapping!=NULL) CloseHandle(mapping);
+		std::cerr << "could not create shared memory " << shm_name << std::endl;
+		throw std::exception();
+	}
+#else
+	int fd = shm_open(shm_name, O_CREAT | O_RDWR, 0644);
+	if ((fd<0) || (ftruncate(fd, sizeof(tuio_shm_region))<0)) {
+		if (fd>=0) close(fd);
+		std::cerr << "could not create shared memory " << shm_name << std::endl;
+		throw std::exception();
+	}
+
+	void *data = mmap(NULL, sizeof(tuio_shm_region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (data==MAP_FAILED) {
+		shm_unlink(shm_name);
+		std::cerr << "could not map shared memory " << shm_name << std::endl;
+		throw std::exception();
+	}
+	region = (tuio_shm_region*)data;
+#endif
+
+	// readers check the magic number last, so it is published after the rest of the header
+	memset(region, 0, offsetof(tuio_shm_region, slots));
+	for (int i=0;i<TUIO_SHM_SLOTS;i++) region->slots[i].sequence = 0;
+	region->version = TUIO_SHM_VERSION;
+	region->region_size = sizeof(tuio_shm_region);
+	region->slot_count = TUIO_SHM_SLOTS;
+	tuio_shm_store_release(&region->magic, TUIO_SHM_MAGIC);
+
+	manager->addTuioListener(this);
+	std::cout << "TUIO shared memory " << shm_name << std::endl;
+}
+
+TuioSharedMemory::~TuioSharedMemory() {
+
+	manager->removeTuioListener(this);
+	tuio_shm_store_release(&region->closed, 1);
+
+#ifdef WIN32
+	UnmapViewOfFile(region);
+	CloseHandle(mapping);
+#else
+	munmap(region, sizeof(tuio_shm_region));
+	// readers keep their existing mapping until they close it
+	shm_unlink(shm_name);
+#endif
+}
+
+void TuioSharedMemory::refresh(TuioTime ftime) {
+
+	frame_id++;
+	if (frame_id==0) frame_id++;
+	tuio_shm_frame *slot = &region->slots[frame_id%TUIO_SHM_SLOTS];
+
+	// an odd sequence marks the slot as being written
+	uint32_t sequence = slot->sequence;
+	tuio_shm_store_release(&slot->sequence, sequence+1);
+	tuio_shm_fence();
+
+	slot->frame_id = frame_id;
+	slot->seconds = (int32_t)ftime.getSeconds();
+	slot->microseconds = (int32_t)ftime.getMicroseconds();
+
+	bool invert_x = manager->getInvertXpos();
+	bool invert_y = manager->getInvertYpos();
+	bool invert_a = manager->getInvertAngle();
+	bool truncated = false;
+
+	unsigned int count = 0;
+	const std::list<TuioObject*> &objectList = manager->getTuioObjectList();
+	for (std::list<TuioObject*>::const_iterator iter=objectList.begin(); iter!=objectList.end(); iter++) {
+		if (count==TUIO_SHM_MAX_OBJECTS) { truncated = true; break; }
+		getTuioObjectRecord(*iter,invert_x,invert_y,invert_a,&slot->objects[count++]);
+	}
+	slot->object_count = count;
+
+	// cursors and blobs are only published after their first update, as with the TUIO messages
+	count = 0;
+	const std::list<TuioCursor*> &cursorList = manager->getTuioCursorList();
+	for (std::list<TuioCursor*>::const_iterator iter=cursorList.begin(); iter!=cursorList.end(); iter++) {
+		TuioCursor *tcur = *iter;
+		if (tcur->getTuioState()==TUIO_ADDED) continue;
+		if (count==TUIO_SHM_MAX_CURSORS) { truncated = true; break; }
+		getTuioCursorRecord(tcur,invert_x,invert_y,&slot->cursors[count++]);
+	}
+	slot->cursor_count = count;
+
+	count = 0;
+	const std::list<TuioBlob*> &blobList = manager->getTuioBlobList();
+	for (std::list<TuioBlob*>::const_iterator iter=blobList.begin(); iter!=blobList.end(); iter++) {
+		TuioBlob *tblb = *iter;
+		if (tblb->getTuioState()==TUIO_ADDED) continue;
+		if (count==TUIO_SHM_MAX_BLOBS) { truncated = true; break; }
+		getTuioBlobRecord(tblb,invert_x,invert_y,invert_a,&slot->blobs[count++]);
+	}
+	slot->blob_count = count;
+
+	tuio_shm_store_release(&slot->sequence, sequence+2);
+	tuio_shm_store_release(&region->latest_frame, frame_id);
+
+	if (truncated && !overflow) std::cerr << "TUIO shared memory frame truncated" << std::endl;
+	overflow = truncated;
+}
@@ -0,0 +1,90 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#ifndef INCLUDED_TUIOSHAREDMEMORY_H
+#define INCLUDED_TUIOSHAREDMEMORY_H
+
+#include "TuioListener.h"
+#include "TuioManager.h"
+#include "TuioSnapshot.h"
+
+namespace TUIO {
+
+	/**
+	 * The TuioSharedMemory publishes each committed frame of a TuioManager as fixed-layout binary records
+	 * into a named shared memory region, which is intended for TUIO consumers running on the same machine.
+	 * The region contains a small ring of frame slots, which are each protected by a seqlock,
+	 * so the writer never waits for any reader. The region layout and a C reader interface are defined in tuioshm.h
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL TuioSharedMemory : public TuioListener {
+
+	public:
+
+		/**
+		 * This constructor creates the shared memory region and attaches to the provided TuioManager
+		 *
+		 * @param  manager  the TuioManager providing the published frames
+		 * @param  name  the name of the shared memory region
+		 */
+		TuioSharedMemory(TuioManager *manager, const char *name=TUIO_SHM_DEFAULT_NAME);
+
+		/**
+		 * The destructor detaches from the TuioManager, marks the region as closed and removes its name
+		 */
+		virtual ~TuioSharedMemory();
+
+		void addTuioObject(TuioObject * /*tobj*/) {};
+		void updateTuioObject(TuioObject * /*tobj*/) {};
+		void removeTuioObject(TuioObject * /*tobj*/) {};
+		void addTuioCursor(TuioCursor * /*tcur*/) {};
+		void updateTuioCursor(TuioCursor * /*tcur*/) {};
+		void removeTuioCursor(TuioCursor * /*tcur*/) {};
+		void addTuioBlob(TuioBlob * /*tblb*/) {};
+		void updateTuioBlob(TuioBlob * /*tblb*/) {};
+		void removeTuioBlob(TuioBlob * /*tblb*/) {};
+
+		/**
+		 * Publishes all current TuioObjects, TuioCursors and TuioBlobs of the committed frame
+		 *
+		 * @param  ftime  the TuioTime of the committed frame
+		 */
+		void refresh(TuioTime ftime);
+
+		/**
+		 * Returns the name of the shared memory region
+		 *
+		 * @return the name of the shared memory region
+		 */
+		const char* getName() { return shm_name; };
+
+	private:
+		TuioManager *manager;
+		tuio_shm_region *region;
+		char shm_name[256];
+		unsigned int frame_id;
+		bool overflow;
+#ifdef WIN32
+		HANDLE mapping;
+#endif
+	};
+}
+
+#endif /* INCLUDED_TUIOSHAREDMEMORY_H */
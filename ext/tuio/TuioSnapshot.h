@@ -0,0 +1,164 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#ifndef INCLUDED_TUIOSNAPSHOT_H
+#define INCLUDED_TUIOSNAPSHOT_H
+
+#include "TuioObject.h"
+#include "TuioCursor.h"
+#include "TuioBlob.h"
+#include "tuioshm.h"
+#include <vector>
+#include <atomic>
+
+namespace TUIO {
+
+	/**
+	 * Fills the provided record with the current state of the provided TuioObject
+	 *
+	 * @param	tobj	the TuioObject to copy
+	 * @param	invert_x	true if the X axis is inverted
+	 * @param	invert_y	true if the Y axis is inverted
+	 * @param	invert_a	true if the angle is inverted
+	 * @param	record	the record to fill
+	 */
+	inline void getTuioObjectRecord(TuioObject *tobj, bool invert_x, bool invert_y, bool invert_a, tuio_shm_object *record) {
+		record->session_id = (int32_t)tobj->getSessionID();
+		record->symbol_id = tobj->getSymbolID();
+		record->x = invert_x ? 1-tobj->getX() : tobj->getX();
+		record->y = invert_y ? 1-tobj->getY() : tobj->getY();
+		record->angle = invert_a ? 2.0f*(float)M_PI-tobj->getAngle() : tobj->getAngle();
+		record->x_speed = invert_x ? -tobj->getXSpeed() : tobj->getXSpeed();
+		record->y_speed = invert_y ? -tobj->getYSpeed() : tobj->getYSpeed();
+		record->rotation_speed = invert_a ? -tobj->getRotationSpeed() : tobj->getRotationSpeed();
+		record->motion_accel = tobj->getMotionAccel();
+		record->rotation_accel = tobj->getRotationAccel();
+		record->state = tobj->getTuioState();
+	}
+
+	/**
+	 * Fills the provided record with the current state of the provided TuioCursor
+	 *
+	 * @param	tcur	the TuioCursor to copy
+	 * @param	invert_x	true if the X axis is inverted
+	 * @param	invert_y	true if the Y axis is inverted
+	 * @param	record	the record to fill
+	 */
+	inline void getTuioCursorRecord(TuioCursor *tcur, bool invert_x, bool invert_y, tuio_shm_cursor *record) {
+		record->session_id = (int32_t)tcur->getSessionID();
+		record->cursor_id = tcur->getCursorID();
+		record->x = invert_x ? 1-tcur->getX() : tcur->getX();
+		record->y = invert_y ? 1-tcur->getY() : tcur->getY();
+		record->x_speed = invert_x ? -tcur->getXSpeed() : tcur->getXSpeed();
+		record->y_speed = invert_y ? -tcur->getYSpeed() : tcur->getYSpeed();
+		record->motion_accel = tcur->getMotionAccel();
+		record->state = tcur->getTuioState();
+	}
+
+	/**
+	 * Fills the provided record with the current state of the provided TuioBlob
+	 *
+	 * @param	tblb	the TuioBlob to copy
+	 * @param	invert_x	true if the X axis is inverted
+	 * @param	invert_y	true if the Y axis is inverted
+	 * @param	invert_a	true if the angle is inverted
+	 * @param	record	the record to fill
+	 */
+	inline void getTuioBlobRecord(TuioBlob *tblb, bool invert_x, bool invert_y, bool invert_a, tuio_shm_blob *record) {
+		record->session_id = (int32_t)tblb->getSessionID();
+		record->blob_id = tblb->getBlobID();
+		record->x = invert_x ? 1-tblb->getX() : tblb->getX();
+		record->y = invert_y ? 1-tblb->getY() : tblb->getY();
+		record->angle = invert_a ? 2.0f*(float)M_PI-tblb->getAngle() : tblb->getAngle();
+		record->width = tblb->getWidth();
+		record->height = tblb->getHeight();
+		record->area = tblb->getArea();
+		record->x_speed = invert_x ? -tblb->getXSpeed() : tblb->getXSpeed();
+		record->y_speed = invert_y ? -tblb->getYSpeed() : tblb->getYSpeed();
+		record->rotation_speed = invert_a ? -tblb->getRotationSpeed() : tblb->getRotationSpeed();
+		record->motion_accel = tblb->getMotionAccel();
+		record->rotation_accel = tblb->getRotationAccel();
+		record->state = tblb->getTuioState();
+	}
+
+	/**
+	 * The TuioSnapshot is an immutable copy of all TuioObjects, TuioCursors and TuioBlobs of one committed frame,
+	 * which is provided by the TuioSnapshotPublisher. The components are stored as the same plain records
+	 * as in the shared memory output, see tuioshm.h, in the order of the TUIO messages.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL TuioSnapshot {
+
+		friend class TuioSnapshotPublisher;
+
+	public:
+
+		/**
+		 * Returns the TuioTime of the committed frame
+		 *
+		 * @return the TuioTime of the committed frame
+		 */
+		TuioTime getFrameTime() const { return frameTime; };
+
+		/**
+		 * Returns the serial number of the committed frame, starting at 1
+		 *
+		 * @return the serial number of the committed frame
+		 */
+		long getFrameID() const { return frameID; };
+
+		/**
+		 * Returns the TuioObject records of the committed frame
+		 *
+		 * @return the TuioObject records of the committed frame
+		 */
+		const std::vector<tuio_shm_object>& getTuioObjects() const { return objects; };
+
+		/**
+		 * Returns the TuioCursor records of the committed frame,
+		 * which only contain the TuioCursors that have been updated at least once
+		 *
+		 * @return the TuioCursor records of the committed frame
+		 */
+		const std::vector<tuio_shm_cursor>& getTuioCursors() const { return cursors; };
+
+		/**
+		 * Returns the TuioBlob records of the committed frame,
+		 * which only contain the TuioBlobs that have been updated at least once
+		 *
+		 * @return the TuioBlob records of the committed frame
+		 */
+		const std::vector<tuio_shm_blob>& getTuioBlobs() const { return blobs; };
+
+	private:
+		TuioSnapshot():frameID(0),readers(0) {};
+
+		TuioTime frameTime;
+		long frameID;
+		std::vector<tuio_shm_object> objects;
+		std::vector<tuio_shm_cursor> cursors;
+		std::vector<tuio_shm_blob> blobs;
+
+		mutable std::atomic<unsigned int> readers;
+	};
+}
+
+#endif /* INCLUDED_TUIOSNAPSHOT_H */
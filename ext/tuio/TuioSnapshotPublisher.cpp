@@ -0,0 +1,124 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#include "TuioSnapshotPublisher.h"
+
+using namespace TUIO;
+
+// a reader registers at the published snapshot and then confirms that it is still published.
+// the committing thread publishes a snapshot before it checks the readers of the next one to refill,
+// so with sequentially consistent operations a confirmed reader is always seen by the committing thread.
+// a reader that registered at a snapshot in the middle of refilling always fails its confirmation.
+
+TuioSnapshotPublisher::TuioSnapshotPublisher(TuioManager *tm, unsigned int count)
+	:manager			(tm)
+	,snapshotCount		(count)
+	,published			(-1)
+	,publishedFrameID	(0)
+	,skippedFrames		(0)
+	,frameID			(0)
+	,inversion			(true)
+{
+	if (snapshotCount<2) snapshotCount = 2;
+	snapshotList = new TuioSnapshot[snapshotCount];
+	manager->addTuioListener(this);
+}
+
+TuioSnapshotPublisher::~TuioSnapshotPublisher() {
+
+	manager->removeTuioListener(this);
+	delete[] snapshotList;
+}
+
+void TuioSnapshotPublisher::refresh(TuioTime ftime) {
+
+	frameID++;
+
+	int current = published.load();
+	TuioSnapshot *snapshot = NULL;
+	for (unsigned int i=1;i<=snapshotCount;i++) {
+		int index = (current+i)%snapshotCount;
+		if ((index!=current) && (snapshotList[index].readers.load()==0)) {
+			snapshot = &snapshotList[index];
+			break;
+		}
+	}
+
+	if (snapshot==NULL) {
+		skippedFrames.fetch_add(1,std::memory_order_relaxed);
+		return;
+	}
+
+	snapshot->frameTime = ftime;
+	snapshot->frameID = frameID;
+
+	bool invert_x = inversion && manager->getInvertXpos();
+	bool invert_y = inversion && manager->getInvertYpos();
+	bool invert_a = inversion && manager->getInvertAngle();
+
+	// the vectors keep their capacity, so they only allocate while the number of components grows
+	tuio_shm_object object;
+	snapshot->objects.clear();
+	const std::list<TuioObject*> &objectList = manager->getTuioObjectList();
+	for (std::list<TuioObject*>::const_iterator iter=objectList.begin(); iter!=objectList.end(); iter++) {
+		getTuioObjectRecord(*iter,invert_x,invert_y,invert_a,&object);
+		snapshot->objects.push_back(object);
+	}
+
+	// cursors and blobs are only published after their first update, as with the TUIO messages
+	tuio_shm_cursor cursor;
+	snapshot->cursors.clear();
+	const std::list<TuioCursor*> &cursorList = manager->getTuioCursorList();
+	for (std::list<TuioCursor*>::const_iterator iter=cursorList.begin(); iter!=cursorList.end(); iter++) {
+		if ((*iter)->getTuioState()==TUIO_ADDED) continue;
+		getTuioCursorRecord(*iter,invert_x,invert_y,&cursor);
+		snapshot->cursors.push_back(cursor);
+	}
+
+	tuio_shm_blob blob;
+	snapshot->blobs.clear();
+	const std::list<TuioBlob*> &blobList = manager->getTuioBlobList();
+	for (std::list<TuioBlob*>::const_iterator iter=blobList.begin(); iter!=blobList.end(); iter++) {
+		if ((*iter)->getTuioState()==TUIO_ADDED) continue;
+		getTuioBlobRecord(*iter,invert_x,invert_y,invert_a,&blob);
+		snapshot->blobs.push_back(blob);
+	}
+
+	published.store((int)(snapshot-snapshotList));
+	publishedFrameID.store(frameID,std::memory_order_release);
+}
+
+const TuioSnapshot* TuioSnapshotPublisher::acquireSnapshot() {
+
+	int index = published.load();
+	while (index>=0) {
+		TuioSnapshot *snapshot = &snapshotList[index];
+		snapshot->readers.fetch_add(1);
+		int current = published.load();
+		if (current==index) return snapshot;
+		snapshot->readers.fetch_sub(1);
+		index = current;
+	}
+
+	return NULL;
+}
+
+void TuioSnapshotPublisher::releaseSnapshot(const TuioSnapshot *snapshot) {
+	if (snapshot!=NULL) snapshot->readers.fetch_sub(1,std::memory_order_release);
+}
@@ -0,0 +1,126 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#ifndef INCLUDED_TUIOSNAPSHOTPUBLISHER_H
+#define INCLUDED_TUIOSNAPSHOTPUBLISHER_H
+
+#include "TuioListener.h"
+#include "TuioManager.h"
+#include "TuioSnapshot.h"
+
+#define DEFAULT_SNAPSHOT_COUNT 8
+
+namespace TUIO {
+
+	/**
+	 * The TuioSnapshotPublisher copies each committed frame of a TuioManager into an immutable TuioSnapshot,
+	 * which in-process consumers acquire from their own threads without any locks or callbacks.
+	 * The snapshots are kept in a small pool, where each snapshot counts its current readers:
+	 * the committing thread only refills snapshots that are neither published nor read, and skips
+	 * the publication of a frame if all other snapshots are still held, so it never waits for a reader.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL TuioSnapshotPublisher : public TuioListener {
+
+	public:
+
+		/**
+		 * This constructor creates the snapshot pool and attaches to the provided TuioManager
+		 *
+		 * @param  manager  the TuioManager providing the published frames
+		 * @param  count  the number of pooled snapshots, at least two plus the number of snapshots held at the same time
+		 */
+		TuioSnapshotPublisher(TuioManager *manager, unsigned int count=DEFAULT_SNAPSHOT_COUNT);
+
+		/**
+		 * The destructor detaches from the TuioManager and deletes the snapshot pool,
+		 * therefore all snapshots need to be released before
+		 */
+		virtual ~TuioSnapshotPublisher();
+
+		void addTuioObject(TuioObject * /*tobj*/) {};
+		void updateTuioObject(TuioObject * /*tobj*/) {};
+		void removeTuioObject(TuioObject * /*tobj*/) {};
+		void addTuioCursor(TuioCursor * /*tcur*/) {};
+		void updateTuioCursor(TuioCursor * /*tcur*/) {};
+		void removeTuioCursor(TuioCursor * /*tcur*/) {};
+		void addTuioBlob(TuioBlob * /*tblb*/) {};
+		void updateTuioBlob(TuioBlob * /*tblb*/) {};
+		void removeTuioBlob(TuioBlob * /*tblb*/) {};
+
+		/**
+		 * Copies all current TuioObjects, TuioCursors and TuioBlobs into a free snapshot and publishes it
+		 *
+		 * @param  ftime  the TuioTime of the committed frame
+		 */
+		void refresh(TuioTime ftime);
+
+		/**
+		 * Returns the latest published TuioSnapshot, which remains unchanged until it is released.
+		 * This method can be called from any thread.
+		 *
+		 * @return the latest published TuioSnapshot, or NULL before the first frame has been committed
+		 */
+		const TuioSnapshot* acquireSnapshot();
+
+		/**
+		 * Releases a TuioSnapshot returned by acquireSnapshot, so it can be refilled with a later frame
+		 *
+		 * @param  snapshot  the TuioSnapshot to release
+		 */
+		void releaseSnapshot(const TuioSnapshot *snapshot);
+
+		/**
+		 * Returns the serial number of the latest published frame,
+		 * which allows polling for new frames without acquiring a snapshot
+		 *
+		 * @return the serial number of the latest published frame, or 0 before the first frame
+		 */
+		long getFrameID() { return publishedFrameID.load(std::memory_order_acquire); };
+
+		/**
+		 * Returns the number of frames that have not been published because all other snapshots were held
+		 *
+		 * @return the number of skipped frames
+		 */
+		unsigned long getSkippedFrames() { return skippedFrames.load(std::memory_order_relaxed); };
+
+		/**
+		 * Determines if the axis and angle inversion of the TuioManager is applied to the snapshots,
+		 * which is not the case for snapshots that are merged into another inverted session
+		 *
+		 * @param  invert  true if the inversion of the TuioManager is applied, which is the default
+		 */
+		void enableInversion(bool invert) { inversion = invert; };
+
+	private:
+		TuioManager *manager;
+		TuioSnapshot *snapshotList;
+		unsigned int snapshotCount;
+		std::atomic<int> published;
+		std::atomic<long> publishedFrameID;
+		std::atomic<unsigned long> skippedFrames;
+		long frameID;
+		bool inversion;
+	};
+}
+
+#endif /* INCLUDED_TUIOSNAPSHOTPUBLISHER_H */
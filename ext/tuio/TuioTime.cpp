@@ -21,6 +21,9 @@ using namespace TUIO;
 	
 long TuioTime::start_seconds = 0;
 long TuioTime::start_micro_seconds = 0;
+bool TuioTime::fixed_time = false;
+long TuioTime::fixed_seconds = 0;
+long TuioTime::fixed_micro_seconds = 0;
 
 TuioTime::TuioTime (long msec) {
 	seconds = msec/MSEC_SECOND;
@@ -117,6 +120,7 @@ TuioTime TuioTime::getStartTime() {
 }
 
 TuioTime TuioTime::getSystemTime() {
+	if (fixed_time) return TuioTime(fixed_seconds,fixed_micro_seconds);
 #ifdef WIN32
 	TuioTime systemTime(GetTickCount());
 #else
@@ -127,3 +131,13 @@ TuioTime TuioTime::getSystemTime() {
 #endif	
 	return systemTime;
 }
+
+void TuioTime::setFixedTime(TuioTime ftime) {
+	fixed_seconds = ftime.getSeconds();
+	fixed_micro_seconds = ftime.getMicroseconds();
+	fixed_time = true;
+}
+
+void TuioTime::releaseFixedTime() {
+	fixed_time = false;
+}
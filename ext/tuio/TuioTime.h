@@ -52,6 +52,9 @@ namespace TUIO {
 		long micro_seconds;
 		static long start_seconds;
 		static long start_micro_seconds;
+		static bool fixed_time;
+		static long fixed_seconds;
+		static long fixed_micro_seconds;
 		
 	public:
 
@@ -184,6 +187,18 @@ namespace TUIO {
 		 * @return the absolut TuioTime representing the current system time
 		 */	
 		static TuioTime getSystemTime();
+
+		/**
+		 * This static method globally replaces the system time with the provided TuioTime,
+		 * until it is set again or released. This allows reproducible timestamps when replaying recorded frames.
+		 * @param  ftime  the TuioTime to return as the current system time
+		 */
+		static void setFixedTime(TuioTime ftime);
+
+		/**
+		 * This static method globally restores the actual system time after a fixed time has been set.
+		 */
+		static void releaseFixedTime();
 	};
 }
 #endif /* INCLUDED_TUIOTIME_H */
@@ -0,0 +1,135 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#include "UdpFanoutSender.h"
+#ifdef LINUX
+#include <sys/uio.h>
+#endif
+
+using namespace TUIO;
+
+UdpFanoutSender::UdpFanoutSender(const char *host, int port) {
+
+	local = true;
+	buffer_size = MAX_UDP_SIZE;
+
+	udp_socket = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+	if (udp_socket < 0) {
+		std::cout << "could not create UDP socket" << std::endl;
+		throw std::exception();
+	}
+
+	// the send buffer needs to hold a datagram for each target, but the system default is never reduced
+	int optval = 0;
+#ifdef WIN32
+	int optlen = sizeof(int);
+#else
+	socklen_t optlen = sizeof(int);
+#endif
+	getsockopt(udp_socket, SOL_SOCKET, SO_SNDBUF, (char *)&optval, &optlen);
+	if (optval<MAX_UDP_TARGETS*MAX_UDP_DATAGRAM) {
+		optval = MAX_UDP_TARGETS*MAX_UDP_DATAGRAM;
+		setsockopt(udp_socket, SOL_SOCKET, SO_SNDBUF, (const char *)&optval, sizeof(int));
+	}
+
+	if (!addTarget(host,port)) {
+#ifdef WIN32
+		closesocket(udp_socket);
+#else
+		close(udp_socket);
+#endif
+		throw std::exception();
+	}
+}
+
+UdpFanoutSender::~UdpFanoutSender() {
+#ifdef WIN32
+	closesocket(udp_socket);
+#else
+	close(udp_socket);
+#endif
+}
+
+bool UdpFanoutSender::addTarget(const char *host, int port) {
+
+	if (target_list.size()==MAX_UDP_TARGETS) return false;
+
+	struct sockaddr_in target;
+	memset( &target, 0, sizeof (target));
+	target.sin_family = AF_INET;
+	target.sin_port = htons(port);
+	unsigned long addr = GetHostByName(host);
+	if (addr==0) {
+		std::cout << "unknown host name: " << host << std::endl;
+		return false;
+	}
+	target.sin_addr.s_addr = htonl(addr);
+
+	if ((strcmp(host,"127.0.0.1")!=0) && (strcmp(host,"localhost")!=0)) {
+		local = false;
+		buffer_size = IP_MTU_SIZE;
+	}
+
+	target_list.push_back(target);
+	std::cout << "TUIO/UDP messages to " << host << "@" << port << std::endl;
+	return true;
+}
+
+bool UdpFanoutSender::isConnected() { 
+	return !target_list.empty();
+}
+
+bool UdpFanoutSender::sendOscData (const char *data, unsigned int size) {
+	if ( size > MAX_UDP_DATAGRAM ) return false;
+	if ( size == 0 ) return false;
+
+	unsigned int count = (unsigned int)target_list.size();
+	bool delivered = true;
+
+#ifdef LINUX
+	struct iovec packet;
+	packet.iov_base = (void*)data;
+	packet.iov_len = size;
+
+	struct mmsghdr messages[MAX_UDP_TARGETS];
+	memset( messages, 0, sizeof(messages));
+	for (unsigned int i=0;i<count;i++) {
+		messages[i].msg_hdr.msg_name = &target_list[i];
+		messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+		messages[i].msg_hdr.msg_iov = &packet;
+		messages[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	// sendmmsg stops at the first failing target, skip it and send the rest
+	unsigned int sent = 0;
+	while (sent<count) {
+		int ret = sendmmsg(udp_socket, &messages[sent], count-sent, 0);
+		if (ret<=0) {
+			delivered = false;
+			sent++;
+		} else sent += ret;
+	}
+#else
+	for (unsigned int i=0;i<count;i++) {
+		int ret = sendto(udp_socket, data, size, 0, (struct sockaddr*)&target_list[i], sizeof(struct sockaddr_in));
+		if (ret<0) delivered = false;
+	}
+#endif
+
+	return delivered;
+}
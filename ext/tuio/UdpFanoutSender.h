@@ -0,0 +1,115 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#ifndef INCLUDED_UDPFANOUTSENDER_H
+#define INCLUDED_UDPFANOUTSENDER_H
+
+#include "UdpSender.h"
+
+#ifdef WIN32
+#include <winsock.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#endif
+
+#include <vector>
+#define MAX_UDP_TARGETS 32
+
+namespace TUIO {
+	
+	/**
+	 * The UdpFanoutSender delivers the same OSC data to several UDP targets through a single socket.
+	 * On Linux all targets are served with a single sendmmsg() call per packet.
+	 * The bundle size is limited to the MTU size as soon as one of the targets is not local.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */ 
+	class LIBDECL UdpFanoutSender : public OscSender {
+				
+	public:
+
+		/**
+		 * This constructor creates a UdpFanoutSender that sends to the provided port on the the given host
+		 *
+		 * @param  host  the receiving host name
+		 * @param  port  the outgoing UDP port number
+		 */
+		UdpFanoutSender(const char *host, int port);
+
+		/**
+		 * The destructor closes the socket. 
+		 */
+		virtual ~UdpFanoutSender();
+
+		/**
+		 * This method adds another UDP target, which receives the same OSC data
+		 *
+		 * @param  host  the receiving host name
+		 * @param  port  the outgoing UDP port number
+		 * @return true if the target could be added
+		 */
+		bool addTarget(const char *host, int port);
+
+		/**
+		 * This method delivers the provided OSC data to all targets
+		 *
+		 * @param *data  the OSC packet data to deliver
+		 * @param size  the OSC packet size in bytes
+		 * @return true if the data was delivered successfully
+		 */
+		bool sendOscData (const char *data, unsigned int size);
+
+		/**
+		 * This method returns the connection state
+		 *
+		 * @return true if the connection is alive
+		 */
+		bool isConnected ();
+
+		/**
+		 * This method returns the largest packet size in bytes, which is
+		 * delivered as a fragmented datagram if it exceeds the MTU size
+		 *
+		 * @return the largest deliverable packet size in bytes
+		 */
+		int getMaxPacketSize () { return MAX_UDP_DATAGRAM; };
+
+		/**
+		 * This method returns the number of UDP targets
+		 *
+		 * @return the number of UDP targets
+		 */
+		unsigned int getTargetCount () { return (unsigned int)target_list.size(); };
+
+		const char* tuio_type() { return "TUIO/UDP"; }
+
+	private:
+		NetworkInitializer network;
+#ifdef WIN32
+		SOCKET udp_socket;
+#else
+		int udp_socket;
+#endif
+		std::vector<struct sockaddr_in> target_list;
+	};
+}
+#endif /* INCLUDED_UDPFANOUTSENDER_H */
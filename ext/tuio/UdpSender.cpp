@@ -60,6 +60,7 @@ UdpSender::UdpSender(const char *host, int port, int size) {
 		} else local = false;
 		long unsigned int ip = GetHostByName(host);
 		socket = new UdpTransmitSocket(IpEndpointName(ip, port));
+		buffer_size = size;
 		if (buffer_size>MAX_UDP_SIZE) buffer_size = MAX_UDP_SIZE;
 		else if (buffer_size<MIN_UDP_SIZE) buffer_size = MIN_UDP_SIZE;
 		std::cout << "TUIO/UDP messages to " << host << "@" << port << std::endl;
@@ -79,11 +80,11 @@ bool UdpSender::isConnected() {
 	return true;
 }
 
-bool UdpSender::sendOscPacket (osc::OutboundPacketStream *bundle) {
+bool UdpSender::sendOscData (const char *data, unsigned int size) {
 	if (socket==NULL) return false; 
-	if ( bundle->Size() > buffer_size ) return false;
-	if ( bundle->Size() == 0 ) return false;
+	if ( size > MAX_UDP_DATAGRAM ) return false;
+	if ( size == 0 ) return false;
 
-	socket->Send( bundle->Data(), bundle->Size() );
+	socket->Send( data, size );
 	return true;
 }
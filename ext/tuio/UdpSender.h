@@ -25,6 +25,7 @@
 #define IP_MTU_SIZE 1500
 #define MAX_UDP_SIZE 4096
 #define MIN_UDP_SIZE 576
+#define MAX_UDP_DATAGRAM 8192
 
 namespace TUIO {
 	
@@ -71,11 +72,20 @@ namespace TUIO {
 		/**
 		 * This method delivers the provided OSC data
 		 *
-		 * @param *bundle  the OSC stream to deliver
+		 * @param *data  the OSC packet data to deliver
+		 * @param size  the OSC packet size in bytes
 		 * @return true if the data was delivered successfully
 		 */
 		
-		bool sendOscPacket (osc::OutboundPacketStream *bundle);
+		bool sendOscData (const char *data, unsigned int size);
+
+		/**
+		 * This method returns the largest packet size in bytes, which is
+		 * delivered as a fragmented datagram if it exceeds the MTU size
+		 *
+		 * @return the largest deliverable packet size in bytes
+		 */
+		int getMaxPacketSize () { return MAX_UDP_DATAGRAM; };
 
 		/**
 		 * This method returns the connection state
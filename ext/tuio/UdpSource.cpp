@@ -0,0 +1,84 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#include "UdpSource.h"
+
+using namespace TUIO;
+
+#ifdef WIN32
+static DWORD WINAPI ReceiverThreadFunc( LPVOID obj )
+#else
+static void* ReceiverThreadFunc( void* obj )
+#endif
+{
+	static_cast<UdpSource*>(obj)->socket->Run();
+	return 0;
+};
+
+UdpSource::UdpSource(int port)
+: socket (NULL)
+, connected (false)
+{
+	try {
+		socket = new UdpListeningReceiveSocket(IpEndpointName(IpEndpointName::ANY_ADDRESS, port), this);
+	} catch (std::exception &e) {
+		std::cerr << "could not bind TUIO/UDP port " << port << std::endl;
+		throw std::exception();
+	}
+	std::cout << "TUIO/UDP messages from port " << port << std::endl;
+}
+
+UdpSource::~UdpSource() {
+	disconnect();
+	delete socket;
+}
+
+bool UdpSource::connect() {
+
+	if (connected) return true;
+
+#ifdef WIN32
+	DWORD threadId;
+	thread = CreateThread( 0, 0, ReceiverThreadFunc, this, 0, &threadId );
+	if (thread==NULL) return false;
+#else
+	if (pthread_create(&thread , NULL, ReceiverThreadFunc, this)!=0) return false;
+#endif
+	connected = true;
+	return true;
+}
+
+void UdpSource::disconnect() {
+
+	if (!connected) return;
+	socket->AsynchronousBreak();
+#ifdef WIN32
+	WaitForSingleObject(thread,INFINITE);
+	CloseHandle(thread);
+#else
+	pthread_join(thread,NULL);
+#endif
+	connected = false;
+}
+
+void UdpSource::ProcessPacket( const char *data, int size, const IpEndpointName& remoteEndpoint ) {
+	if (listener==NULL) return;
+	try { listener->ProcessPacket(data, size, remoteEndpoint); }
+	catch (std::exception &e) { std::cerr << "malformed " << tuio_type() << " packet" << std::endl; }
+}
@@ -0,0 +1,93 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#ifndef INCLUDED_UDPSOURCE_H
+#define INCLUDED_UDPSOURCE_H
+
+#include "OscSource.h"
+#include "ip/UdpSocket.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace TUIO {
+
+	/**
+	 * The UdpSource receives OSC packets on a local UDP port
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL UdpSource : public OscSource, public PacketListener {
+
+	public:
+
+		/**
+		 * This constructor creates a UdpSource listening to the provided port
+		 *
+		 * @param  port  the incoming UDP port number
+		 */
+		UdpSource(int port=3333);
+
+		/**
+		 * The destructor stops the receiver thread and closes the socket.
+		 */
+		virtual ~UdpSource();
+
+		/**
+		 * This method starts the receiver thread
+		 *
+		 * @return true if the receiver thread has been started
+		 */
+		bool connect();
+
+		/**
+		 * This method stops the receiver thread
+		 */
+		void disconnect();
+
+		/**
+		 * This method returns the connection state
+		 *
+		 * @return true while the receiver thread is running
+		 */
+		bool isConnected() { return connected; };
+
+		/**
+		 * This method passes the received OSC packet to the PacketListener
+		 */
+		void ProcessPacket( const char *data, int size, const IpEndpointName& remoteEndpoint );
+
+		const char* tuio_type() { return "TUIO/UDP"; }
+
+		UdpListeningReceiveSocket *socket;
+
+	private:
+		bool connected;
+#ifdef WIN32
+		HANDLE thread;
+#else
+		pthread_t thread;
+#endif
+	};
+}
+#endif /* INCLUDED_UDPSOURCE_H */
@@ -22,87 +22,68 @@
 using namespace TUIO;
 
 WebSockSender::WebSockSender()
-	:TcpSender( 8080 )
+	:TcpSender( 8080, false )
 {
 	local = true;
 	buffer_size = MAX_TCP_SIZE;
 	port_no = 8080;
+	startEventLoop();
 }
 
 WebSockSender::WebSockSender(int port)
-	:TcpSender( port )
+	:TcpSender( port, false )
 {
 	local = true;
 	buffer_size = MAX_TCP_SIZE;
 	port_no = port;
+	startEventLoop();
 }
 
-bool WebSockSender::sendOscPacket (osc::OutboundPacketStream *bundle) {
-	if (!connected) return false; 
-	if ( bundle->Size() > buffer_size ) return false;
-	if ( bundle->Size() == 0 ) return false;
-	
-#ifdef OSC_HOST_LITTLE_ENDIAN             
-	data_size[0] =  bundle->Size()>>24;
-	data_size[1] = (bundle->Size()>>16) & 255;
-	data_size[2] = (bundle->Size()>>8) & 255;
-	data_size[3] = (bundle->Size()) & 255;
-#else
-	*((int32_t*)data_size) = bundle->Size();
-#endif
+TcpPacket WebSockSender::framePacket( const char *data, unsigned int size ) {
 
-#ifdef WIN32
-	std::list<SOCKET>::iterator client;
-#else
-	std::list<int>::iterator client;
-#endif
-	
-	for (client = tcp_client_list.begin(); client!=tcp_client_list.end(); client++) {
-		size_t len = bundle->Size();
-		// add WebSocket header on top
-		uint8_t header[4] = {
-			0x82,
-			(uint8_t)( len & 0xFF), 
-			(uint8_t)((len >>8) & 0xFF),
-			(uint8_t)( len & 0xFF)
-		};
-		int hs = 2;
-		if (len > 125) { hs = 4; header[1] = 126; }
-		memcpy(&data_buffer[0], &header, hs);
-		memcpy(&data_buffer[hs], bundle->Data(), bundle->Size());
-		send((*client),data_buffer, hs+bundle->Size(),0);
-	}
+	// add WebSocket header on top
+	std::shared_ptr<std::string> packet = std::make_shared<std::string>();
+	packet->reserve(size+10);
+	packet->push_back((char)0x82);
+	if (size > 65535) {
+		packet->push_back((char)127);
+		for (int i=7;i>=0;i--) packet->push_back((char)(((uint64_t)size>>(8*i)) & 0xFF));
+	} else if (size > 125) {
+		packet->push_back((char)126);
+		packet->push_back((char)((size>>8) & 0xFF));
+		packet->push_back((char)(size & 0xFF));
+	} else packet->push_back((char)size);
+	packet->append(data,size);
+	return packet;
+}
 
-	return true;
+void WebSockSender::newClient( TcpClient *client ) {
+	// wait for the handshake
+	client->ready = false;
 }
 
-void WebSockSender::newClient( int tcp_client ) {
+bool WebSockSender::receiveClientData( TcpClient *client, const char *data, int size ) {
 
-	// socket -> file descriptor
-#ifdef WIN32
-	FILE* conn = _fdopen( tcp_client, "r+" );
-#else
-	FILE* conn = fdopen( tcp_client, "r+" );
-#endif
+	// ignore any client messages after the handshake
+	if (client->ready) return true;
 
-	// websocket challenge-response
-	uint8_t digest[SHA1_HASH_SIZE];
-	char buf[1024] = "...";
-	char key[1024];
+	client->input.append(data,size);
+	size_t end = client->input.find("\r\n\r\n");
+	if (end==std::string::npos) return (client->input.size()<4096);
 
 	// read client handshake challenge
-	while ((buf[0] != 0) && (buf[0] != '\r')) {
-		fgets( buf, sizeof(buf), conn );
-		if (strncmp(buf,"Sec-WebSocket-Key: ",19) == 0) {
-			strncpy(key,buf+19,sizeof(key));
-			key[strlen(buf)-21] = 0;
-			break;
-		}
-	}
+	size_t pos = client->input.find("Sec-WebSocket-Key: ");
+	if ((pos==std::string::npos) || (pos>end)) return false;
+	pos += 19;
+	std::string key = client->input.substr(pos,client->input.find("\r\n",pos)-pos);
+	client->input.clear();
 
-	strncat(key,"258EAFA5-E914-47DA-95CA-C5AB0DC85B11",sizeof(key)-strlen(key)-1);
-	sha1(digest,(uint8_t*)key,strlen(key));
+	// websocket challenge-response
+	uint8_t digest[SHA1_HASH_SIZE];
+	key += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+	sha1(digest,(uint8_t*)key.c_str(),key.length());
 
+	char buf[1024];
 	snprintf(buf, sizeof(buf),
 		"HTTP/1.1 101 Switching Protocols\r\n"
 		"Upgrade: websocket\r\n"
@@ -111,7 +92,9 @@ void WebSockSender::newClient( int tcp_client ) {
 		"Sec-WebSocket-Accept: %s\r\n\r\n",
 		base64( digest, SHA1_HASH_SIZE ).c_str() ); 
 
-	send(tcp_client,buf, strlen(buf),0);
+	queuePacket(client,std::make_shared<std::string>(buf));
+	client->ready = true;
+	return true;
 }
 
 
@@ -94,24 +94,37 @@ namespace TUIO {
 		/**
 		 * The destructor closes the socket. 
 		 */
-		virtual ~WebSockSender() {}
+		virtual ~WebSockSender() { stopEventLoop(); }
 		
+		const char* tuio_type() { return "TUIO/WEB"; }
+
+	protected:
+
 		/**
-		 * This method delivers the provided OSC data
+		 * This method is called whenever a new client connects.
+		 * WebSocket clients receive OSC data after their handshake.
 		 *
-		 * @param *bundle  the OSC stream to deliver
-		 * @return true if the data was delivered successfully
+		 * @param client the new client
 		 */
-		bool sendOscPacket (osc::OutboundPacketStream *bundle);
+		void newClient( TcpClient *client );
 
 		/**
-		 * This method is called whenever a new client connects
+		 * This method reads the WebSocket handshake of a new client
 		 *
-		 * @param tcp_client the socket handle of the new client
+		 * @param client the sending client
+		 * @return false if the client should be disconnected
 		 */
-		void newClient( int tcp_client );
-	
-		const char* tuio_type() { return "TUIO/WEB"; }
+		bool receiveClientData( TcpClient *client, const char *data, int size );
+
+		/**
+		 * This method adds the WebSocket frame header to the provided OSC data
+		 *
+		 * @param *data  the OSC packet data to frame
+		 * @param size  the OSC packet size in bytes
+		 * @return the framed packet
+		 */
+		TcpPacket framePacket( const char *data, unsigned int size );
+
 	private:
 		
 		void sha1( uint8_t digest[SHA1_HASH_SIZE], const uint8_t* inbuf, size_t length );
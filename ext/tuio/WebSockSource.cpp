@@ -0,0 +1,99 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#include "WebSockSource.h"
+
+#define MAX_HEADER_SIZE 4096
+
+using namespace TUIO;
+
+WebSockSource::WebSockSource(const char *host, int port)
+: TcpSource (host, port)
+, handshake (false)
+{
+}
+
+WebSockSource::~WebSockSource() {
+	// the receiver thread calls the methods of this class until it has been stopped
+	disconnect();
+}
+
+bool WebSockSource::startSession() {
+
+	char request[1024];
+	snprintf(request, sizeof(request),
+		"GET / HTTP/1.1\r\n"
+		"Host: %s:%d\r\n"
+		"Upgrade: websocket\r\n"
+		"Connection: Upgrade\r\n"
+		"Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+		"Sec-WebSocket-Version: 13\r\n\r\n",
+		host_name.c_str(), port_no );
+
+	handshake = false;
+	int size = (int)strlen(request);
+	return (send(tcp_socket, request, size, 0)==size);
+}
+
+bool WebSockSource::processInput() {
+
+	// wait for the handshake response first
+	if (!handshake) {
+		size_t end = input.find("\r\n\r\n");
+		if (end==std::string::npos) return (input.size()<MAX_HEADER_SIZE);
+		if (input.compare(0,12,"HTTP/1.1 101")!=0) return false;
+		input.erase(0,end+4);
+		handshake = true;
+	}
+
+	size_t offset = 0;
+	while (input.size()-offset>=2) {
+		const unsigned char *header = (const unsigned char*)input.data()+offset;
+		unsigned char opcode = header[0] & 0x0F;
+
+		// the frames of a server are never masked
+		if (header[1] & 0x80) return false;
+
+		size_t header_size = 2;
+		uint64_t payload_size = header[1] & 0x7F;
+		if (payload_size==126) {
+			header_size = 4;
+			if (input.size()-offset<header_size) break;
+			payload_size = ((uint64_t)header[2]<<8) | (uint64_t)header[3];
+		} else if (payload_size==127) {
+			header_size = 10;
+			if (input.size()-offset<header_size) break;
+			payload_size = 0;
+			for (int i=2;i<10;i++) payload_size = (payload_size<<8) | (uint64_t)header[i];
+		}
+
+		if (payload_size>MAX_TCP_SIZE) return false;
+		if (input.size()-offset-header_size<payload_size) break;
+
+		// a close frame ends the connection, while text and control frames are ignored
+		if (opcode==0x08) return false;
+		if ((opcode==0x02) && (listener)) {
+			try { listener->ProcessPacket(input.data()+offset+header_size, (int)payload_size, endpoint); }
+			catch (std::exception &e) { std::cerr << "malformed " << tuio_type() << " packet from " << host_name << std::endl; }
+		}
+		offset += header_size+(size_t)payload_size;
+	}
+	input.erase(0,offset);
+	return true;
+}
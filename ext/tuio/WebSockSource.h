@@ -0,0 +1,61 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+ 
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+ 
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+ 
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+
+#ifndef INCLUDED_WEBSOCKSOURCE_H
+#define INCLUDED_WEBSOCKSOURCE_H
+
+#include "TcpSource.h"
+
+namespace TUIO {
+
+	/**
+	 * The WebSockSource receives OSC packets from a WebSocket host, such as a WebSockSender.
+	 * After the WebSocket handshake each OSC packet is expected within a single binary frame.
+	 *
+	 * @author Martin Kaltenbrunner
+	 * @version 1.1.6
+	 */
+	class LIBDECL WebSockSource : public TcpSource {
+
+	public:
+
+		/**
+		 * This constructor creates a WebSockSource that connects to the provided port on the given host
+		 *
+		 * @param  host  the sending host name
+		 * @param  port  the WebSocket port number of the host
+		 */
+		WebSockSource(const char *host, int port);
+
+		/**
+		 * The destructor stops the receiver thread and closes the socket.
+		 */
+		virtual ~WebSockSource();
+
+		const char* tuio_type() { return "TUIO/WEB"; }
+
+	protected:
+		bool startSession();
+		bool processInput();
+
+	private:
+		bool handshake;
+	};
+}
+#endif /* INCLUDED_WEBSOCKSOURCE_H */
@@ -0,0 +1,162 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+/* standalone reader for the TuioSharedMemory output, see tuioshm.h */
+
+#include "tuioshm.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#ifndef _MSC_VER
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define TUIO_SHM_READ_RETRIES (16)
+
+struct tuio_shm_reader{
+    tuio_shm_region *region;
+    uint32_t last_frame;
+#ifdef _MSC_VER
+    HANDLE mapping;
+#endif
+};
+
+
+tuio_shm_reader *tuio_shm_open( const char *name )
+{
+    tuio_shm_reader *reader;
+    tuio_shm_region *region;
+
+#ifdef _MSC_VER
+    HANDLE mapping = OpenFileMappingA( FILE_MAP_READ, FALSE, (name[0]=='/') ? name+1 : name );
+    if( mapping == NULL )
+        return NULL;
+
+    region = (tuio_shm_region*)MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, sizeof(tuio_shm_region) );
+    if( region == NULL ){
+        CloseHandle( mapping );
+        return NULL;
+    }
+#else
+    struct stat info;
+    int fd = shm_open( name, O_RDONLY, 0 );
+    if( fd < 0 )
+        return NULL;
+
+    if( fstat( fd, &info ) < 0 || info.st_size < (off_t)sizeof(tuio_shm_region) ){
+        close( fd );
+        return NULL;
+    }
+
+    region = (tuio_shm_region*)mmap( NULL, sizeof(tuio_shm_region), PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+    if( region == MAP_FAILED )
+        return NULL;
+#endif
+
+    reader = NULL;
+    if( region->magic == TUIO_SHM_MAGIC && region->version == TUIO_SHM_VERSION
+            && region->region_size == sizeof(tuio_shm_region) )
+        reader = (tuio_shm_reader*)malloc( sizeof(tuio_shm_reader) );
+
+    if( reader == NULL ){
+#ifdef _MSC_VER
+        UnmapViewOfFile( region );
+        CloseHandle( mapping );
+#else
+        munmap( region, sizeof(tuio_shm_region) );
+#endif
+        return NULL;
+    }
+
+    reader->region = region;
+    reader->last_frame = 0;
+#ifdef _MSC_VER
+    reader->mapping = mapping;
+#endif
+
+    return reader;
+}
+
+
+int tuio_shm_read( tuio_shm_reader *reader, tuio_shm_frame *frame )
+{
+    tuio_shm_region *region;
+    int retry;
+
+    if( reader == NULL || frame == NULL )
+        return -1;
+
+    region = reader->region;
+
+    for( retry=0; retry < TUIO_SHM_READ_RETRIES; ++retry ){
+
+        uint32_t latest = tuio_shm_load_acquire( &region->latest_frame );
+        const tuio_shm_frame *slot;
+        uint32_t sequence;
+
+        if( latest == reader->last_frame ){
+            if( tuio_shm_load_acquire( &region->closed ) )
+                return -1;
+            return 0;
+        }
+
+        slot = &region->slots[ latest % TUIO_SHM_SLOTS ];
+        sequence = tuio_shm_load_acquire( &slot->sequence );
+        if( sequence & 1 )
+            continue;
+
+        /* copy the header and only the used part of the entity arrays */
+        memcpy( frame, slot, offsetof(tuio_shm_frame, objects) );
+        if( frame->object_count > TUIO_SHM_MAX_OBJECTS
+                || frame->cursor_count > TUIO_SHM_MAX_CURSORS
+                || frame->blob_count > TUIO_SHM_MAX_BLOBS )
+            continue;
+
+        memcpy( frame->objects, slot->objects, frame->object_count*sizeof(tuio_shm_object) );
+        memcpy( frame->cursors, slot->cursors, frame->cursor_count*sizeof(tuio_shm_cursor) );
+        memcpy( frame->blobs, slot->blobs, frame->blob_count*sizeof(tuio_shm_blob) );
+
+        /* the copy is only valid if the writer did not touch the slot meanwhile */
+        tuio_shm_fence();
+        if( tuio_shm_load_acquire( &slot->sequence ) != sequence )
+            continue;
+
+        reader->last_frame = frame->frame_id;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+void tuio_shm_close( tuio_shm_reader *reader )
+{
+#ifdef _MSC_VER
+    UnmapViewOfFile( reader->region );
+    CloseHandle( reader->mapping );
+#else
+    munmap( reader->region, sizeof(tuio_shm_region) );
+#endif
+    free( reader );
+}
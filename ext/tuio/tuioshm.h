@@ -0,0 +1,171 @@
+/*
+ TUIO C++ Library
+ Copyright (c) 2005-2017 Martin Kaltenbrunner <martin@tuio.org>
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3.0 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library.
+*/
+
+#ifndef INCLUDED_TUIOSHM_H
+#define INCLUDED_TUIOSHM_H
+
+#ifdef _MSC_VER
+#include <windows.h>
+typedef __int32 int32_t;
+typedef unsigned __int32 uint32_t;
+#define TUIO_SHM_INLINE static __inline
+#else
+#include <stdint.h>
+#define TUIO_SHM_INLINE static inline
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+    layout of the shared memory region published by the TuioSharedMemory output
+
+    the region consists of a header followed by a ring of TUIO_SHM_SLOTS frame slots.
+    the writer fills the slot (frame_id % TUIO_SHM_SLOTS) and then publishes its
+    frame_id in the header field latest_frame. each slot is protected by a seqlock:
+    its sequence counter is odd while the slot is being written, so a reader copies
+    the slot and only accepts the copy if the sequence was even and unchanged.
+
+    all fields are 32bit wide in host byte order, so the layout does not depend
+    on the compiler. the tuio_shm_* reader functions are implemented in tuioshm.c
+
+    usage:
+
+    tuio_shm_reader *reader = tuio_shm_open( TUIO_SHM_DEFAULT_NAME );
+    tuio_shm_frame *frame = malloc( sizeof(tuio_shm_frame) );
+    if( reader == NULL || frame == NULL )
+        ... error ...
+
+    ...
+
+    if( tuio_shm_read( reader, frame ) > 0 ){
+        for( i=0; i < frame->object_count; ++i )
+            ... frame->objects[i] ...
+    }
+
+    ...
+
+    tuio_shm_close( reader );
+*/
+
+#define TUIO_SHM_DEFAULT_NAME "/reacTIVision"
+#define TUIO_SHM_MAGIC (0x54554F53) /* 'TUOS' */
+#define TUIO_SHM_VERSION (1)
+#define TUIO_SHM_SLOTS (4)
+#define TUIO_SHM_MAX_OBJECTS (512)
+#define TUIO_SHM_MAX_CURSORS (512)
+#define TUIO_SHM_MAX_BLOBS (512)
+
+typedef struct tuio_shm_object{
+    int32_t session_id;
+    int32_t symbol_id;
+    float x, y, angle;
+    float x_speed, y_speed, rotation_speed;
+    float motion_accel, rotation_accel;
+    int32_t state;
+} tuio_shm_object;
+
+typedef struct tuio_shm_cursor{
+    int32_t session_id;
+    int32_t cursor_id;
+    float x, y;
+    float x_speed, y_speed;
+    float motion_accel;
+    int32_t state;
+} tuio_shm_cursor;
+
+typedef struct tuio_shm_blob{
+    int32_t session_id;
+    int32_t blob_id;
+    float x, y, angle;
+    float width, height, area;
+    float x_speed, y_speed, rotation_speed;
+    float motion_accel, rotation_accel;
+    int32_t state;
+} tuio_shm_blob;
+
+typedef struct tuio_shm_frame{
+    uint32_t sequence;      /* seqlock counter, odd while the slot is written */
+    uint32_t frame_id;      /* serial number of the published frame, starting at 1 */
+    int32_t seconds;        /* TUIO session time of the frame */
+    int32_t microseconds;
+
+    uint32_t object_count;
+    uint32_t cursor_count;
+    uint32_t blob_count;
+    uint32_t reserved;
+
+    tuio_shm_object objects[ TUIO_SHM_MAX_OBJECTS ];
+    tuio_shm_cursor cursors[ TUIO_SHM_MAX_CURSORS ];
+    tuio_shm_blob blobs[ TUIO_SHM_MAX_BLOBS ];
+} tuio_shm_frame;
+
+typedef struct tuio_shm_region{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t region_size;
+    uint32_t slot_count;
+
+    uint32_t latest_frame;  /* frame_id of the latest complete frame, 0 before the first frame */
+    uint32_t closed;        /* set to 1 once the writer has stopped */
+    uint32_t reserved[2];
+
+    tuio_shm_frame slots[ TUIO_SHM_SLOTS ];
+} tuio_shm_region;
+
+/* memory ordering helpers shared by the writer and the reader */
+
+#ifdef _MSC_VER
+TUIO_SHM_INLINE uint32_t tuio_shm_load_acquire( const volatile uint32_t *p )
+    { uint32_t v = *p; MemoryBarrier(); return v; }
+TUIO_SHM_INLINE void tuio_shm_store_release( volatile uint32_t *p, uint32_t v )
+    { MemoryBarrier(); *p = v; }
+TUIO_SHM_INLINE void tuio_shm_fence( void )
+    { MemoryBarrier(); }
+#else
+TUIO_SHM_INLINE uint32_t tuio_shm_load_acquire( const volatile uint32_t *p )
+    { return __atomic_load_n( p, __ATOMIC_ACQUIRE ); }
+TUIO_SHM_INLINE void tuio_shm_store_release( volatile uint32_t *p, uint32_t v )
+    { __atomic_store_n( p, v, __ATOMIC_RELEASE ); }
+TUIO_SHM_INLINE void tuio_shm_fence( void )
+    { __atomic_thread_fence( __ATOMIC_SEQ_CST ); }
+#endif
+
+/* reader interface */
+
+typedef struct tuio_shm_reader tuio_shm_reader;
+
+/* maps the region with the provided name, returns NULL if there is no writer
+   or the reader could not be allocated */
+tuio_shm_reader *tuio_shm_open( const char *name );
+
+/* copies the latest frame if it is newer than the previously read frame.
+   returns 1 if a new frame was copied, 0 if there is no new frame,
+   and -1 if the writer has stopped or the reader or frame is NULL */
+int tuio_shm_read( tuio_shm_reader *reader, tuio_shm_frame *frame );
+
+/* unmaps the region */
+void tuio_shm_close( tuio_shm_reader *reader );
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* INCLUDED_TUIOSHM_H */